@@ -58,8 +58,9 @@ void Tree::accept(Visitor& visitor) const
 
 void Block::accept(Visitor& visitor) const
 {
-    for (const Statement::Ptr& statement : mList) {
-        statement->accept(visitor);
+    for (size_t i = 0; i < mList.size(); ++i) {
+        mList[i]->accept(visitor);
+        visitor.postVisit(*this, i);
     }
 
     visitor.visit(*this);
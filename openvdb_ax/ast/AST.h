@@ -628,6 +628,12 @@ struct Visitor
     // any node type
 
     inline virtual void init(const Tree& node) {};
+
+    /// @brief  Called after each statement held by a block has been visited, with
+    ///         the index of the statement in the block. Visitors which need to act
+    ///         on statement boundaries can define this method.
+    inline virtual void postVisit(const Block& node, const size_t statement) {};
+
     inline virtual void visit(const Tree& node) {};
     inline virtual void visit(const Block& node) {};
     inline virtual void visit(const ExpressionList& node) {};
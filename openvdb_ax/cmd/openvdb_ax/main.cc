@@ -32,7 +32,10 @@
 #include <openvdb_ax/ast/Scanners.h>
 #include <openvdb_ax/codegen/FunctionRegistry.h>
 #include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/PerfCounters.h>
 #include <openvdb_ax/compiler/PointExecutable.h>
+#include <openvdb_ax/compiler/Shard.h>
+#include <openvdb_ax/compiler/Tracer.h>
 #include <openvdb_ax/compiler/VolumeExecutable.h>
 
 #include <openvdb/openvdb.h>
@@ -44,10 +47,19 @@
 #include <usagetrack.h>
 #endif
 
+#include <tbb/mutex.h>
+#include <tbb/parallel_for.h>
+#include <tbb/pipeline.h>
+#include <tbb/task_group.h>
+
+#include <algorithm>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 const char* gProgName = "";
@@ -57,7 +69,24 @@ struct ProgOptions
     std::string mInputCode = "";
     std::string mInputVDBFile = "";
     std::string mOutputVDBFile = "";
+    std::string mTraceFile = "";
     bool mVerbose = false;
+    bool mEmitIR = false;
+    bool mEmitOptimisedIR = false;
+    bool mEmitAssembly = false;
+    bool mProfile = false;
+    bool mCounters = false;
+    bool mStream = false;
+    std::string mFrames = "";
+    std::string mFileList = "";
+    size_t mFrameThreads = 3;
+    std::string mShard = "";
+    int mHalo = 2;
+    openvdb::ax::CompilerOptions::OptLevel mOptLevel =
+        openvdb::ax::CompilerOptions::OptLevel::O3;
+
+    inline bool emit() const { return mEmitIR || mEmitOptimisedIR || mEmitAssembly; }
+    inline bool batch() const { return !mFrames.empty() || !mFileList.empty(); }
 };
 
 void
@@ -70,11 +99,43 @@ usage [[noreturn]] (int exitStatus = EXIT_FAILURE)
 "    -s snippet        execute code snippet on the input.vdb file\n" <<
 "    -f file.txt       execute text file containing a code snippet on the input.vdb file\n" <<
 "    -v                verbose (print timing and diagnostics)\n" <<
+"    --opt level       llvm optimization level, one of NONE, O0, O1, O2, O3, Os or Oz\n" <<
+"                      (default: O3)\n" <<
+"    --emit-ir         print the generated llvm IR prior to optimization to stdout\n" <<
+"    --emit-opt-ir     print the generated llvm IR after optimization to stdout\n" <<
+"    --emit-asm        print the native assembly of the optimized module to stdout\n" <<
+"    --profile         instrument the compiled code and print the cycles spent in each top\n" <<
+"                      level statement and function call after execution\n" <<
+"    --counters        print the hardware performance counters of each compilation and\n" <<
+"                      execution phase (Linux only)\n" <<
+"    --trace file.json write a timeline of all compilation and execution phases on each\n" <<
+"                      thread to file.json, viewable with chrome://tracing or Perfetto\n" <<
+"    --stream          load only the grids of input.vdb which the snippet references,\n" <<
+"                      one point grid at a time. If output.vdb contains %s, each grid\n" <<
+"                      is written to its own file, with %s replaced by the grid name,\n" <<
+"                      as soon as it has been processed and is then released. Each\n" <<
+"                      grid is still loaded whole, so memory use is not bounded\n" <<
+"    --frames a-b[:s]  batch mode, execute on every frame from a to b in steps of s. A run\n" <<
+"                      of # in input.vdb and output.vdb is replaced by the zero padded\n" <<
+"                      frame number. The snippet is compiled once for all frames\n" <<
+"    --file-list file  batch mode, execute on every input vdb listed in file, one per line.\n" <<
+"                      A run of # in output.vdb is replaced by the zero padded line index\n" <<
+"    --frame-threads N in batch mode, the number of frames in flight at once, with the\n" <<
+"                      reading, execution and writing of different frames overlapped\n" <<
+"                      (default: 3)\n" <<
+"    --shard i/n       execute on shard i of n of the input.vdb, a leaf aligned slab holding\n" <<
+"                      an equal share of its points, or of its active voxels if it has no\n" <<
+"                      points. Shards may be executed by separate processes and combined\n" <<
+"                      with vdb_ax_merge\n" <<
+"    --halo N          with --shard, the width in voxels of the region around the shard\n" <<
+"                      kept for volumes so that neighbouring values can be read (default: 2)\n" <<
 "    --list-functions  list all available functions, their signatures and their documentation\n" <<
 "Warning:\n" <<
 "     Providing the same file-path to both input.vdb and output.vdb arguments will overwrite\n" <<
 "     the file. If no output file is provided, the input.vdb will be processed but will remain\n" <<
-"     unchanged on disk (this is useful for testing the success status of code).\n";
+"     unchanged on disk (this is useful for testing the success status of code).\n" <<
+"     If any of the --emit options are provided without an input.vdb, the snippet is\n" <<
+"     compiled for both PointDataGrids and volumes and nothing is executed.\n";
     exit(exitStatus);
 }
 
@@ -92,6 +153,23 @@ void loadSnippetFile(const std::string& fileName, std::string& textString)
                     std::istreambuf_iterator<char>());
 }
 
+openvdb::ax::CompilerOptions::OptLevel
+optLevelFromString(const std::string& level)
+{
+    using OptLevel = openvdb::ax::CompilerOptions::OptLevel;
+
+    if (level == "NONE") return OptLevel::NONE;
+    if (level == "O0")   return OptLevel::O0;
+    if (level == "O1")   return OptLevel::O1;
+    if (level == "O2")   return OptLevel::O2;
+    if (level == "O3")   return OptLevel::O3;
+    if (level == "Os")   return OptLevel::Os;
+    if (level == "Oz")   return OptLevel::Oz;
+
+    OPENVDB_LOG_FATAL("\"" + level + "\" is not a valid optimization level");
+    usage();
+}
+
 struct OptParse
 {
     int argc;
@@ -176,6 +254,475 @@ void printFunctions(std::ostream& os)
     }
 }
 
+void writeTrace(const openvdb::ax::Tracer& tracer, const std::string& fileName)
+{
+    std::ofstream out(fileName.c_str(), std::ios::out | std::ios::trunc);
+    if (!out) {
+        OPENVDB_LOG_ERROR("Unable to write trace file " << fileName);
+        return;
+    }
+    tracer.write(out);
+}
+
+/// @brief  Substitute a grid name into an output file name containing %s
+std::string gridFileName(const std::string& pattern, const std::string& gridName)
+{
+    std::string fileName(pattern);
+    const size_t pos = fileName.find("%s");
+    if (pos != std::string::npos) fileName.replace(pos, 2, gridName);
+    return fileName;
+}
+
+void writeGrids(const openvdb::GridCPtrVec& grids,
+                const openvdb::MetaMap& meta,
+                const std::string& fileName)
+{
+    openvdb::io::File out(fileName);
+    out.write(grids, meta);
+}
+
+/// @brief  Execute a snippet over a VDB file, loading only the grids it references.
+///         Grid descriptors are read up front and the referenced grids are loaded with
+///         delayed loading, so that leaf data and point attributes are paged in as the
+///         executables access them. Point grids are processed one at a time. If the
+///         output file name contains %s, every grid is written to its own file as soon
+///         as it has been processed and is then released. Otherwise every processed
+///         grid is kept until the single output file is written.
+/// @note   Leaves which have been paged in are not released until their grid is, so
+///         memory use is not bounded; a referenced volume or point grid is resident
+///         in full once it has been executed.
+int streamExecute(const ProgOptions& options,
+                  const openvdb::ax::CompilerOptions& compilerOptions,
+                  const ScopedInitialize& initializer)
+{
+    using openvdb::ax::PointExecutable;
+    using openvdb::ax::VolumeExecutable;
+
+    openvdb::io::File file(options.mInputVDBFile);
+    openvdb::GridPtrVecPtr descriptors;
+    openvdb::MetaMap::Ptr meta;
+
+    try {
+        file.open(/*delayLoad*/true);
+        descriptors = file.readAllGridMetadata();
+        meta = file.getMetadata();
+    } catch (openvdb::Exception& e) {
+        OPENVDB_LOG_ERROR(e.what() << " (" << options.mInputVDBFile << ")");
+        return EXIT_FAILURE;
+    }
+
+    const bool progressive = options.mOutputVDBFile.find("%s") != std::string::npos;
+    const bool write = !options.mOutputVDBFile.empty();
+
+    // determine the targets and the volumes the snippet references
+
+    openvdb::ax::ast::Tree::ConstPtr syntaxTree;
+    {
+        openvdb::ax::ScopedPhase phase(compilerOptions.phaseListener.get(), "parse");
+        syntaxTree = openvdb::ax::ast::parse(options.mInputCode.c_str());
+    }
+
+    std::set<std::string> referenced;
+    openvdb::ax::ast::visitNodeType<openvdb::ax::ast::Attribute>(*syntaxTree,
+        [&referenced](const openvdb::ax::ast::Attribute& node) {
+            referenced.insert(node.mName);
+        });
+
+    bool hasPoints = false, hasVolumes = false;
+    std::set<std::string> volumeNames;
+    for (const auto& grid : *descriptors) {
+        if (grid->isType<openvdb::points::PointDataGrid>()) hasPoints = true;
+        else {
+            volumeNames.insert(grid->getName());
+            if (referenced.count(grid->getName())) hasVolumes = true;
+        }
+    }
+
+    // without point grids to take them, every referenced name must be a volume
+
+    if (!hasPoints) {
+        for (const std::string& name : referenced) {
+            if (volumeNames.count(name)) continue;
+            OPENVDB_LOG_FATAL("Missing grid \"@" << name << "\" (" << options.mInputVDBFile << ")");
+            return EXIT_FAILURE;
+        }
+    }
+
+    initializer.initializeCompiler();
+    openvdb::ax::Compiler::Ptr compiler = openvdb::ax::Compiler::create(compilerOptions);
+
+    PointExecutable::Ptr pointExecutable;
+    VolumeExecutable::Ptr volumeExecutable;
+    std::vector<std::string> warnings;
+
+    try {
+        if (hasPoints) {
+            pointExecutable = compiler->compile<PointExecutable>(*syntaxTree,
+                openvdb::ax::CustomData::create(), &warnings);
+        }
+        if (hasVolumes) {
+            volumeExecutable = compiler->compile<VolumeExecutable>(*syntaxTree,
+                openvdb::ax::CustomData::create(), &warnings);
+        }
+    } catch (std::exception& e) {
+        OPENVDB_LOG_FATAL("Compilation error!");
+        OPENVDB_LOG_FATAL("Errors:");
+        OPENVDB_LOG_FATAL(e.what());
+        return EXIT_FAILURE;
+    }
+
+    for (const std::string& warning : warnings) {
+        OPENVDB_LOG_WARN(warning);
+    }
+
+    const bool requiresDeletion = hasPoints &&
+        openvdb::ax::ast::callsFunction(*syntaxTree, "deletepoint");
+
+    // grids which are written together at the end if not writing progressively,
+    // in their original order. Unprocessed grids are delay loaded and are only
+    // paged in as they are written
+
+    std::vector<openvdb::GridBase::Ptr> outputs(descriptors->size());
+
+    auto finish = [&](const size_t index, const openvdb::GridBase::Ptr& grid) {
+        if (!write) return;
+        if (progressive) {
+            if (options.mVerbose) std::cout << "  Writing \"" << grid->getName() << "\"" << std::endl;
+            writeGrids(openvdb::GridCPtrVec{grid}, *meta,
+                gridFileName(options.mOutputVDBFile, grid->getName()));
+        }
+        else {
+            outputs[index] = grid;
+        }
+    };
+
+    try {
+        // volumes, which must all be resident together for execution
+
+        if (volumeExecutable) {
+            openvdb::GridPtrVec volumes;
+            std::vector<size_t> indices;
+            for (size_t i = 0; i < descriptors->size(); ++i) {
+                const openvdb::GridBase::Ptr& descriptor = (*descriptors)[i];
+                if (descriptor->isType<openvdb::points::PointDataGrid>()) continue;
+                if (!referenced.count(descriptor->getName())) continue;
+                volumes.emplace_back(file.readGrid(descriptor->getName()));
+                indices.emplace_back(i);
+            }
+
+            if (options.mVerbose) std::cout << "  Executing on " << volumes.size() << " volumes" << std::endl;
+            volumeExecutable->execute(volumes);
+            for (size_t i = 0; i < volumes.size(); ++i) finish(indices[i], volumes[i]);
+        }
+
+        // points, one grid at a time
+
+        if (pointExecutable) {
+            for (size_t i = 0; i < descriptors->size(); ++i) {
+                const openvdb::GridBase::Ptr& descriptor = (*descriptors)[i];
+                if (!descriptor->isType<openvdb::points::PointDataGrid>()) continue;
+                const std::string& name = descriptor->getName();
+                openvdb::points::PointDataGrid::Ptr points =
+                    openvdb::gridPtrCast<openvdb::points::PointDataGrid>(file.readGrid(name));
+                if (options.mVerbose) std::cout << "  Executing on \"" << name << "\"" << std::endl;
+                pointExecutable->execute(*points);
+                if (requiresDeletion) {
+                    openvdb::points::deleteFromGroup(points->tree(), "dead", false, false);
+                }
+                finish(i, points);
+            }
+        }
+
+        // grids which the snippet does not modify are passed through unloaded
+
+        if (write) {
+            for (size_t i = 0; i < descriptors->size(); ++i) {
+                if (outputs[i]) continue;
+                const openvdb::GridBase::Ptr& descriptor = (*descriptors)[i];
+                const bool processed =
+                    (pointExecutable && descriptor->isType<openvdb::points::PointDataGrid>()) ||
+                    (volumeExecutable && !descriptor->isType<openvdb::points::PointDataGrid>() &&
+                        referenced.count(descriptor->getName()));
+                if (processed) continue;
+                finish(i, file.readGrid(descriptor->getName()));
+            }
+        }
+
+        if (write && !progressive) {
+            openvdb::GridCPtrVec grids(outputs.begin(), outputs.end());
+            writeGrids(grids, *meta, options.mOutputVDBFile);
+        }
+    }
+    catch (std::exception& e) {
+        OPENVDB_LOG_FATAL("Execution error!");
+        OPENVDB_LOG_FATAL("Errors:");
+        OPENVDB_LOG_FATAL(e.what());
+        return EXIT_FAILURE;
+    }
+
+    file.close();
+
+    if (pointExecutable && pointExecutable->profiler()) {
+        std::cout << "PointDataGrid Profile:" << std::endl;
+        pointExecutable->profiler()->print(std::cout);
+    }
+    if (volumeExecutable && volumeExecutable->profiler()) {
+        std::cout << "Volume Profile:" << std::endl;
+        volumeExecutable->profiler()->print(std::cout);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief  Replace the first run of # in a file name with a zero padded frame number
+std::string frameFileName(const std::string& pattern, const int frame)
+{
+    const size_t pos = pattern.find('#');
+    if (pos == std::string::npos) return pattern;
+    size_t end = pattern.find_first_not_of('#', pos);
+    if (end == std::string::npos) end = pattern.size();
+
+    std::ostringstream os;
+    os << std::setw(int(end - pos)) << std::setfill('0') << std::internal << frame;
+    return pattern.substr(0, pos) + os.str() + pattern.substr(end);
+}
+
+/// @brief  A single input file of a batch and the grids read from it
+struct Frame
+{
+    using Ptr = std::shared_ptr<Frame>;
+
+    int mFrame;
+    std::string mInput;
+    std::string mOutput;
+    openvdb::GridPtrVecPtr mGrids;
+    openvdb::MetaMap::Ptr mMeta;
+    bool mFailed = false;
+};
+
+/// @brief  Build the list of frames to process from either a --frames range or a
+///         --file-list, along with their output file names
+bool batchFrames(const ProgOptions& options, std::vector<Frame::Ptr>& frames)
+{
+    std::vector<std::pair<int, std::string>> inputs;
+
+    if (!options.mFrames.empty()) {
+        int start = 0, end = 0, step = 1;
+        try {
+            const size_t dash = options.mFrames.find('-', 1);
+            const size_t colon = options.mFrames.find(':');
+            start = std::stoi(options.mFrames.substr(0, dash));
+            end = dash == std::string::npos ? start :
+                std::stoi(options.mFrames.substr(dash + 1, colon - dash - 1));
+            if (colon != std::string::npos) step = std::stoi(options.mFrames.substr(colon + 1));
+        } catch (std::exception&) {
+            OPENVDB_LOG_FATAL("\"" << options.mFrames << "\" is not a valid frame range");
+            return false;
+        }
+        if (step <= 0 || end < start) {
+            OPENVDB_LOG_FATAL("\"" << options.mFrames << "\" is not a valid frame range");
+            return false;
+        }
+        for (int frame = start; frame <= end; frame += step) {
+            inputs.emplace_back(frame, frameFileName(options.mInputVDBFile, frame));
+        }
+    }
+    else {
+        std::ifstream in(options.mFileList.c_str());
+        if (!in) {
+            OPENVDB_LOG_FATAL("File Load Error: " << options.mFileList);
+            return false;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty()) continue;
+            inputs.emplace_back(int(inputs.size()), line);
+        }
+    }
+
+    if (inputs.size() > 1 && !options.mOutputVDBFile.empty() &&
+        options.mOutputVDBFile.find('#') == std::string::npos) {
+        OPENVDB_LOG_FATAL("output.vdb must contain # to be unique for each frame");
+        return false;
+    }
+
+    for (const auto& input : inputs) {
+        Frame::Ptr frame(new Frame);
+        frame->mFrame = input.first;
+        frame->mInput = input.second;
+        if (!options.mOutputVDBFile.empty()) {
+            frame->mOutput = frameFileName(options.mOutputVDBFile, input.first);
+        }
+        frames.emplace_back(frame);
+    }
+
+    return true;
+}
+
+/// @brief  Execute a snippet over a sequence of VDB files. LLVM is initialized and the
+///         snippet is compiled at most once for points and once for volumes, on the
+///         first frame which contains each. The frames are then processed by a pipeline
+///         which reads, executes and writes frames concurrently, with up to
+///         options.mFrameThreads frames in flight. Reading and writing happen in frame
+///         order; execution of different frames may run in parallel.
+int batchExecute(const ProgOptions& options,
+                 const openvdb::ax::CompilerOptions& compilerOptions,
+                 const ScopedInitialize& initializer)
+{
+    using openvdb::ax::PointExecutable;
+    using openvdb::ax::VolumeExecutable;
+
+    std::vector<Frame::Ptr> frames;
+    if (!batchFrames(options, frames)) return EXIT_FAILURE;
+
+    openvdb::ax::ast::Tree::ConstPtr syntaxTree;
+    {
+        openvdb::ax::ScopedPhase phase(compilerOptions.phaseListener.get(), "parse");
+        syntaxTree = openvdb::ax::ast::parse(options.mInputCode.c_str());
+    }
+
+    const bool requiresDeletion =
+        openvdb::ax::ast::callsFunction(*syntaxTree, "deletepoint");
+
+    initializer.initializeCompiler();
+    openvdb::ax::Compiler::Ptr compiler = openvdb::ax::Compiler::create(compilerOptions);
+
+    // executables are compiled lazily, at most once each, so that a sequence
+    // without points or volumes never compiles for them
+
+    tbb::mutex compileMutex;
+    bool pointsCompiled = false, volumesCompiled = false;
+    PointExecutable::Ptr pointExecutable;
+    VolumeExecutable::Ptr volumeExecutable;
+
+    auto compile = [&](const bool points) -> bool {
+        tbb::mutex::scoped_lock lock(compileMutex);
+        bool& compiled = points ? pointsCompiled : volumesCompiled;
+        if (!compiled) {
+            compiled = true;
+            std::vector<std::string> warnings;
+            try {
+                if (points) {
+                    pointExecutable = compiler->compile<PointExecutable>(*syntaxTree,
+                        openvdb::ax::CustomData::create(), &warnings);
+                }
+                else {
+                    volumeExecutable = compiler->compile<VolumeExecutable>(*syntaxTree,
+                        openvdb::ax::CustomData::create(), &warnings);
+                }
+            } catch (std::exception& e) {
+                OPENVDB_LOG_FATAL("Compilation error!");
+                OPENVDB_LOG_FATAL("Errors:");
+                OPENVDB_LOG_FATAL(e.what());
+            }
+            for (const std::string& warning : warnings) {
+                OPENVDB_LOG_WARN(warning);
+            }
+        }
+        return points ? bool(pointExecutable) : bool(volumeExecutable);
+    };
+
+    size_t next = 0;
+
+    tbb::parallel_pipeline(options.mFrameThreads,
+        tbb::make_filter<void, Frame::Ptr>(tbb::filter::serial_in_order,
+            [&](tbb::flow_control& control) -> Frame::Ptr {
+                if (next == frames.size()) {
+                    control.stop();
+                    return Frame::Ptr();
+                }
+                Frame::Ptr frame = frames[next++];
+                try {
+                    openvdb::io::File file(frame->mInput);
+                    file.open();
+                    frame->mGrids = file.getGrids();
+                    frame->mMeta = file.getMetadata();
+                    file.close();
+                } catch (openvdb::Exception& e) {
+                    OPENVDB_LOG_ERROR(e.what() << " (" << frame->mInput << ")");
+                    frame->mFailed = true;
+                }
+                return frame;
+            }) &
+        tbb::make_filter<Frame::Ptr, Frame::Ptr>(tbb::filter::parallel,
+            [&](Frame::Ptr frame) -> Frame::Ptr {
+                if (frame->mFailed) return frame;
+
+                bool hasPoints = false, hasVolumes = false;
+                for (const auto& grid : *frame->mGrids) {
+                    if (grid->isType<openvdb::points::PointDataGrid>()) hasPoints = true;
+                    else hasVolumes = true;
+                }
+
+                if ((hasPoints && !compile(true)) || (hasVolumes && !compile(false))) {
+                    frame->mFailed = true;
+                    return frame;
+                }
+
+                try {
+                    if (hasPoints) {
+                        for (const auto& grid : *frame->mGrids) {
+                            if (!grid->isType<openvdb::points::PointDataGrid>()) continue;
+                            openvdb::points::PointDataGrid::Ptr points =
+                                openvdb::gridPtrCast<openvdb::points::PointDataGrid>(grid);
+                            pointExecutable->execute(*points);
+                            if (requiresDeletion) {
+                                openvdb::points::deleteFromGroup(points->tree(), "dead", false, false);
+                            }
+                        }
+                    }
+                    if (hasVolumes) volumeExecutable->execute(*frame->mGrids);
+                }
+                catch (std::exception& e) {
+                    OPENVDB_LOG_FATAL("Execution error! (" << frame->mInput << ")");
+                    OPENVDB_LOG_FATAL("Errors:");
+                    OPENVDB_LOG_FATAL(e.what());
+                    frame->mFailed = true;
+                }
+                return frame;
+            }) &
+        tbb::make_filter<Frame::Ptr, void>(tbb::filter::serial_in_order,
+            [&](Frame::Ptr frame) {
+                if (!frame->mFailed && !frame->mOutput.empty()) {
+                    try {
+                        openvdb::io::File out(frame->mOutput);
+                        out.write(*frame->mGrids, *frame->mMeta);
+                    } catch (openvdb::Exception& e) {
+                        OPENVDB_LOG_ERROR(e.what() << " (" << frame->mOutput << ")");
+                        frame->mFailed = true;
+                    }
+                }
+                if (options.mVerbose) {
+                    std::cout << "  " << (frame->mFailed ? "Failed " : "Processed ")
+                        << frame->mInput << std::endl;
+                }
+                // release the grids of this frame as soon as it has been written
+                frame->mGrids.reset();
+                frame->mMeta.reset();
+            }));
+
+    size_t failed = 0;
+    for (const Frame::Ptr& frame : frames) {
+        if (frame->mFailed) ++failed;
+    }
+
+    if (pointExecutable && pointExecutable->profiler()) {
+        std::cout << "PointDataGrid Profile:" << std::endl;
+        pointExecutable->profiler()->print(std::cout);
+    }
+    if (volumeExecutable && volumeExecutable->profiler()) {
+        std::cout << "Volume Profile:" << std::endl;
+        volumeExecutable->profiler()->print(std::cout);
+    }
+
+    if (failed > 0) {
+        OPENVDB_LOG_ERROR(failed << " of " << frames.size() << " frames failed");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -202,6 +749,39 @@ main(int argc, char *argv[])
                 loadSnippetFile(argv[i], options.mInputCode);
             } else if (parser.check(i, "-v", 0)) {
                 options.mVerbose = true;
+            } else if (parser.check(i, "--opt")) {
+                ++i;
+                options.mOptLevel = optLevelFromString(argv[i]);
+            } else if (parser.check(i, "--emit-ir", 0)) {
+                options.mEmitIR = true;
+            } else if (parser.check(i, "--emit-opt-ir", 0)) {
+                options.mEmitOptimisedIR = true;
+            } else if (parser.check(i, "--emit-asm", 0)) {
+                options.mEmitAssembly = true;
+            } else if (parser.check(i, "--profile", 0)) {
+                options.mProfile = true;
+            } else if (parser.check(i, "--counters", 0)) {
+                options.mCounters = true;
+            } else if (parser.check(i, "--trace")) {
+                ++i;
+                options.mTraceFile = argv[i];
+            } else if (parser.check(i, "--stream", 0)) {
+                options.mStream = true;
+            } else if (parser.check(i, "--frames")) {
+                ++i;
+                options.mFrames = argv[i];
+            } else if (parser.check(i, "--file-list")) {
+                ++i;
+                options.mFileList = argv[i];
+            } else if (parser.check(i, "--frame-threads")) {
+                ++i;
+                options.mFrameThreads = std::max(size_t(1), size_t(std::stoul(argv[i])));
+            } else if (parser.check(i, "--shard")) {
+                ++i;
+                options.mShard = argv[i];
+            } else if (parser.check(i, "--halo")) {
+                ++i;
+                options.mHalo = std::stoi(argv[i]);
             } else if (parser.check(i, "--list-functions", 0)) {
                 initializer.initializeCompiler();
                 printFunctions(std::cout);
@@ -228,15 +808,152 @@ main(int argc, char *argv[])
         }
     }
 
-    if (options.mInputVDBFile.empty() || options.mInputCode.empty()) {
+    // with a file list, a single positional argument is the output
+
+    if (!options.mFileList.empty() && options.mOutputVDBFile.empty()) {
+        options.mOutputVDBFile.swap(options.mInputVDBFile);
+    }
+
+    if (options.batch() && options.mStream) {
+        OPENVDB_LOG_FATAL("--stream can not be combined with --frames or --file-list");
+        usage();
+    }
+
+    if (!options.mShard.empty() && (options.batch() || options.mStream)) {
+        OPENVDB_LOG_FATAL("--shard can not be combined with --stream, --frames or --file-list");
+        usage();
+    }
+
+    size_t shardIndex = 0, shardCount = 1;
+    if (!options.mShard.empty()) {
+        const size_t slash = options.mShard.find('/');
+        try {
+            if (slash == std::string::npos) throw std::invalid_argument(options.mShard);
+            shardIndex = size_t(std::stoul(options.mShard.substr(0, slash)));
+            shardCount = size_t(std::stoul(options.mShard.substr(slash + 1)));
+        } catch (std::exception&) {
+            shardCount = 0;
+        }
+        if (shardCount == 0 || shardIndex >= shardCount) {
+            OPENVDB_LOG_FATAL("\"" << options.mShard << "\" is not a valid shard, expected i/n");
+            usage();
+        }
+    }
+
+    if (!options.mFrames.empty() && !options.mFileList.empty()) {
+        OPENVDB_LOG_FATAL("only one of --frames or --file-list may be provided");
+        usage();
+    }
+
+    if (options.mInputCode.empty() ||
+        (options.mInputVDBFile.empty() && options.mFileList.empty() && !options.emit())) {
         OPENVDB_LOG_FATAL("expected at least one OpenVDB file and one code snippet");
         usage();
     }
 
+    openvdb::ax::CompilerOptions compilerOptions;
+    compilerOptions.optLevel = options.mOptLevel;
+    compilerOptions.profile = options.mProfile;
+    if (options.mEmitIR) compilerOptions.irOutput = &std::cout;
+    if (options.mEmitOptimisedIR) compilerOptions.optimisedIROutput = &std::cout;
+    if (options.mEmitAssembly) compilerOptions.assemblyOutput = &std::cout;
+
+    openvdb::ax::PhaseListenerList::Ptr listeners(new openvdb::ax::PhaseListenerList);
+
+    openvdb::ax::PerfCounters::Ptr counters;
+    if (options.mCounters) {
+        counters.reset(new openvdb::ax::PerfCounters);
+        listeners->add(counters);
+    }
+
+    openvdb::ax::Tracer::Ptr tracer;
+    if (!options.mTraceFile.empty()) {
+        tracer.reset(new openvdb::ax::Tracer);
+        listeners->add(tracer);
+    }
+
+    if (counters || tracer) compilerOptions.phaseListener = listeners;
+
+    // a file list provides the inputs, so an empty input file only compiles
+    // when not batching
+
+    if (options.mInputVDBFile.empty() && !options.batch()) {
+
+        // only compile, printing the requested outputs for both points and volumes.
+        // Snippets may only be valid for one of them, i.e. if they use deletepoint,
+        // so each is compiled independently and only fails if neither compiles
+
+        initializer.initializeCompiler();
+        openvdb::ax::Compiler::Ptr compiler = openvdb::ax::Compiler::create(compilerOptions);
+        openvdb::ax::CustomData::Ptr customData = openvdb::ax::CustomData::create();
+        std::vector<std::string> warnings;
+
+        openvdb::ax::ast::Tree::ConstPtr syntaxTree;
+        try {
+            syntaxTree = openvdb::ax::ast::parse(options.mInputCode.c_str());
+        } catch (std::exception& e) {
+            OPENVDB_LOG_FATAL("Compilation error!");
+            OPENVDB_LOG_FATAL("Errors:");
+            OPENVDB_LOG_FATAL(e.what());
+            return EXIT_FAILURE;
+        }
+
+        std::string pointErrors, volumeErrors;
+        try {
+            compiler->compile<openvdb::ax::PointExecutable>(*syntaxTree, customData, &warnings);
+        } catch (std::exception& e) {
+            pointErrors = e.what();
+        }
+        try {
+            compiler->compile<openvdb::ax::VolumeExecutable>(*syntaxTree, customData, &warnings);
+        } catch (std::exception& e) {
+            volumeErrors = e.what();
+        }
+
+        if (!pointErrors.empty() && !volumeErrors.empty()) {
+            OPENVDB_LOG_FATAL("Compilation error!");
+            OPENVDB_LOG_FATAL("Errors:");
+            OPENVDB_LOG_FATAL("PointDataGrids: " << pointErrors);
+            OPENVDB_LOG_FATAL("Volume VDB Grids: " << volumeErrors);
+            return EXIT_FAILURE;
+        }
+
+        if (!pointErrors.empty()) {
+            OPENVDB_LOG_WARN("Unable to compile for PointDataGrids: " << pointErrors);
+        }
+        if (!volumeErrors.empty()) {
+            OPENVDB_LOG_WARN("Unable to compile for Volume VDB Grids: " << volumeErrors);
+        }
+
+        for (const std::string& warning : warnings) {
+            OPENVDB_LOG_WARN(warning);
+        }
+
+        if (counters) {
+            std::cout << "Performance Counters:" << std::endl;
+            counters->print(std::cout);
+        }
+
+        if (tracer) writeTrace(*tracer, options.mTraceFile);
+
+        return EXIT_SUCCESS;
+    }
+
     if (options.mOutputVDBFile.empty()) {
         OPENVDB_LOG_WARN("no output VDB File specified - nothing will be written to disk");
     }
 
+    if (options.mStream || options.batch()) {
+        const int status = options.mStream ?
+            streamExecute(options, compilerOptions, initializer) :
+            batchExecute(options, compilerOptions, initializer);
+        if (counters) {
+            std::cout << "Performance Counters:" << std::endl;
+            counters->print(std::cout);
+        }
+        if (tracer) writeTrace(*tracer, options.mTraceFile);
+        return status;
+    }
 
     openvdb::GridPtrVecPtr grids;
     openvdb::MetaMap::Ptr meta;
@@ -255,123 +972,209 @@ main(int argc, char *argv[])
     assert(meta);
     assert(grids);
 
-    // begin compiler
-
-    initializer.initializeCompiler();
-    openvdb::ax::Compiler::Ptr compiler = openvdb::ax::Compiler::create();
+    // reduce the grids to the requested shard. As the file is delay loaded, the
+    // leaf data outside of the shard is never read
 
-    // Execute on PointDataGrids
-
-    bool executeOnPoints = false;
-    for (auto grid : *grids) {
-        if (grid->isType<openvdb::points::PointDataGrid>()) {
-            executeOnPoints = true;
-            break;
+    if (!options.mShard.empty()) {
+        try {
+            const openvdb::ax::Shard shard = openvdb::ax::computeShard(
+                openvdb::GridCPtrVec(grids->begin(), grids->end()), shardIndex, shardCount);
+            openvdb::ax::extractShard(*grids, shard, options.mHalo);
+        } catch (openvdb::Exception& e) {
+            OPENVDB_LOG_ERROR(e.what() << " (" << options.mInputVDBFile << ")");
+            return EXIT_FAILURE;
         }
     }
 
-    if (executeOnPoints) {
+    // analyse the snippet and the grids up front so that only the targets which
+    // will be executed are compiled. Volumes are only compiled if the snippet
+    // accesses a volume in the file. Points are compiled unless every attribute the
+    // snippet accesses is a volume which no point grid has as an attribute. Without
+    // point grids, every accessed attribute must be a volume in the file.
 
-        using openvdb::ax::PointExecutable;
+    using openvdb::ax::PointExecutable;
+    using openvdb::ax::VolumeExecutable;
 
-        openvdb::ax::CustomData::Ptr customData = openvdb::ax::CustomData::create();
-        PointExecutable::Ptr pointExecutable;
+    openvdb::ax::ast::Tree::ConstPtr syntaxTree;
+    {
+        openvdb::ax::ScopedPhase phase(compilerOptions.phaseListener.get(), "parse");
+        syntaxTree = openvdb::ax::ast::parse(options.mInputCode.c_str());
+    }
 
-        const openvdb::ax::ast::Tree::ConstPtr syntaxTree =
-            openvdb::ax::ast::parse(options.mInputCode.c_str());
+    std::set<std::string> attributes;
+    openvdb::ax::ast::visitNodeType<openvdb::ax::ast::Attribute>(*syntaxTree,
+        [&attributes](const openvdb::ax::ast::Attribute& node) {
+            attributes.insert(node.mName);
+        });
 
-        if (options.mVerbose) std::cout << "OpenVDB PointDataGrids Found" << std::endl;
-        std::vector<std::string> warnings;
+    std::vector<openvdb::points::PointDataGrid::Ptr> pointGrids;
+    std::set<std::string> volumeNames;
+    for (const auto& grid : *grids) {
+        if (grid->isType<openvdb::points::PointDataGrid>()) {
+            pointGrids.emplace_back(openvdb::gridPtrCast<openvdb::points::PointDataGrid>(grid));
+        }
+        else {
+            volumeNames.insert(grid->getName());
+        }
+    }
 
-        try {
-            if (options.mVerbose) std::cout << "  Compiling for PointDataGrids...";
-            pointExecutable = compiler->compile<PointExecutable>(*syntaxTree, customData, &warnings);
-        } catch (std::exception& e) {
-            OPENVDB_LOG_FATAL("Compilation error!");
-            OPENVDB_LOG_FATAL("Errors:");
-            OPENVDB_LOG_FATAL(e.what());
+    bool executeOnPoints = !pointGrids.empty() && attributes.empty();
+    bool executeOnVolumes = false;
+    for (const std::string& name : attributes) {
+        if (volumeNames.count(name)) executeOnVolumes = true;
+        else if (!pointGrids.empty()) executeOnPoints = true;
+        else {
+            OPENVDB_LOG_FATAL("Missing grid \"@" << name << "\" (" << options.mInputVDBFile << ")");
             return EXIT_FAILURE;
         }
+    }
 
-        for (const std::string& warning : warnings) {
-            OPENVDB_LOG_WARN(warning);
+    for (const auto& points : pointGrids) {
+        if (executeOnPoints) break;
+        const auto leaf = points->tree().cbeginLeaf();
+        if (!leaf) continue;
+        const auto& descriptor = leaf->attributeSet().descriptor();
+        for (const std::string& name : attributes) {
+            if (descriptor.find(name) == openvdb::points::AttributeSet::INVALID_POS) continue;
+            executeOnPoints = true;
+            break;
         }
+    }
 
-        if (options.mVerbose) std::cout << "done." << std::endl;
+    if (options.mVerbose) {
+        if (!pointGrids.empty() && !executeOnPoints) {
+            std::cout << "Skipping PointDataGrids, the snippet only accesses volumes" << std::endl;
+        }
+        if (!volumeNames.empty() && !executeOnVolumes) {
+            std::cout << "Skipping Volume Grids, the snippet accesses none of them" << std::endl;
+        }
+    }
 
-        for (auto grid : *grids) {
-            if (!grid->isType<openvdb::points::PointDataGrid>()) continue;
+    // compile the targets concurrently. Each target uses its own compiler as a
+    // compiler's llvm context may only be used by one thread at a time
 
-            openvdb::points::PointDataGrid::Ptr points =
-               openvdb::gridPtrCast<openvdb::points::PointDataGrid>(grid);
-            if (options.mVerbose) std::cout << "  Executing on \"" + points->getName() + "\"...";
+    initializer.initializeCompiler();
 
-            try {
-                pointExecutable->execute(*points);
+    openvdb::ax::Compiler::Ptr pointCompiler, volumeCompiler;
+    PointExecutable::Ptr pointExecutable;
+    VolumeExecutable::Ptr volumeExecutable;
+    std::vector<std::string> pointWarnings, volumeWarnings;
+    std::string pointErrors, volumeErrors;
+
+    if (options.mVerbose && (executeOnPoints || executeOnVolumes)) {
+        std::cout << "  Compiling for"
+            << (executeOnPoints ? " PointDataGrids" : "")
+            << (executeOnPoints && executeOnVolumes ? " and" : "")
+            << (executeOnVolumes ? " Volume VDB Grids" : "") << "...";
+    }
 
-                const bool requiresDeletion =
-                    openvdb::ax::ast::callsFunction(*syntaxTree, "deletepoint");
+    // the emitted IR and assembly of each target is buffered so that the outputs of
+    // the concurrent compilations are not interleaved, and printed in order below
 
-                if (requiresDeletion) {
-                    openvdb::points::deleteFromGroup(points->tree(), "dead", false, false);
-                }
+    std::ostringstream pointEmitted, volumeEmitted;
+    openvdb::ax::CompilerOptions pointOptions(compilerOptions), volumeOptions(compilerOptions);
+    for (auto target : { std::make_pair(&pointOptions, &pointEmitted),
+                         std::make_pair(&volumeOptions, &volumeEmitted) }) {
+        if (target.first->irOutput) target.first->irOutput = target.second;
+        if (target.first->optimisedIROutput) target.first->optimisedIROutput = target.second;
+        if (target.first->assemblyOutput) target.first->assemblyOutput = target.second;
+    }
+
+    tbb::task_group compilation;
+    if (executeOnPoints) {
+        compilation.run([&]() {
+            try {
+                pointCompiler = openvdb::ax::Compiler::create(pointOptions);
+                pointExecutable = pointCompiler->compile<PointExecutable>(*syntaxTree,
+                    openvdb::ax::CustomData::create(), &pointWarnings);
+            } catch (std::exception& e) {
+                pointErrors = e.what();
             }
-            catch (std::exception& e) {
-                OPENVDB_LOG_FATAL("Execution error!");
-                OPENVDB_LOG_FATAL("Errors:");
-                OPENVDB_LOG_FATAL(e.what());
-                return EXIT_FAILURE;
+        });
+    }
+    if (executeOnVolumes) {
+        compilation.run([&]() {
+            try {
+                volumeCompiler = openvdb::ax::Compiler::create(volumeOptions);
+                volumeExecutable = volumeCompiler->compile<VolumeExecutable>(*syntaxTree,
+                    openvdb::ax::CustomData::create(), &volumeWarnings);
+            } catch (std::exception& e) {
+                volumeErrors = e.what();
             }
+        });
+    }
+    compilation.wait();
 
-            if (options.mVerbose) std::cout << "done." << std::endl << std::endl;
-        }
+    std::cout << pointEmitted.str() << volumeEmitted.str() << std::flush;
+
+    for (const std::string* errors : { &pointErrors, &volumeErrors }) {
+        if (errors->empty()) continue;
+        OPENVDB_LOG_FATAL("Compilation error!");
+        OPENVDB_LOG_FATAL("Errors:");
+        OPENVDB_LOG_FATAL(*errors);
+        return EXIT_FAILURE;
     }
 
-    // Execute on Volumes
+    for (const std::string& warning : pointWarnings) {
+        OPENVDB_LOG_WARN(warning);
+    }
+    for (const std::string& warning : volumeWarnings) {
+        OPENVDB_LOG_WARN(warning);
+    }
 
-    bool executeOnVolumes = false;
-    for (auto grid : *grids) {
-        if (!grid->isType<openvdb::points::PointDataGrid>()) {
-            executeOnVolumes = true;
-            break;
-        }
+    if (options.mVerbose && (executeOnPoints || executeOnVolumes)) {
+        std::cout << "done." << std::endl;
     }
 
-    if (executeOnVolumes) {
-        openvdb::ax::CustomData::Ptr customData = openvdb::ax::CustomData::create();
+    // Execute on PointDataGrids. All point grids are executed at once so that
+    // their leaf nodes share a single parallel region
 
-        using openvdb::ax::VolumeExecutable;
-        VolumeExecutable::Ptr volumeExecutable;
+    if (pointExecutable) {
 
-        if (options.mVerbose) std::cout << "OpenVDB Volume Grids Found" << std::endl;
-        std::vector<std::string> warnings;
+        if (options.mVerbose) {
+            std::cout << "OpenVDB PointDataGrids Found" << std::endl;
+            std::cout << "  Executing on " << pointGrids.size() << " PointDataGrids...";
+        }
+
+        const bool requiresDeletion =
+            openvdb::ax::ast::callsFunction(*syntaxTree, "deletepoint");
 
         try {
-            if (options.mVerbose) std::cout << "  Compiling for Volume VDB Grid...";
-            volumeExecutable =
-                compiler->compile<VolumeExecutable>(options.mInputCode, customData, &warnings);
-        } catch (std::exception& e) {
-            OPENVDB_LOG_FATAL("Compilation error!");
+            pointExecutable->execute(pointGrids);
+            if (requiresDeletion) {
+                tbb::parallel_for(size_t(0), pointGrids.size(), [&](const size_t i) {
+                    openvdb::points::deleteFromGroup(pointGrids[i]->tree(), "dead", false, false);
+                });
+            }
+        }
+        catch (std::exception& e) {
+            OPENVDB_LOG_FATAL("Execution error!");
             OPENVDB_LOG_FATAL("Errors:");
             OPENVDB_LOG_FATAL(e.what());
             return EXIT_FAILURE;
         }
 
-        for (const std::string& warning : warnings) {
-            OPENVDB_LOG_WARN(warning);
+        if (options.mVerbose) std::cout << "done." << std::endl << std::endl;
+
+        if (pointExecutable->profiler()) {
+            std::cout << "PointDataGrid Profile:" << std::endl;
+            pointExecutable->profiler()->print(std::cout);
         }
+    }
 
-        if (options.mVerbose) std::cout << "done." << std::endl;
+    // Execute on Volumes
+
+    if (volumeExecutable) {
 
         if (options.mVerbose) {
             std::string names("");
-            for (auto grid : *grids) {
-                if (grid->isType<openvdb::points::PointDataGrid>()) continue;
-                names += grid->getName() + ", ";
+            for (const std::string& name : volumeNames) {
+                names += name + ", ";
             }
 
             names.pop_back();
             names.pop_back();
+            std::cout << "OpenVDB Volume Grids Found" << std::endl;
             std::cout << "  Executing using \"" + names + "\"...";
         }
 
@@ -385,8 +1188,20 @@ main(int argc, char *argv[])
         }
 
         if (options.mVerbose) std::cout << "done." << std::endl;
+
+        if (volumeExecutable->profiler()) {
+            std::cout << "Volume Profile:" << std::endl;
+            volumeExecutable->profiler()->print(std::cout);
+        }
+    }
+
+    if (counters) {
+        std::cout << "Performance Counters:" << std::endl;
+        counters->print(std::cout);
     }
 
+    if (tracer) writeTrace(*tracer, options.mTraceFile);
+
     if (!options.mOutputVDBFile.empty()) {
         openvdb::io::File out(options.mOutputVDBFile);
 
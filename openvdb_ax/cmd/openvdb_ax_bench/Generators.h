@@ -0,0 +1,357 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file cmd/openvdb_ax_bench/Generators.h
+///
+/// @brief  Deterministic synthetic point and volume generators used by the
+///         vdb_ax_bench benchmark. All generators are seeded so that the same
+///         arguments always produce identical grids.
+///
+
+#ifndef OPENVDB_AX_CMD_BENCH_GENERATORS_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_CMD_BENCH_GENERATORS_HAS_BEEN_INCLUDED
+
+#include <openvdb/openvdb.h>
+#include <openvdb/points/PointAttribute.h>
+#include <openvdb/points/PointConversion.h>
+#include <openvdb/points/PointDataGrid.h>
+#include <openvdb/tools/PointIndexGrid.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+using RandomGenerator = std::mt19937;
+
+/// @brief  A description of a point attribute to generate
+struct AttributeSpec
+{
+    AttributeSpec(const std::string& name, const std::string& type,
+                  const std::string& codec = "null")
+        : mName(name), mType(type), mCodec(codec) {}
+
+    std::string mName;
+    /// @brief  The openvdb type name of the attribute, i.e. float, vec3s
+    std::string mType;
+    /// @brief  The codec to use, one of "null", "trnc" (truncate float and vec3s to
+    ///         half precision), "fxpt8" or "fxpt16" (unit range fixed point float
+    ///         and vec3s) or "uvec" (unit vector vec3s). Attributes of types which
+    ///         do not support the requested codec fall back to "null"
+    std::string mCodec;
+};
+
+using AttributeSpecs = std::vector<AttributeSpec>;
+
+namespace internal {
+
+template <typename T> struct RandomValue;
+
+template <> struct RandomValue<bool> {
+    static bool get(RandomGenerator& rng) {
+        return std::uniform_int_distribution<int>(0, 1)(rng) == 1;
+    }
+};
+template <> struct RandomValue<int32_t> {
+    static int32_t get(RandomGenerator& rng) {
+        return std::uniform_int_distribution<int32_t>(-1000, 1000)(rng);
+    }
+};
+template <> struct RandomValue<int64_t> {
+    static int64_t get(RandomGenerator& rng) {
+        return std::uniform_int_distribution<int64_t>(-1000, 1000)(rng);
+    }
+};
+template <> struct RandomValue<float> {
+    // unit range so that values are representable by the fixed point codecs
+    static float get(RandomGenerator& rng) {
+        return std::uniform_real_distribution<float>(0.0f, 1.0f)(rng);
+    }
+};
+template <> struct RandomValue<double> {
+    static double get(RandomGenerator& rng) {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    }
+};
+template <typename T> struct RandomValue<openvdb::math::Vec3<T>> {
+    static openvdb::math::Vec3<T> get(RandomGenerator& rng) {
+        const T x = RandomValue<T>::get(rng);
+        const T y = RandomValue<T>::get(rng);
+        const T z = RandomValue<T>::get(rng);
+        return openvdb::math::Vec3<T>(x, y, z);
+    }
+};
+
+template <typename ValueT, typename CodecT>
+inline void
+populate(openvdb::points::PointDataTree& tree,
+         const openvdb::tools::PointIndexTree& indexTree,
+         const std::string& name,
+         const size_t count,
+         RandomGenerator& rng)
+{
+    std::vector<ValueT> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.emplace_back(RandomValue<ValueT>::get(rng));
+    }
+
+    openvdb::points::appendAttribute<ValueT, CodecT>(tree, name);
+    openvdb::points::populateAttribute<openvdb::points::PointDataTree,
+        openvdb::tools::PointIndexTree, openvdb::points::PointAttributeVector<ValueT>>
+            (tree, indexTree, name, openvdb::points::PointAttributeVector<ValueT>(values));
+}
+
+inline void
+populate(openvdb::points::PointDataTree& tree,
+         const openvdb::tools::PointIndexTree& indexTree,
+         const AttributeSpec& spec,
+         const size_t count,
+         RandomGenerator& rng)
+{
+    using namespace openvdb::points;
+
+    const std::string& type = spec.mType;
+    const std::string& codec = spec.mCodec;
+
+    if (type == openvdb::typeNameAsString<float>()) {
+        if (codec == "trnc")        populate<float, TruncateCodec>(tree, indexTree, spec.mName, count, rng);
+        else if (codec == "fxpt8")  populate<float, FixedPointCodec<true, UnitRange>>(tree, indexTree, spec.mName, count, rng);
+        else if (codec == "fxpt16") populate<float, FixedPointCodec<false, UnitRange>>(tree, indexTree, spec.mName, count, rng);
+        else                        populate<float, NullCodec>(tree, indexTree, spec.mName, count, rng);
+    }
+    else if (type == openvdb::typeNameAsString<openvdb::Vec3s>()) {
+        if (codec == "trnc")        populate<openvdb::Vec3s, TruncateCodec>(tree, indexTree, spec.mName, count, rng);
+        else if (codec == "fxpt8")  populate<openvdb::Vec3s, FixedPointCodec<true, UnitRange>>(tree, indexTree, spec.mName, count, rng);
+        else if (codec == "fxpt16") populate<openvdb::Vec3s, FixedPointCodec<false, UnitRange>>(tree, indexTree, spec.mName, count, rng);
+        else if (codec == "uvec")   populate<openvdb::Vec3s, UnitVecCodec>(tree, indexTree, spec.mName, count, rng);
+        else                        populate<openvdb::Vec3s, NullCodec>(tree, indexTree, spec.mName, count, rng);
+    }
+    else if (type == openvdb::typeNameAsString<double>())  populate<double, NullCodec>(tree, indexTree, spec.mName, count, rng);
+    else if (type == openvdb::typeNameAsString<int32_t>()) populate<int32_t, NullCodec>(tree, indexTree, spec.mName, count, rng);
+    else if (type == openvdb::typeNameAsString<int64_t>()) populate<int64_t, NullCodec>(tree, indexTree, spec.mName, count, rng);
+    else if (type == openvdb::typeNameAsString<bool>())    populate<bool, NullCodec>(tree, indexTree, spec.mName, count, rng);
+    else if (type == openvdb::typeNameAsString<openvdb::Vec3d>()) {
+        populate<openvdb::Vec3d, NullCodec>(tree, indexTree, spec.mName, count, rng);
+    }
+    else if (type == openvdb::typeNameAsString<openvdb::Vec3i>()) {
+        populate<openvdb::Vec3i, NullCodec>(tree, indexTree, spec.mName, count, rng);
+    }
+    else {
+        OPENVDB_THROW(openvdb::TypeError, "Unable to generate point attribute \"" +
+            spec.mName + "\" of type \"" + type + "\"");
+    }
+}
+
+inline openvdb::points::PointDataGrid::Ptr
+createPoints(const std::vector<openvdb::Vec3s>& positions,
+             const AttributeSpecs& attributes,
+             const double pointsPerVoxel,
+             RandomGenerator& rng)
+{
+    // all generated positions lie within the [-1,1] cube
+    const double voxels = std::max(1.0, double(positions.size()) / pointsPerVoxel);
+    const double voxelSize = 2.0 / std::cbrt(voxels);
+
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(voxelSize);
+
+    const openvdb::points::PointAttributeVector<openvdb::Vec3s> wrapper(positions);
+    openvdb::tools::PointIndexGrid::Ptr indexGrid =
+        openvdb::tools::createPointIndexGrid<openvdb::tools::PointIndexGrid>(wrapper, *transform);
+
+    openvdb::points::PointDataGrid::Ptr grid =
+        openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(*indexGrid, wrapper, *transform);
+
+    for (const AttributeSpec& spec : attributes) {
+        populate(grid->tree(), indexGrid->tree(), spec, positions.size(), rng);
+    }
+
+    grid->setName("points");
+    return grid;
+}
+
+template <typename GridT>
+inline openvdb::GridBase::Ptr
+createVolume(const std::string& name,
+             const std::vector<openvdb::Coord>& coords,
+             const openvdb::math::Transform::Ptr& transform,
+             RandomGenerator& rng)
+{
+    using ValueT = typename GridT::ValueType;
+
+    typename GridT::Ptr grid = GridT::create();
+    auto accessor = grid->getAccessor();
+    for (const openvdb::Coord& ijk : coords) {
+        accessor.setValueOn(ijk, RandomValue<ValueT>::get(rng));
+    }
+
+    grid->setTransform(transform);
+    grid->setName(name);
+    return grid;
+}
+
+} // namespace internal
+
+/// @brief  Generate count points uniformly distributed within the [-1,1] cube
+/// @param  count           The number of points
+/// @param  attributes      Additional attributes to create and populate with random values
+/// @param  pointsPerVoxel  The average number of points per voxel, which determines the
+///                         voxel size of the resulting grid
+/// @param  seed            The random seed
+inline openvdb::points::PointDataGrid::Ptr
+uniformPoints(const size_t count,
+              const AttributeSpecs& attributes = AttributeSpecs(),
+              const double pointsPerVoxel = 8.0,
+              const unsigned seed = 0)
+{
+    RandomGenerator rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    std::vector<openvdb::Vec3s> positions;
+    positions.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float x = dist(rng);
+        const float y = dist(rng);
+        const float z = dist(rng);
+        positions.emplace_back(x, y, z);
+    }
+
+    return internal::createPoints(positions, attributes, pointsPerVoxel, rng);
+}
+
+/// @brief  Generate count points normally distributed around randomly placed cluster
+///         centres, producing a small number of densely populated leaf nodes and
+///         a large amount of empty space.
+/// @param  count           The number of points
+/// @param  clusters        The number of clusters
+/// @param  attributes      Additional attributes to create and populate with random values
+/// @param  pointsPerVoxel  The average number of points per voxel if the points were
+///                         uniformly distributed, which determines the voxel size
+/// @param  seed            The random seed
+inline openvdb::points::PointDataGrid::Ptr
+clusteredPoints(const size_t count,
+                const size_t clusters,
+                const AttributeSpecs& attributes = AttributeSpecs(),
+                const double pointsPerVoxel = 8.0,
+                const unsigned seed = 0)
+{
+    RandomGenerator rng(seed);
+    std::uniform_real_distribution<float> centreDist(-0.9f, 0.9f);
+    std::normal_distribution<float> offsetDist(0.0f, 0.05f);
+
+    std::vector<openvdb::Vec3s> centres;
+    for (size_t i = 0; i < std::max(clusters, size_t(1)); ++i) {
+        const float x = centreDist(rng);
+        const float y = centreDist(rng);
+        const float z = centreDist(rng);
+        centres.emplace_back(x, y, z);
+    }
+
+    std::vector<openvdb::Vec3s> positions;
+    positions.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const openvdb::Vec3s& centre = centres[i % centres.size()];
+        openvdb::Vec3s pos;
+        for (int axis = 0; axis < 3; ++axis) {
+            pos[axis] = openvdb::math::Clamp(centre[axis] + offsetDist(rng), -1.0f, 1.0f);
+        }
+        positions.emplace_back(pos);
+    }
+
+    return internal::createPoints(positions, attributes, pointsPerVoxel, rng);
+}
+
+/// @brief  Generate the active voxel coordinates of a volume of approximately the given
+///         number of voxels, arranged as a cube centred on the origin.
+/// @param  voxels   The number of voxels in the fully dense cube
+/// @param  density  The fraction of voxels in the cube which are active. A density of 1
+///                  produces a dense volume, lower values sparsely activate voxels
+/// @param  seed     The random seed
+inline std::vector<openvdb::Coord>
+volumeTopology(const size_t voxels, const double density = 1.0, const unsigned seed = 0)
+{
+    RandomGenerator rng(seed);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    const int dim = std::max(1, int(std::round(std::cbrt(double(voxels)))));
+    const int min = -dim / 2, max = min + dim - 1;
+
+    std::vector<openvdb::Coord> coords;
+    coords.reserve(size_t(double(dim) * dim * dim * std::min(density, 1.0)));
+    for (int i = min; i <= max; ++i) {
+        for (int j = min; j <= max; ++j) {
+            for (int k = min; k <= max; ++k) {
+                if (density >= 1.0 || dist(rng) < density) coords.emplace_back(i, j, k);
+            }
+        }
+    }
+    return coords;
+}
+
+/// @brief  Create a volume of the given openvdb value type name with the given active
+///         topology, populated with random values
+/// @param  name    The grid name
+/// @param  type    The openvdb value type name, i.e. float, vec3s
+/// @param  coords  The active voxels, as generated by volumeTopology()
+/// @param  seed    The random seed
+inline openvdb::GridBase::Ptr
+createVolume(const std::string& name,
+             const std::string& type,
+             const std::vector<openvdb::Coord>& coords,
+             const unsigned seed = 0)
+{
+    RandomGenerator rng(seed);
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(0.1);
+
+    if (type == openvdb::typeNameAsString<float>())   return internal::createVolume<openvdb::FloatGrid>(name, coords, transform, rng);
+    if (type == openvdb::typeNameAsString<double>())  return internal::createVolume<openvdb::DoubleGrid>(name, coords, transform, rng);
+    if (type == openvdb::typeNameAsString<int32_t>()) return internal::createVolume<openvdb::Int32Grid>(name, coords, transform, rng);
+    if (type == openvdb::typeNameAsString<int64_t>()) return internal::createVolume<openvdb::Int64Grid>(name, coords, transform, rng);
+    if (type == openvdb::typeNameAsString<bool>())    return internal::createVolume<openvdb::BoolGrid>(name, coords, transform, rng);
+    if (type == openvdb::typeNameAsString<openvdb::Vec3s>()) return internal::createVolume<openvdb::Vec3SGrid>(name, coords, transform, rng);
+    if (type == openvdb::typeNameAsString<openvdb::Vec3d>()) return internal::createVolume<openvdb::Vec3DGrid>(name, coords, transform, rng);
+    if (type == openvdb::typeNameAsString<openvdb::Vec3i>()) return internal::createVolume<openvdb::Vec3IGrid>(name, coords, transform, rng);
+
+    OPENVDB_THROW(openvdb::TypeError, "Unable to generate volume \"" + name +
+        "\" of type \"" + type + "\"");
+}
+
+} // namespace bench
+
+#endif // OPENVDB_AX_CMD_BENCH_GENERATORS_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -0,0 +1,967 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "Generators.h"
+
+#include <openvdb_ax/ast/AST.h>
+#include <openvdb_ax/ast/Scanners.h>
+#include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/PerfCounters.h>
+#include <openvdb_ax/compiler/PhaseListener.h>
+#include <openvdb_ax/compiler/PointExecutable.h>
+#include <openvdb_ax/compiler/VolumeExecutable.h>
+
+#include <openvdb/openvdb.h>
+#include <openvdb/points/PointCount.h>
+#include <openvdb/util/logging.h>
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_init.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h> // malloc_trim
+#endif
+
+const char* gProgName = "";
+
+// A curated set of snippets from test/snippets which cover the main code paths
+// of the compiler and executables
+
+const std::vector<std::string> gPointSnippets = {
+    "assign/assignArithmetic",
+    "binary/binaryFloatingArithmetic",
+    "binary/binaryVectorArithmetic",
+    "function/functionNormalize",
+    "function/functionPow",
+    "keyword/conditionalSimpleElseIf",
+    "worldspace/worldSpaceIncrement"
+};
+
+const std::vector<std::string> gVolumeSnippets = {
+    "assign/assignArithmetic",
+    "cast/castFloatVolume",
+    "declare/declareAttributesVolume",
+    "function/functionVolumePWS"
+};
+
+struct ProgOptions
+{
+    std::string mSnippetDir = "test/snippets";
+    std::string mOutputFile = "";
+    std::vector<std::string> mPointSnippets;
+    std::vector<std::string> mVolumeSnippets;
+    size_t mPoints = 1000000;
+    size_t mClusters = 16;
+    size_t mVoxels = 1000000;
+    double mDensity = 0.1;
+    std::string mCodec = "null";
+    int mRepeat = 5;
+    int mThreads = -1;
+    std::vector<int> mScaleThreads;
+    std::vector<size_t> mScaleSizes;
+    std::vector<size_t> mCodegenSizes;
+    unsigned mSeed = 0;
+    bool mCounters = false;
+    openvdb::ax::CompilerOptions::OptLevel mOptLevel =
+        openvdb::ax::CompilerOptions::OptLevel::O3;
+    openvdb::ax::CompilerOptions::LeafOrder mLeafOrder =
+        openvdb::ax::CompilerOptions::LeafOrder::TREE;
+};
+
+void
+usage [[noreturn]] (int exitStatus = EXIT_FAILURE)
+{
+    std::cerr <<
+"Usage: " << gProgName << " [OPTIONS] [-p snippet]... [-V snippet]...\n" <<
+"Which: times the parse, codegen, optimise, jit and execute phases of AX for a set of\n" <<
+"       snippets on deterministic synthetic grids and writes the results as JSON\n\n" <<
+"Options:\n" <<
+"    -d dir            directory containing the AX test snippets (default: test/snippets)\n" <<
+"    -p snippet        benchmark a snippet relative to the snippet directory on points\n" <<
+"    -V snippet        benchmark a snippet relative to the snippet directory on volumes\n" <<
+"                      (if neither -p, -V nor --codegen-sizes are provided, a curated\n" <<
+"                      set is used)\n" <<
+"    -o file.json      write the results to file.json (default: stdout)\n" <<
+"    --points N        number of generated points (default: 1000000)\n" <<
+"    --clusters N      number of clusters for the clustered point distribution (default: 16)\n" <<
+"    --codec name      codec of generated float and vec3s point attributes, one of null,\n" <<
+"                      trnc, fxpt8, fxpt16 or uvec (default: null)\n" <<
+"    --voxels N        number of voxels in the generated dense volumes (default: 1000000)\n" <<
+"    --density D       fraction of active voxels in the generated sparse volumes\n" <<
+"                      (default: 0.1)\n" <<
+"    --repeat N        number of times each snippet is compiled and executed (default: 5)\n" <<
+"    --threads N       number of threads to execute with (default: all available)\n" <<
+"    --seed N          random seed of the generators (default: 0)\n" <<
+"    --counters        record the hardware performance counters of each phase\n" <<
+"                      (Linux only)\n" <<
+"    --scale-threads L run a scaling study, executing each snippet in task arenas of\n" <<
+"                      each of the comma separated thread counts L, i.e. 1,2,4,8\n" <<
+"    --scale-sizes L   comma separated element counts of the generated data for the\n" <<
+"                      scaling study (default: the --points and --voxels counts)\n" <<
+"    --codegen-sizes L time the compilation of generated snippets of each of the comma\n" <<
+"                      separated statement counts L, i.e. 1000,10000,100000. The per\n" <<
+"                      statement cost of each phase should remain roughly constant\n" <<
+"    --opt level       llvm optimization level, one of NONE, O0, O1, O2, O3, Os or Oz\n" <<
+"                      (default: O3)\n" <<
+"    --leaf-order name order in which volume leaf nodes are executed, one of tree or\n" <<
+"                      morton (default: tree). Use with --counters to compare the\n" <<
+"                      cache misses of each order\n";
+    exit(exitStatus);
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string& list)
+{
+    std::vector<T> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        values.emplace_back(static_cast<T>(std::stoll(item)));
+    }
+    return values;
+}
+
+/// @brief  Returns a memory size of this process in kilobytes from /proc/self/status,
+///         i.e. "VmRSS" or "VmHWM", or -1 if it is not available on this platform
+long processMemory(const std::string& key)
+{
+#if defined(__linux__)
+    std::ifstream in("/proc/self/status");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.compare(0, key.size() + 1, key + ":") != 0) continue;
+        try {
+            return std::stol(line.substr(key.size() + 1));
+        }
+        catch (std::exception&) {
+            return -1;
+        }
+    }
+#endif
+    return -1;
+}
+
+/// @brief  Resets the peak resident set size of this process to its current resident
+///         set size, returning it in kilobytes or -1 if this is not supported. Memory
+///         which has been freed is first released, where possible, so that it is not
+///         counted as resident.
+long resetPeakRSS()
+{
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+#if defined(__linux__)
+    std::ofstream out("/proc/self/clear_refs");
+    out << "5";
+    out.close();
+    if (out) return processMemory("VmRSS");
+#endif
+    return -1;
+}
+
+/// @brief  Returns the increase in kilobytes of the peak resident set size since it
+///         was reset to the given resident set size, or -1 if it is not available
+long peakRSS(const long baseRSS)
+{
+    const long peak = baseRSS < 0 ? -1 : processMemory("VmHWM");
+    return peak < 0 ? -1 : std::max(peak - baseRSS, 0L);
+}
+
+bool loadSnippetFile(const std::string& fileName, std::string& textString)
+{
+    std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (!in) return false;
+
+    textString =
+        std::string(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+    return true;
+}
+
+openvdb::ax::CompilerOptions::OptLevel
+optLevelFromString(const std::string& level)
+{
+    using OptLevel = openvdb::ax::CompilerOptions::OptLevel;
+
+    if (level == "NONE") return OptLevel::NONE;
+    if (level == "O0")   return OptLevel::O0;
+    if (level == "O1")   return OptLevel::O1;
+    if (level == "O2")   return OptLevel::O2;
+    if (level == "O3")   return OptLevel::O3;
+    if (level == "Os")   return OptLevel::Os;
+    if (level == "Oz")   return OptLevel::Oz;
+
+    OPENVDB_LOG_FATAL("\"" + level + "\" is not a valid optimization level");
+    usage();
+}
+
+openvdb::ax::CompilerOptions::LeafOrder
+leafOrderFromString(const std::string& order)
+{
+    using LeafOrder = openvdb::ax::CompilerOptions::LeafOrder;
+
+    if (order == "tree")   return LeafOrder::TREE;
+    if (order == "morton") return LeafOrder::MORTON;
+
+    OPENVDB_LOG_FATAL("\"" + order + "\" is not a valid leaf order");
+    usage();
+}
+
+std::string
+leafOrderToString(const openvdb::ax::CompilerOptions::LeafOrder order)
+{
+    return order == openvdb::ax::CompilerOptions::LeafOrder::MORTON ? "morton" : "tree";
+}
+
+struct OptParse
+{
+    int argc;
+    char** argv;
+
+    OptParse(int argc_, char* argv_[]): argc(argc_), argv(argv_) {}
+
+    bool check(int idx, const std::string& name, int numArgs = 1) const
+    {
+        if (argv[idx] == name) {
+            if (idx + numArgs >= argc) {
+                OPENVDB_LOG_FATAL("option " << name << " requires "
+                    << numArgs << " argument" << (numArgs == 1 ? "" : "s"));
+                usage();
+            }
+            return true;
+        }
+        return false;
+    }
+};
+
+struct ScopedInitialize
+{
+    ScopedInitialize(int argc, char *argv[]) {
+        openvdb::logging::initialize(argc, argv);
+        openvdb::initialize();
+        openvdb::ax::initialize();
+    }
+
+    ~ScopedInitialize() {
+        openvdb::ax::uninitialize();
+        openvdb::uninitialize();
+    }
+};
+
+/// @brief  A PhaseListener which records the wall clock duration of every phase.
+///         Durations are recorded per thread so that concurrent phases, such as the
+///         leaf ranges of a kernel, do not contend.
+class PhaseTimer : public openvdb::ax::PhaseListener
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Ptr = std::shared_ptr<PhaseTimer>;
+    using Timings = std::map<std::string, std::vector<double>>;
+
+    void begin(const std::string&) override
+    {
+        mStarts.local().emplace_back(Clock::now());
+    }
+
+    void end(const std::string& phase) override
+    {
+        const Clock::time_point now = Clock::now();
+        std::vector<Clock::time_point>& starts = mStarts.local();
+        const std::chrono::duration<double> elapsed = now - starts.back();
+        starts.pop_back();
+        mTimings.local()[phase].push_back(elapsed.count());
+    }
+
+    /// @brief  Returns the recorded durations in seconds of each phase over all threads
+    Timings timings() const
+    {
+        Timings result;
+        for (const Timings& timings : mTimings) {
+            for (const auto& iter : timings) {
+                std::vector<double>& durations = result[iter.first];
+                durations.insert(durations.end(), iter.second.begin(), iter.second.end());
+            }
+        }
+        return result;
+    }
+
+    /// @brief  Discard all recorded durations
+    void clear() { mTimings.clear(); }
+
+private:
+    tbb::enumerable_thread_specific<std::vector<Clock::time_point>> mStarts;
+    tbb::enumerable_thread_specific<Timings> mTimings;
+};
+
+/// @brief  The result of a single snippet on a single data set
+struct Result
+{
+    std::string mSnippet;
+    std::string mTarget;
+    std::string mError;
+    size_t mElements = 0;
+    int mThreads = 0;
+    // the peak increase in the resident set size in kilobytes over the runs, relative
+    // to the resident set size after the input data was built, or -1 if not available
+    long mPeakRSS = -1;
+    PhaseTimer::Timings mTimings;
+    std::map<std::string, openvdb::ax::PerfCounters::Counts> mCounters;
+
+    /// @brief  Returns the median execution time in seconds, or zero if the
+    ///         snippet was never executed
+    double executeTime() const
+    {
+        const auto iter = mTimings.find("execute");
+        if (iter == mTimings.end()) return 0.0;
+        return median(iter->second);
+    }
+
+    static double median(std::vector<double> timings)
+    {
+        if (timings.empty()) return 0.0;
+        std::sort(timings.begin(), timings.end());
+        return timings[timings.size() / 2];
+    }
+};
+
+void writeTimings(std::ostream& os, const std::vector<double>& timings)
+{
+    double min = timings.front(), max = timings.front(), sum = 0.0;
+    for (const double t : timings) {
+        min = std::min(min, t);
+        max = std::max(max, t);
+        sum += t;
+    }
+
+    os << "{\"min\": " << min
+       << ", \"median\": " << Result::median(timings)
+       << ", \"mean\": " << sum / double(timings.size())
+       << ", \"max\": " << max
+       << ", \"samples\": " << timings.size() << "}";
+}
+
+void writeCounters(std::ostream& os, const openvdb::ax::PerfCounters::Counts& counts)
+{
+    using openvdb::ax::PerfCounters;
+
+    os << "{\"invocations\": " << counts.mInvocations
+       << ", \"threads\": " << counts.mThreads;
+    for (size_t i = 0; i < PerfCounters::NUM_EVENTS; ++i) {
+        const PerfCounters::Event event = static_cast<PerfCounters::Event>(i);
+        if (!PerfCounters::supported(event)) continue;
+        std::string name(PerfCounters::eventName(event));
+        std::replace(name.begin(), name.end(), ' ', '_');
+        os << ", \"" << name << "\": " << counts.mValues[i];
+    }
+    os << "}";
+}
+
+void writeJSON(std::ostream& os,
+               const ProgOptions& options,
+               const std::vector<Result>& results)
+{
+    os << std::setprecision(9);
+    os << "{\n";
+    os << "  \"openvdb_version\": \"" << openvdb::getLibraryVersionString() << "\",\n";
+    os << "  \"threads\": " << options.mThreads << ",\n";
+    os << "  \"repeat\": " << options.mRepeat << ",\n";
+    os << "  \"seed\": " << options.mSeed << ",\n";
+    os << "  \"points\": " << options.mPoints << ",\n";
+    os << "  \"clusters\": " << options.mClusters << ",\n";
+    os << "  \"codec\": \"" << options.mCodec << "\",\n";
+    os << "  \"voxels\": " << options.mVoxels << ",\n";
+    os << "  \"density\": " << options.mDensity << ",\n";
+    os << "  \"leaf_order\": \"" << leafOrderToString(options.mLeafOrder) << "\",\n";
+    os << "  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+
+        // speedup and parallel efficiency are relative to the first result of the
+        // same snippet, target and data size, which is the smallest thread count
+        // of a scaling study
+
+        const Result* baseline = &result;
+        for (size_t j = 0; j < i; ++j) {
+            if (results[j].mSnippet == result.mSnippet &&
+                results[j].mTarget == result.mTarget &&
+                results[j].mElements == result.mElements) {
+                baseline = &results[j];
+                break;
+            }
+        }
+
+        const double time = result.executeTime();
+        const double baseTime = baseline->executeTime();
+        const double throughput = time > 0.0 ? double(result.mElements) / time : 0.0;
+        const double speedup = time > 0.0 ? baseTime / time : 0.0;
+        const double efficiency =
+            speedup * double(baseline->mThreads) / double(std::max(result.mThreads, 1));
+
+        os << (i == 0 ? "\n" : ",\n");
+        os << "    {\n";
+        os << "      \"snippet\": \"" << result.mSnippet << "\",\n";
+        os << "      \"target\": \"" << result.mTarget << "\",\n";
+        os << "      \"elements\": " << result.mElements << ",\n";
+        os << "      \"threads\": " << result.mThreads << ",\n";
+        os << "      \"peak_rss_kb\": " << result.mPeakRSS << ",\n";
+        os << "      \"throughput\": " << throughput << ",\n";
+        os << "      \"speedup\": " << speedup << ",\n";
+        os << "      \"efficiency\": " << efficiency << ",\n";
+        if (!result.mError.empty()) {
+            std::string error(result.mError);
+            std::replace(error.begin(), error.end(), '"', '\'');
+            std::replace(error.begin(), error.end(), '\n', ' ');
+            os << "      \"error\": \"" << error << "\",\n";
+        }
+        os << "      \"phases\": {";
+        bool first = true;
+        for (const auto& timing : result.mTimings) {
+            os << (first ? "\n" : ",\n");
+            os << "        \"" << timing.first << "\": ";
+            writeTimings(os, timing.second);
+            first = false;
+        }
+        os << (first ? "}" : "\n      }");
+
+        if (!result.mCounters.empty()) {
+            os << ",\n      \"counters\": {";
+            first = true;
+            for (const auto& counters : result.mCounters) {
+                os << (first ? "\n" : ",\n");
+                os << "        \"" << counters.first << "\": ";
+                writeCounters(os, counters.second);
+                first = false;
+            }
+            os << "\n      }";
+        }
+
+        os << "\n    }";
+    }
+
+    os << (results.empty() ? "]\n" : "\n  ]\n");
+    os << "}\n";
+}
+
+/// @brief  Returns the names and types of all attributes accessed by a snippet
+std::map<std::string, std::string>
+accessedAttributes(const openvdb::ax::ast::Tree& tree)
+{
+    std::map<std::string, std::string> attributes;
+    openvdb::ax::ast::visitNodeType<openvdb::ax::ast::Attribute>(tree,
+        [&attributes](const openvdb::ax::ast::Attribute& node) {
+            attributes.insert({node.mName, node.mType});
+        });
+    return attributes;
+}
+
+/// @brief  The listeners which record the phases of a single benchmark
+struct Recorder
+{
+    Recorder(const ProgOptions& options)
+        : mTimer(new PhaseTimer)
+        , mListeners(new openvdb::ax::PhaseListenerList)
+    {
+        // counters are added first so that their overhead is excluded from the timings
+        if (options.mCounters) {
+            mCounters.reset(new openvdb::ax::PerfCounters);
+            mListeners->add(mCounters);
+        }
+        mListeners->add(mTimer);
+    }
+
+    void clear()
+    {
+        mTimer->clear();
+        if (mCounters) mCounters->clear();
+    }
+
+    /// @brief  Starts measuring the peak memory of the runs from the current resident
+    ///         set size, so that memory allocated before, i.e. to build the input data
+    ///         or by earlier runs, is excluded
+    void resetMemory()
+    {
+        mBaseRSS = resetPeakRSS();
+    }
+
+    void record(Result& result) const
+    {
+        result.mTimings = mTimer->timings();
+        if (mCounters) result.mCounters = mCounters->report();
+        result.mPeakRSS = peakRSS(mBaseRSS);
+    }
+
+    PhaseTimer::Ptr mTimer;
+    openvdb::ax::PerfCounters::Ptr mCounters;
+    openvdb::ax::PhaseListenerList::Ptr mListeners;
+    long mBaseRSS = -1;
+};
+
+/// @brief  Compile the code with a new compiler which reports its phases to the recorder.
+///         The returned executable reports its execution to the same recorder.
+template <typename ExecutableT>
+typename ExecutableT::Ptr
+compile(const std::string& code,
+        const ProgOptions& options,
+        const Recorder& recorder)
+{
+    openvdb::ax::CompilerOptions compilerOptions;
+    compilerOptions.optLevel = options.mOptLevel;
+    compilerOptions.leafOrder = options.mLeafOrder;
+    compilerOptions.phaseListener = recorder.mListeners;
+
+    openvdb::ax::Compiler::Ptr compiler = openvdb::ax::Compiler::create(compilerOptions);
+    return compiler->compile<ExecutableT>(code, openvdb::ax::CustomData::create());
+}
+
+Result
+benchmarkPoints(const std::string& snippet,
+                const std::string& code,
+                const std::string& target,
+                const openvdb::points::PointDataGrid& grid,
+                const ProgOptions& options)
+{
+    Result result;
+    result.mSnippet = snippet;
+    result.mTarget = target;
+    result.mElements = openvdb::points::pointCount(grid.constTree());
+    result.mThreads = options.mThreads;
+
+    Recorder recorder(options);
+    recorder.resetMemory();
+
+    try {
+        for (int i = 0; i < options.mRepeat; ++i) {
+            openvdb::ax::PointExecutable::Ptr executable =
+                compile<openvdb::ax::PointExecutable>(code, options, recorder);
+
+            // copy outside of the timed region so that every execution starts
+            // from identical data
+            openvdb::points::PointDataGrid::Ptr copy = grid.deepCopy();
+            executable->execute(*copy);
+        }
+    }
+    catch (std::exception& e) {
+        result.mError = e.what();
+    }
+
+    recorder.record(result);
+    return result;
+}
+
+Result
+benchmarkVolumes(const std::string& snippet,
+                 const std::string& code,
+                 const std::string& target,
+                 const std::vector<openvdb::Coord>& topology,
+                 const ProgOptions& options)
+{
+    Result result;
+    result.mSnippet = snippet;
+    result.mTarget = target;
+    result.mElements = topology.size();
+    result.mThreads = options.mThreads;
+
+    Recorder recorder(options);
+
+    try {
+        const openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+
+        openvdb::GridPtrVec grids;
+        unsigned seed = options.mSeed;
+        for (const auto& attribute : accessedAttributes(*tree)) {
+            grids.emplace_back(bench::createVolume(attribute.first, attribute.second,
+                topology, seed++));
+        }
+
+        recorder.resetMemory();
+
+        for (int i = 0; i < options.mRepeat; ++i) {
+            openvdb::ax::VolumeExecutable::Ptr executable =
+                compile<openvdb::ax::VolumeExecutable>(code, options, recorder);
+
+            openvdb::GridPtrVec copies;
+            for (const auto& grid : grids) copies.emplace_back(grid->deepCopyGrid());
+            executable->execute(copies);
+        }
+    }
+    catch (std::exception& e) {
+        result.mError = e.what();
+    }
+
+    recorder.record(result);
+    return result;
+}
+
+/// @brief  Returns the point attributes accessed by a snippet, other than P, which
+///         are pre-populated on generated points so that their codecs are exercised
+bench::AttributeSpecs
+pointAttributes(const std::string& code, const std::string& codec)
+{
+    bench::AttributeSpecs attributes;
+    const openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+    for (const auto& attribute : accessedAttributes(*tree)) {
+        if (attribute.first == "P") continue;
+        attributes.emplace_back(attribute.first, attribute.second, codec);
+    }
+    return attributes;
+}
+
+/// @brief  Run the execute operator repeatedly within a task arena of each of the
+///         requested thread counts, appending a result per thread count. The recorder
+///         must observe the executable which the operator runs.
+template <typename ExecuteOpT>
+void scale(const Result& base,
+           const ExecuteOpT& op,
+           Recorder& recorder,
+           const ProgOptions& options,
+           std::vector<Result>& results)
+{
+    for (const int threads : options.mScaleThreads) {
+        Result result(base);
+        result.mThreads = threads;
+        recorder.clear();
+        recorder.resetMemory();
+
+        try {
+            tbb::task_arena arena(threads);
+            arena.execute([&]() {
+                for (int i = 0; i < options.mRepeat; ++i) op();
+            });
+        }
+        catch (std::exception& e) {
+            result.mError = e.what();
+        }
+
+        recorder.record(result);
+        results.emplace_back(result);
+    }
+}
+
+/// @brief  Returns a generated snippet of the given number of statements. Every
+///         statement declares a new local from the previous one, and every tenth
+///         statement opens a scope which shadows and reads the locals declared
+///         before it
+std::string
+generatedSnippet(const size_t statements)
+{
+    std::ostringstream os;
+    os << "float a0 = 1.0f;\n";
+    for (size_t i = 1; i < statements; ++i) {
+        if (i % 10 == 0) {
+            os << "if (a" << i-1 << " > 0.0f) { float a" << i-2 << " = a" << i-1
+               << " * 2.0f; float t = a" << i-2 << "; }\n";
+        }
+        os << "float a" << i << " = a" << i-1 << " + 1.0f;\n";
+    }
+    return os.str();
+}
+
+/// @brief  Time the compilation of a generated snippet of the given number of
+///         statements. The snippet accesses no attributes and is never executed.
+Result
+benchmarkCodegen(const size_t statements,
+                 const ProgOptions& options)
+{
+    Result result;
+    result.mSnippet = "generated";
+    result.mTarget = "codegen";
+    result.mElements = statements;
+    result.mThreads = options.mThreads;
+
+    Recorder recorder(options);
+
+    try {
+        const std::string code = generatedSnippet(statements);
+        recorder.resetMemory();
+        for (int i = 0; i < options.mRepeat; ++i) {
+            compile<openvdb::ax::PointExecutable>(code, options, recorder);
+        }
+    }
+    catch (std::exception& e) {
+        result.mError = e.what();
+    }
+
+    recorder.record(result);
+    return result;
+}
+
+void
+scalePoints(const std::string& snippet,
+            const std::string& code,
+            const size_t count,
+            const ProgOptions& options,
+            std::vector<Result>& results)
+{
+    Result base;
+    base.mSnippet = snippet;
+    base.mTarget = "points_uniform";
+    base.mElements = count;
+
+    Recorder recorder(options);
+    openvdb::ax::PointExecutable::Ptr executable;
+    openvdb::points::PointDataGrid::Ptr grid;
+
+    try {
+        executable = compile<openvdb::ax::PointExecutable>(code, options, recorder);
+        grid = bench::uniformPoints(count, pointAttributes(code, options.mCodec), 8.0,
+            options.mSeed);
+    }
+    catch (std::exception& e) {
+        base.mError = e.what();
+        results.emplace_back(base);
+        return;
+    }
+
+    scale(base, [&]() {
+            openvdb::points::PointDataGrid::Ptr copy = grid->deepCopy();
+            executable->execute(*copy);
+        }, recorder, options, results);
+}
+
+void
+scaleVolumes(const std::string& snippet,
+             const std::string& code,
+             const size_t count,
+             const ProgOptions& options,
+             std::vector<Result>& results)
+{
+    Result base;
+    base.mSnippet = snippet;
+    base.mTarget = "volume_dense";
+
+    Recorder recorder(options);
+    openvdb::ax::VolumeExecutable::Ptr executable;
+    openvdb::GridPtrVec grids;
+
+    try {
+        executable = compile<openvdb::ax::VolumeExecutable>(code, options, recorder);
+
+        const std::vector<openvdb::Coord> topology =
+            bench::volumeTopology(count, 1.0, options.mSeed);
+        base.mElements = topology.size();
+
+        const openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(code.c_str());
+        unsigned seed = options.mSeed;
+        for (const auto& attribute : accessedAttributes(*tree)) {
+            grids.emplace_back(bench::createVolume(attribute.first, attribute.second,
+                topology, seed++));
+        }
+    }
+    catch (std::exception& e) {
+        base.mError = e.what();
+        results.emplace_back(base);
+        return;
+    }
+
+    scale(base, [&]() {
+            openvdb::GridPtrVec copies;
+            for (const auto& grid : grids) copies.emplace_back(grid->deepCopyGrid());
+            executable->execute(copies);
+        }, recorder, options, results);
+}
+
+int
+main(int argc, char *argv[])
+{
+    OPENVDB_START_THREADSAFE_STATIC_WRITE
+    gProgName = argv[0];
+    const char* ptr = ::strrchr(gProgName, '/');
+    if (ptr != nullptr) gProgName = ptr + 1;
+    OPENVDB_FINISH_THREADSAFE_STATIC_WRITE
+
+    ScopedInitialize initializer(argc, argv);
+    OptParse parser(argc, argv);
+    ProgOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (parser.check(i, "-d")) {
+            options.mSnippetDir = argv[++i];
+        } else if (parser.check(i, "-p")) {
+            options.mPointSnippets.emplace_back(argv[++i]);
+        } else if (parser.check(i, "-V")) {
+            options.mVolumeSnippets.emplace_back(argv[++i]);
+        } else if (parser.check(i, "-o")) {
+            options.mOutputFile = argv[++i];
+        } else if (parser.check(i, "--points")) {
+            options.mPoints = std::stoul(argv[++i]);
+        } else if (parser.check(i, "--clusters")) {
+            options.mClusters = std::stoul(argv[++i]);
+        } else if (parser.check(i, "--codec")) {
+            options.mCodec = argv[++i];
+        } else if (parser.check(i, "--voxels")) {
+            options.mVoxels = std::stoul(argv[++i]);
+        } else if (parser.check(i, "--density")) {
+            options.mDensity = std::stod(argv[++i]);
+        } else if (parser.check(i, "--repeat")) {
+            options.mRepeat = std::max(1, std::stoi(argv[++i]));
+        } else if (parser.check(i, "--threads")) {
+            options.mThreads = std::stoi(argv[++i]);
+        } else if (parser.check(i, "--scale-threads")) {
+            options.mScaleThreads = parseList<int>(argv[++i]);
+        } else if (parser.check(i, "--scale-sizes")) {
+            options.mScaleSizes = parseList<size_t>(argv[++i]);
+        } else if (parser.check(i, "--codegen-sizes")) {
+            options.mCodegenSizes = parseList<size_t>(argv[++i]);
+        } else if (parser.check(i, "--counters", 0)) {
+            options.mCounters = true;
+        } else if (parser.check(i, "--seed")) {
+            options.mSeed = unsigned(std::stoul(argv[++i]));
+        } else if (parser.check(i, "--opt")) {
+            options.mOptLevel = optLevelFromString(argv[++i]);
+        } else if (parser.check(i, "--leaf-order")) {
+            options.mLeafOrder = leafOrderFromString(argv[++i]);
+        } else if (arg == "-h" || arg == "-help" || arg == "--help") {
+            usage(EXIT_SUCCESS);
+        } else {
+            OPENVDB_LOG_FATAL("\"" + arg + "\" is not a valid option");
+            usage();
+        }
+    }
+
+    if (options.mPointSnippets.empty() && options.mVolumeSnippets.empty() &&
+        options.mCodegenSizes.empty()) {
+        options.mPointSnippets = gPointSnippets;
+        options.mVolumeSnippets = gVolumeSnippets;
+    }
+
+    const bool scaling = !options.mScaleThreads.empty();
+    if (scaling) {
+        // the scheduler must allow the largest arena and the study is run from
+        // the smallest thread count so that it is the baseline for efficiency
+        std::sort(options.mScaleThreads.begin(), options.mScaleThreads.end());
+        options.mThreads = std::max(options.mScaleThreads.back(), 1);
+        std::sort(options.mScaleSizes.begin(), options.mScaleSizes.end());
+    }
+
+    if (options.mThreads <= 0) {
+        options.mThreads = tbb::task_scheduler_init::default_num_threads();
+    }
+    tbb::task_scheduler_init scheduler(options.mThreads);
+
+    std::vector<Result> results;
+
+    // points
+
+    for (const std::string& snippet : options.mPointSnippets) {
+        std::string code;
+        if (!loadSnippetFile(options.mSnippetDir + "/" + snippet, code)) {
+            OPENVDB_LOG_ERROR("Unable to load snippet \"" << snippet << "\"");
+            return EXIT_FAILURE;
+        }
+
+        if (scaling) {
+            const std::vector<size_t> sizes = options.mScaleSizes.empty() ?
+                std::vector<size_t>{options.mPoints} : options.mScaleSizes;
+            for (const size_t size : sizes) scalePoints(snippet, code, size, options, results);
+            continue;
+        }
+
+        const bench::AttributeSpecs attributes = pointAttributes(code, options.mCodec);
+
+        const openvdb::points::PointDataGrid::Ptr uniform =
+            bench::uniformPoints(options.mPoints, attributes, 8.0, options.mSeed);
+        results.emplace_back(benchmarkPoints(snippet, code, "points_uniform", *uniform, options));
+
+        const openvdb::points::PointDataGrid::Ptr clustered =
+            bench::clusteredPoints(options.mPoints, options.mClusters, attributes, 8.0, options.mSeed);
+        results.emplace_back(benchmarkPoints(snippet, code, "points_clustered", *clustered, options));
+    }
+
+    // volumes
+
+    const bool volumes = !scaling && !options.mVolumeSnippets.empty();
+    const std::vector<openvdb::Coord> dense = !volumes ? std::vector<openvdb::Coord>() :
+        bench::volumeTopology(options.mVoxels, 1.0, options.mSeed);
+    const std::vector<openvdb::Coord> sparse = !volumes ? std::vector<openvdb::Coord>() :
+        bench::volumeTopology(options.mVoxels, options.mDensity, options.mSeed);
+
+    for (const std::string& snippet : options.mVolumeSnippets) {
+        std::string code;
+        if (!loadSnippetFile(options.mSnippetDir + "/" + snippet, code)) {
+            OPENVDB_LOG_ERROR("Unable to load snippet \"" << snippet << "\"");
+            return EXIT_FAILURE;
+        }
+
+        if (scaling) {
+            const std::vector<size_t> sizes = options.mScaleSizes.empty() ?
+                std::vector<size_t>{options.mVoxels} : options.mScaleSizes;
+            for (const size_t size : sizes) scaleVolumes(snippet, code, size, options, results);
+            continue;
+        }
+
+        results.emplace_back(benchmarkVolumes(snippet, code, "volume_dense", dense, options));
+        results.emplace_back(benchmarkVolumes(snippet, code, "volume_sparse", sparse, options));
+    }
+
+    // codegen
+
+    std::sort(options.mCodegenSizes.begin(), options.mCodegenSizes.end());
+    for (const size_t statements : options.mCodegenSizes) {
+        results.emplace_back(benchmarkCodegen(statements, options));
+    }
+
+    for (const Result& result : results) {
+        if (!result.mError.empty()) {
+            OPENVDB_LOG_WARN(result.mSnippet << " (" << result.mTarget << "): " << result.mError);
+        }
+    }
+
+    if (options.mOutputFile.empty()) {
+        writeJSON(std::cout, options, results);
+    }
+    else {
+        std::ofstream out(options.mOutputFile);
+        if (!out) {
+            OPENVDB_LOG_ERROR("Unable to open \"" << options.mOutputFile << "\" for writing");
+            return EXIT_FAILURE;
+        }
+        writeJSON(out, options, results);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
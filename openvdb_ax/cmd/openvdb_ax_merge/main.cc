@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file cmd/openvdb_ax_merge/main.cc
+///
+/// @brief  Combines the output of vdb_ax executed over the shards of a VDB file,
+///         with --shard i/n, into a single VDB file
+
+#include <openvdb_ax/compiler/Shard.h>
+
+#include <openvdb/openvdb.h>
+#include <openvdb/util/logging.h>
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* gProgName = "";
+
+void
+usage [[noreturn]] (int exitStatus = EXIT_FAILURE)
+{
+    std::cerr <<
+"Usage: " << gProgName << " output.vdb shard.vdb [shard.vdb ...] [OPTIONS]\n" <<
+"Which: merges the shards written by vdb_ax --shard i/n into output.vdb. All n shards\n" <<
+"       must be provided, in any order\n\n" <<
+"Options:\n" <<
+"    -v                verbose (print diagnostics)\n\n" <<
+"Example:\n" <<
+"    for i in 0 1 2 3; do vdb_ax in.vdb shard.$i.vdb --shard $i/4 -f snippet.ax & done; wait\n" <<
+"    " << gProgName << " out.vdb shard.0.vdb shard.1.vdb shard.2.vdb shard.3.vdb\n";
+    exit(exitStatus);
+}
+
+}
+
+int
+main(int argc, char *argv[])
+{
+    OPENVDB_START_THREADSAFE_STATIC_WRITE
+    gProgName = argv[0];
+    const char* ptr = ::strrchr(gProgName, '/');
+    if (ptr != nullptr) gProgName = ptr + 1;
+    OPENVDB_FINISH_THREADSAFE_STATIC_WRITE
+
+    openvdb::logging::initialize(argc, argv);
+    openvdb::initialize();
+
+    std::string output;
+    std::vector<std::string> inputs;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-v") {
+            verbose = true;
+        } else if (arg == "-h" || arg == "-help" || arg == "--help") {
+            usage(EXIT_SUCCESS);
+        } else if (arg[0] == '-') {
+            OPENVDB_LOG_FATAL("\"" + arg + "\" is not a valid option");
+            usage();
+        } else if (output.empty()) {
+            output = arg;
+        } else {
+            inputs.emplace_back(arg);
+        }
+    }
+
+    if (output.empty() || inputs.empty()) {
+        OPENVDB_LOG_FATAL("expected an output VDB file and at least one shard");
+        usage();
+    }
+
+    std::vector<openvdb::GridPtrVec> shards;
+    openvdb::MetaMap::Ptr meta;
+
+    for (const std::string& input : inputs) {
+        try {
+            openvdb::io::File file(input);
+            file.open();
+            shards.emplace_back(*file.getGrids());
+            if (!meta) meta = file.getMetadata();
+            file.close();
+        } catch (openvdb::Exception& e) {
+            OPENVDB_LOG_ERROR(e.what() << " (" << input << ")");
+            return EXIT_FAILURE;
+        }
+        if (verbose) std::cout << "Read " << input << std::endl;
+    }
+
+    openvdb::GridPtrVec grids;
+    try {
+        grids = openvdb::ax::mergeShards(shards);
+    } catch (openvdb::Exception& e) {
+        OPENVDB_LOG_FATAL("Merge error!");
+        OPENVDB_LOG_FATAL(e.what());
+        return EXIT_FAILURE;
+    }
+
+    if (verbose) std::cout << "Merged " << grids.size() << " grids" << std::endl;
+
+    try {
+        openvdb::io::File out(output);
+        out.write(grids, *meta);
+    } catch (openvdb::Exception& e) {
+        OPENVDB_LOG_ERROR(e.what() << " (" << output << ")");
+        return EXIT_FAILURE;
+    }
+
+    openvdb::uninitialize();
+    return EXIT_SUCCESS;
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -67,6 +67,7 @@ namespace codegen {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 const std::string ComputeGenerator::ComputeFunction::Name = "compute_local";
+const std::string ComputeGenerator::ProfileFunctionName = "ax_profile_record";
 
 ComputeGenerator::ComputeGenerator(llvm::Module& module,
                                    CustomData* customData,
@@ -86,6 +87,9 @@ ComputeGenerator::ComputeGenerator(llvm::Module& module,
     , mFunction(nullptr)
     , mCustomData(customData)
     , mOptions(options)
+    , mProfiler(nullptr)
+    , mProfileStatement(0)
+    , mProfileStart(nullptr)
     , mTargetLibInfoImpl(new llvm::TargetLibraryInfoImpl(llvm::Triple(mModule.getTargetTriple())))
     , mFunctionRegistry(functionRegistry) {}
 
@@ -110,6 +114,63 @@ void ComputeGenerator::init(const ast::Tree&)
     mBuilder.SetInsertPoint(mBlocks.top());
 }
 
+void ComputeGenerator::postVisit(const ast::Block& node, const size_t statement)
+{
+    // only instrument top level statements, which are always generated into the
+    // base block
+
+    if (!mProfiler || mBlocks.size() != 1) return;
+
+    if (!mProfileStart) {
+        // store the start cycle count at the very beginning of the function
+
+        llvm::BasicBlock& entry = mFunction->getEntryBlock();
+        llvm::IRBuilder<> builder(&entry, entry.begin());
+        mProfileStart = builder.CreateAlloca(LLVMType<int64_t>::get(mContext));
+        llvm::Function* counter =
+            llvm::Intrinsic::getDeclaration(&mModule, llvm::Intrinsic::readcyclecounter);
+        builder.CreateStore(builder.CreateCall(counter), mProfileStart);
+    }
+
+    this->recordProfile("statement " + std::to_string(statement),
+        mBuilder.CreateLoad(mProfileStart));
+
+    // restart the count after recording so that the record call itself isn't
+    // attributed to the next statement
+
+    mBuilder.CreateStore(this->readCycleCounter(), mProfileStart);
+    mProfileStatement = statement + 1;
+}
+
+llvm::Value* ComputeGenerator::readCycleCounter()
+{
+    llvm::Function* counter =
+        llvm::Intrinsic::getDeclaration(&mModule, llvm::Intrinsic::readcyclecounter);
+    return mBuilder.CreateCall(counter);
+}
+
+void ComputeGenerator::recordProfile(const std::string& label, llvm::Value* start)
+{
+    assert(mProfiler);
+
+    llvm::Value* elapsed = mBuilder.CreateSub(this->readCycleCounter(), start);
+
+    llvm::Type* int64Type = LLVMType<int64_t>::get(mContext);
+    llvm::FunctionType* recordType =
+        llvm::FunctionType::get(LLVMType<void>::get(mContext),
+            { LLVMType<void*>::get(mContext), int64Type, int64Type },
+            /*Variable args*/ false);
+
+    llvm::Constant* record = mModule.getOrInsertFunction(ProfileFunctionName, recordType);
+
+    const size_t index = mProfiler->addEntry(label);
+    mBuilder.CreateCall(record, {
+        llvmPointerFromAddress<void>(mProfiler, mBuilder),
+        llvm::ConstantInt::get(int64Type, index),
+        elapsed
+    });
+}
+
 void ComputeGenerator::visit(const ast::Block& node)
 {
     if (mBlocks.size() > 1) {
@@ -714,8 +775,12 @@ void ComputeGenerator::visit(const ast::FunctionCall& node)
         { "custom_data" , llvmPointerFromAddress<void>(mCustomData, mBuilder) }
     };
 
+    llvm::Value* start = mProfiler ? this->readCycleCounter() : nullptr;
+
     std::vector<llvm::Value*> results;
     llvm::Value* result = function->execute(arguments, globals, mBuilder, mModule, &results);
+
+    if (mProfiler) this->recordProfile(this->profileLabel(node), start);
     llvm::Type* resultType = result->getType();
 
     if (resultType != LLVMType<void>::get(mContext)) {
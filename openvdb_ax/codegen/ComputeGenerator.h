@@ -39,6 +39,7 @@
 #define OPENVDB_AX_COMPUTE_GENERATOR_HAS_BEEN_INCLUDED
 
 #include "FunctionRegistry.h"
+#include "ProfileCounters.h"
 
 #include "SymbolTable.h"
 
@@ -86,6 +87,15 @@ struct ComputeGenerator : public ast::Visitor
 
     ~ComputeGenerator() override = default;
 
+    /// @brief  The name of the external function which instrumented code calls to
+    ///         record its counters. This should be mapped to ProfileCounters::record
+    static const std::string ProfileFunctionName;
+
+    /// @brief  Instrument the generated code, recording the elapsed cycles of every
+    ///         top level statement and function call into the given counters. This
+    ///         must be set prior to code generation.
+    inline void setProfiler(ProfileCounters* profiler) { mProfiler = profiler; }
+
     inline SymbolTable& globals() { return mSymbolTables.globals(); }
     inline const SymbolTable& globals() const { return mSymbolTables.globals(); }
 
@@ -99,6 +109,7 @@ struct ComputeGenerator : public ast::Visitor
     // access
 
     void init(const ast::Tree& node) override;
+    void postVisit(const ast::Block& node, const size_t statement) override;
     void visit(const ast::AssignExpression& node) override;
     void visit(const ast::Crement& node) override;
     void visit(const ast::FunctionCall& node) override;
@@ -142,6 +153,20 @@ protected:
 
     FunctionBase::Ptr getFunction(const std::string& identifier, const FunctionOptions& op, const bool allowInternal = false);
 
+    /// @brief  Insert a read of the cycle counter at the current insert point
+    llvm::Value* readCycleCounter();
+
+    /// @brief  Insert a call which records the cycles elapsed since the given start
+    ///         cycle count into the profiler entry with the given label
+    void recordProfile(const std::string& label, llvm::Value* start);
+
+    /// @brief  The profiler entry label of a function call within the statement which
+    ///         is currently being generated
+    inline std::string profileLabel(const ast::FunctionCall& node) const
+    {
+        return "statement " + std::to_string(mProfileStatement) + ": " + node.mFunction + "()";
+    }
+
     llvm::Module& mModule;
     llvm::LLVMContext& mContext;
     llvm::IRBuilder<> mBuilder;
@@ -173,6 +198,13 @@ protected:
 
     const FunctionOptions mOptions;
 
+    // The profiler to record to if instrumenting, the index of the top level
+    // statement currently being generated and the storage of the start cycle
+    // count of the current statement
+    ProfileCounters* mProfiler;
+    size_t mProfileStatement;
+    llvm::Value* mProfileStart;
+
 private:
 
     template <typename ValueType>
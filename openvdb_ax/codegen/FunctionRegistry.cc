@@ -174,11 +174,15 @@ void insertStandardFunctions(FunctionRegistry& registry)
     registry.insert("ingroup", InGroup::create);
     registry.insert("removefromgroup", RemoveFromGroup::create);
     registry.insert("deletepoint", DeletePoint::create);
+    registry.insert("substep", Substep::create);
+    registry.insert("dt", TimeStep::create);
 
     // internal point functions
 
     registry.insert("getattribute", GetAttribute::create, true);
     registry.insert("setattribute", SetAttribute::create, true);
+    registry.insert("getattributeunsigned", GetAttributeUnsigned::create, true);
+    registry.insert("setattributeunsigned", SetAttributeUnsigned::create, true);
     // registry.insert("strattribsize", StringAttribSize::create, true);
     registry.insert("getpointpws", GetPointPWS::create, true);
     registry.insert("setpointpws", SetPointPWS::create, true);
@@ -190,6 +194,8 @@ void insertStandardFunctions(FunctionRegistry& registry)
     registry.insert("internal_addtogroup", AddToGroup::Internal::create, false);
     registry.insert("internal_ingroup", InGroup::Internal::create, false);
     registry.insert("internal_removefromgroup", RemoveFromGroup::Internal::create, false);
+    registry.insert("internal_substep", Substep::Internal::create, false);
+    registry.insert("internal_dt", TimeStep::Internal::create, false);
     registry.insert("internal_lookupf", LookupFloat::Internal::create, false);
     registry.insert("internal_lookupvec3f", LookupVec3f::Internal::create, false);
 
@@ -197,10 +203,17 @@ void insertStandardFunctions(FunctionRegistry& registry)
 
     registry.insert("getvoxel", GetVoxel::create, true);
     registry.insert("setvoxel", SetVoxel::create, true);
+    registry.insert("getvoxelunsigned", GetVoxelUnsigned::create, true);
+    registry.insert("setvoxelunsigned", SetVoxelUnsigned::create, true);
     registry.insert("getcoordx", GetCoordX::create);
     registry.insert("getcoordy", GetCoordY::create);
     registry.insert("getcoordz", GetCoordZ::create);
     registry.insert("getvoxelpws", GetVoxelPWS::create);
+    registry.insert("scatter", ScatterSet::create);
+    registry.insert("scatteradd", ScatterAdd::create);
+    registry.insert("scattermax", ScatterMax::create);
+    registry.insert("scattermin", ScatterMin::create);
+    registry.insert("internal_scatter", ScatterInternal::create, false);
 }
 
 } // anonymous namespace
@@ -37,6 +37,9 @@
 #include <openvdb/points/PointAttribute.h>
 #include <openvdb/points/PointDataGrid.h>
 #include <openvdb/points/PointGroup.h>
+#include <openvdb/math/Transform.h>
+
+#include <algorithm>
 
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
@@ -46,6 +49,70 @@ namespace ax {
 namespace codegen {
 
 
+/// @brief  Converts point positions between index and world space. Linear transforms
+///         are reduced to a scale and offset, or to an affine matrix, once per grid so
+///         that the per point conversion is inlined rather than dispatched through the
+///         virtual map of the transform. Any other transform falls back to the map.
+///
+struct PositionTransform
+{
+    enum Mode { SCALE_TRANSLATE, AFFINE, MAP };
+
+    PositionTransform(const openvdb::math::Transform& transform)
+        : mTransform(transform)
+        , mMode(MAP)
+        , mScale(1.0)
+        , mTranslation(0.0)
+        , mMatrix(openvdb::math::Mat4d::identity())
+        , mInverse(openvdb::math::Mat4d::identity())
+    {
+        if (!transform.isLinear()) return;
+
+        mTranslation = transform.indexToWorld(openvdb::Vec3d(0.0));
+        if (transform.baseMap()->isDiagonal()) {
+            mScale = transform.indexToWorld(openvdb::Vec3d(1.0)) - mTranslation;
+            mMode = SCALE_TRANSLATE;
+        }
+        else {
+            mMatrix = transform.baseMap()->getAffineMap()->getMat4();
+            mInverse = mMatrix.inverse();
+            mMode = AFFINE;
+        }
+    }
+
+    /// @brief  Returns the world space position of an index space position
+    ///
+    /// @param  position  The index space position, i.e. the voxel coordinate
+    ///                   plus the voxel local offset of a point
+    ///
+    inline openvdb::Vec3d indexToWorld(const openvdb::Vec3d& position) const
+    {
+        if (mMode == SCALE_TRANSLATE) return position * mScale + mTranslation;
+        if (mMode == AFFINE) return mMatrix.transform(position);
+        return mTransform.indexToWorld(position);
+    }
+
+    /// @brief  Returns the index space position of a world space position
+    ///
+    /// @param  position  The world space position
+    ///
+    inline openvdb::Vec3d worldToIndex(const openvdb::Vec3d& position) const
+    {
+        if (mMode == SCALE_TRANSLATE) return (position - mTranslation) / mScale;
+        if (mMode == AFFINE) return mInverse.transform(position);
+        return mTransform.worldToIndex(position);
+    }
+
+private:
+    const openvdb::math::Transform& mTransform;
+    Mode mMode;
+    openvdb::Vec3d mScale;
+    openvdb::Vec3d mTranslation;
+    openvdb::math::Mat4d mMatrix;
+    openvdb::math::Mat4d mInverse;
+};
+
+
 /// @brief  Various functions can request the use and initialization of point data from within
 ///         the kernel that does not use the standard attribute handle methods. This data can
 ///         then be accessed after execution to perform post-processes such as adding new groups,
@@ -69,6 +136,7 @@ struct LeafLocalData
 
     using PositionT = openvdb::Vec3f;
     using PositionVector = std::vector<PositionT>;
+    using GroupIndex = openvdb::points::AttributeSet::Descriptor::GroupIndex;
 
     using LeafNode = openvdb::points::PointDataTree::LeafNodeType;
 
@@ -84,7 +152,12 @@ struct LeafLocalData
         , mOffset(0)
         , mHandles()
         , mStringMap()
-        , mPositions() {}
+        , mPositions()
+        , mPositionIndices()
+        , mSparsePositions(false)
+        , mPositionCursor(0)
+        , mSubstep(0)
+        , mTimeStep(1.0f) {}
 
     ////////////////////////////////////////////////////////////////////////
 
@@ -233,69 +306,167 @@ struct LeafLocalData
 
     /// Position methods
 
-    /// @brief Initialises the position vector for the all of the points in the leaf
-    ///        that are included in the filter, other points have values of zero initialised
-
-    /// @tparam FilterT    The filter type of the filter argument
+    /// @brief Initialises the world space position of every point in the leaf
+    ///
     /// @param  leaf       The leaf node whose positions to cache
-    /// @param  transform  The world-space transform of the grid
-    /// @param  filter     A filter on the leaf to determine which points we need positions for
-
-    template<typename FilterT = openvdb::points::NullFilter>
-    inline void initPositions(const LeafNode& leaf, const openvdb::math::Transform& transform,
-                              FilterT filter = FilterT()) {
-
-        mPositions.reserve(mPointCount);
+    /// @param  transform  The index to world space conversion of the grid
+    ///
+    inline void initPositions(const LeafNode& leaf, const PositionTransform& transform)
+    {
+        mSparsePositions = false;
+        mPositions.resize(mPointCount);
 
-        const openvdb::points::AttributeSet& attributeSet = leaf.attributeSet();
-        const size_t pos = attributeSet.find("P");
-        assert(pos != openvdb::points::AttributeSet::INVALID_POS);
+        const openvdb::points::AttributeHandle<openvdb::Vec3f>::Ptr position = positionHandle(leaf);
 
-        const openvdb::points::AttributeHandle<openvdb::Vec3f>::Ptr
-            position = openvdb::points::AttributeHandle<openvdb::Vec3f>::create(leaf.constAttributeArray(pos));
+        // the points of each voxel are a contiguous range of indices
 
-        filter.reset(leaf);
+        Index start = 0;
+        for (Index n = 0; n < LeafNode::SIZE; ++n) {
+            const Index end = leaf.getValue(n);
+            if (start == end) continue;
+            const openvdb::Vec3d coord = leaf.offsetToGlobalCoord(n).asVec3d();
+            for (Index i = start; i < end; ++i) {
+                mPositions[i] = transform.indexToWorld(coord + position->get(i));
+            }
+            start = end;
+        }
+    }
 
-        for (auto voxel = leaf.cbeginValueAll(); voxel; ++voxel) {
-            const openvdb::Coord& coord = voxel.getCoord();
-            auto iter = leaf.beginIndexVoxel(coord);
-            for (; iter; ++iter) {
-                if (filter.valid(iter)) {
-                    mPositions.emplace_back(transform.indexToWorld(coord.asVec3d() + position->get(*(iter))));
-                }
-                else mPositions.emplace_back(PositionT::zero());
+    /// @brief Initialises the world space position of only the points in the leaf which
+    ///        are members of a group. The positions are stored sparsely, ordered by
+    ///        point index, so that the memory used is proportional to the group size.
+    ///
+    /// @param  leaf       The leaf node whose positions to cache
+    /// @param  transform  The index to world space conversion of the grid
+    /// @param  groupIndex The index of the group whose points to cache
+    ///
+    inline void initPositions(const LeafNode& leaf, const PositionTransform& transform,
+                              const GroupIndex& groupIndex)
+    {
+        mSparsePositions = true;
+        mPositionCursor = 0;
+
+        const openvdb::points::AttributeHandle<openvdb::Vec3f>::Ptr position = positionHandle(leaf);
+        const openvdb::points::GroupHandle group = leaf.groupHandle(groupIndex);
+
+        Index start = 0;
+        for (Index n = 0; n < LeafNode::SIZE; ++n) {
+            const Index end = leaf.getValue(n);
+            if (start == end) continue;
+            const openvdb::Vec3d coord = leaf.offsetToGlobalCoord(n).asVec3d();
+            for (Index i = start; i < end; ++i) {
+                if (!group.get(i)) continue;
+                mPositionIndices.emplace_back(i);
+                mPositions.emplace_back(transform.indexToWorld(coord + position->get(i)));
             }
+            start = end;
         }
     }
 
-    /// @brief  Updates the position value in the the position vector
+    /// @brief  Updates the position of a point. Does nothing if the position of the
+    ///         point is not cached
     ///
     /// @param  pos   The position to be assigned
-    /// @param  index The index of the element the vector to assign to
+    /// @param  index The index of the point
     ///
 
     inline void setPosition(const PositionT& pos, const size_t index) {
-        mPositions[index] = pos;
+        const size_t slot = this->positionSlot(index);
+        if (slot < mPositions.size()) mPositions[slot] = pos;
     }
 
-    /// @brief  Returns a const reference to the position vector
+    /// @brief  Returns true if the position of a point is cached
     ///
-    /// @note   The position vector must have been initialised
+    /// @param  index The index of the point
     ///
+    inline bool hasPosition(const size_t index) const {
+        return this->positionSlot(index) < mPositions.size();
+    }
+
+    /// @brief  Returns the position of a point, or zero if the position of the point
+    ///         is not cached
+    ///
+    /// @param  index The index of the point
+    ///
+    /// @note   The positions must have been initialised
+    ///
+
+    inline const PositionT& getPosition(const size_t index) const {
+        static const PositionT zero = PositionT::zero();
+        const size_t slot = this->positionSlot(index);
+        return slot < mPositions.size() ? mPositions[slot] : zero;
+    }
+
+
+
+    ////////////////////////////////////////////////////////////////////////
 
-    inline const PositionVector& getPositions() const {
-        return mPositions;
+    /// Substep methods
+
+    /// @brief  Sets the substep being executed and the time step of each substep
+    ///
+    /// @param  substep  The index of the substep
+    /// @param  dt       The time step of each substep
+    ///
+    inline void setSubstep(const int32_t substep, const float dt) {
+        mSubstep = substep;
+        mTimeStep = dt;
     }
 
+    /// @brief  Returns the index of the substep being executed
+    ///
+    inline int32_t substep() const { return mSubstep; }
+
+    /// @brief  Returns the time step of each substep
+    ///
+    inline float timeStep() const { return mTimeStep; }
+
 
 private:
 
+    inline static openvdb::points::AttributeHandle<openvdb::Vec3f>::Ptr
+    positionHandle(const LeafNode& leaf)
+    {
+        const openvdb::points::AttributeSet& attributeSet = leaf.attributeSet();
+        const size_t pos = attributeSet.find("P");
+        assert(pos != openvdb::points::AttributeSet::INVALID_POS);
+        return openvdb::points::AttributeHandle<openvdb::Vec3f>::create(leaf.constAttributeArray(pos));
+    }
+
+    /// @brief  Returns the index into the position vector of a point, or an index past
+    ///         the end if it is not cached. Points are usually accessed in ascending
+    ///         order, so the slots after the last access are checked before searching.
+    inline size_t positionSlot(const size_t index) const
+    {
+        if (!mSparsePositions) return index;
+
+        const size_t size = mPositionIndices.size();
+        if (mPositionCursor < size && mPositionIndices[mPositionCursor] == index) {
+            return mPositionCursor;
+        }
+        if (mPositionCursor + 1 < size && mPositionIndices[mPositionCursor + 1] == index) {
+            return ++mPositionCursor;
+        }
+
+        const auto iter = std::lower_bound(mPositionIndices.begin(), mPositionIndices.end(), index);
+        if (iter == mPositionIndices.end() || *iter != index) return mPositions.size();
+        mPositionCursor = size_t(iter - mPositionIndices.begin());
+        return mPositionCursor;
+    }
+
+
     const size_t mPointCount;
     std::vector<std::unique_ptr<GroupArrayT>> mArrays;
     points::GroupType mOffset;
     std::map<std::string, std::unique_ptr<GroupHandleT>> mHandles;
     StringArrayMap mStringMap;
     PositionVector mPositions;
+    // the point indices of the cached positions, if only a group of points is cached
+    std::vector<Index> mPositionIndices;
+    bool mSparsePositions;
+    mutable size_t mPositionCursor;
+    int32_t mSubstep;
+    float mTimeStep;
 };
 
 }
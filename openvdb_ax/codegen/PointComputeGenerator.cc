@@ -261,7 +261,7 @@ void PointComputeGenerator::visit(const ast::AssignExpression& node)
     const bool lhsIsString = type == "string";
 
     llvm::Type* rhsType = rhs->getType()->getContainedType(0);
-    llvm::Type* lhsType = llvmTypeFromName(type, mContext);
+    llvm::Type* lhsType = llvmTypeFromName(computeTypeName(type), mContext);
 
     // convert rhs to match lhs for all supported assignments:
     // (scalar=scalar, vector=vector, scalar=vector, vector=scalar etc)
@@ -324,6 +324,14 @@ void PointComputeGenerator::visit(const ast::AssignExpression& node)
         }
     }
 
+    // values of storage types are converted to the attribute type and passed by pointer
+
+    if (isStorageType(type)) {
+        llvm::Value* storage = mBuilder.CreateAlloca(llvmTypeFromName(type, mContext));
+        mBuilder.CreateStore(computeToStorage(rhs, type, mBuilder), storage);
+        rhs = storage;
+    }
+
     // construct function arguments
     std::vector<llvm::Value*> argumentValues;
     argumentValues.reserve(lhsIsString ? 4 : 3);
@@ -342,7 +350,8 @@ void PointComputeGenerator::visit(const ast::AssignExpression& node)
         function->execute(argumentValues, mLLVMArguments.map(), mBuilder, mModule);
     }
     else {
-        const FunctionBase::Ptr function = this->getFunction("setattribute", mOptions, true);
+        const FunctionBase::Ptr function = this->getFunction(isUnsignedType(type) ?
+            "setattributeunsigned" : "setattribute", mOptions, true);
         function->execute(argumentValues, mLLVMArguments.map(), mBuilder, mModule);
     }
 }
@@ -394,13 +403,23 @@ void PointComputeGenerator::visit(const ast::Crement& node)
     }
 
     assert(node.mVariable);
+    const std::string& attributeType =
+        static_cast<const ast::Attribute* const>(node.mVariable.get())->mType;
+
+    // values of storage types are converted to the attribute type and passed by pointer
+
+    llvm::Value* value = rhs;
+    if (isStorageType(attributeType)) {
+        value = mBuilder.CreateAlloca(llvmTypeFromName(attributeType, mContext));
+        mBuilder.CreateStore(computeToStorage(rhs, attributeType, mBuilder), value);
+    }
 
     std::vector<llvm::Value*> argumentValues;
     argumentValues.reserve(3);
 
     argumentValues.emplace_back(lhs);
     argumentValues.emplace_back(mLLVMArguments.get("point_index"));
-    argumentValues.emplace_back(rhs);
+    argumentValues.emplace_back(value);
 
     // @TODO: if supporting vector crement, reenable this
     // const ast::Attribute* const attribute =
@@ -410,7 +429,8 @@ void PointComputeGenerator::visit(const ast::Crement& node)
     //     const FunctionBase::Ptr function = getFunctionFromRegistry("__setpointpws", mOptions);
     //     function->execute(argumentValues, mLLVMArguments.map(), mBuilder, mModule);
     // } else {
-    const FunctionBase::Ptr function = this->getFunction("setattribute", mOptions, true);
+    const FunctionBase::Ptr function = this->getFunction(isUnsignedType(attributeType) ?
+        "setattributeunsigned" : "setattribute", mOptions, true);
     function->execute(argumentValues, mLLVMArguments.map(), mBuilder, mModule);
 
     // decide what to put on the expression stack
@@ -452,8 +472,12 @@ void PointComputeGenerator::visit(const ast::FunctionCall& node)
     argumentsFromStack(mValues, args, arguments);
     parseDefaultArgumentState(arguments, mBuilder);
 
+    llvm::Value* start = mProfiler ? this->readCycleCounter() : nullptr;
+
     std::vector<llvm::Value*> results;
     llvm::Value* result = function->execute(arguments, mLLVMArguments.map(), mBuilder, mModule, &results);
+
+    if (mProfiler) this->recordProfile(this->profileLabel(node), start);
     llvm::Type* resultType = result->getType();
 
     if (resultType != LLVMType<void>::get(mContext)) {
@@ -566,10 +590,19 @@ void PointComputeGenerator::visit(const ast::AttributeValue& node)
         function->execute(args, mLLVMArguments.map(), mBuilder, mModule, nullptr, /*add output args*/false);
     }
     else {
-        const FunctionBase::Ptr function = this->getFunction("getattribute", mOptions, true);
+        const FunctionBase::Ptr function = this->getFunction(isUnsignedType(type) ?
+            "getattributeunsigned" : "getattribute", mOptions, true);
         function->execute(args, mLLVMArguments.map(), mBuilder, mModule, nullptr, /*add output args*/false);
     }
 
+    // values of storage types are computed as a wider type, see computeTypeName
+
+    if (isStorageType(type)) {
+        llvm::Value* value = storageToCompute(mBuilder.CreateLoad(returnValue), type, mBuilder);
+        returnValue = mBuilder.CreateAlloca(value->getType());
+        mBuilder.CreateStore(value, returnValue);
+    }
+
     mValues.push(returnValue);
 }
 
@@ -184,6 +184,20 @@ bool InGroup::Internal::in_group(const uint8_t* const name,
 //     }
 // }
 
+int32_t Substep::Internal::substep(const void* const leafDataPtr)
+{
+    const openvdb::ax::codegen::LeafLocalData* const leafData =
+        static_cast<const openvdb::ax::codegen::LeafLocalData* const>(leafDataPtr);
+    return leafData->substep();
+}
+
+float TimeStep::Internal::dt(const void* const leafDataPtr)
+{
+    const openvdb::ax::codegen::LeafLocalData* const leafData =
+        static_cast<const openvdb::ax::codegen::LeafLocalData* const>(leafDataPtr);
+    return leafData->timeStep();
+}
+
 void SetPointPWS::set_point_pws(void* leafDataPtr,
                                 const uint64_t index,
                                 openvdb::Vec3s* value)
@@ -228,7 +242,7 @@ void GetPointPWS::get_point_pws(void* leafDataPtr,
     assert(index >= 0);
     openvdb::ax::codegen::LeafLocalData* leafData =
         static_cast<openvdb::ax::codegen::LeafLocalData*>(leafDataPtr);
-   (*value) = leafData->getPositions()[index];
+   (*value) = leafData->getPosition(index);
 }
 
 
@@ -255,6 +255,90 @@ struct DeletePoint : public FunctionBase
     }
 };
 
+struct Substep : public FunctionBase
+{
+    struct Internal : public FunctionBase {
+        DEFINE_IDENTIFIER_CONTEXT_DOC("internal_substep", FunctionBase::Point,
+            "Internal function for querying the current substep")
+        inline static Ptr create(const FunctionOptions&) { return Ptr(new Internal()); }
+        Internal() : FunctionBase({
+            DECLARE_FUNCTION_SIGNATURE(substep)
+        }) {}
+
+    private:
+        static int32_t substep(const void* const leafDataPtr);
+    };
+
+    DEFINE_IDENTIFIER_CONTEXT_DOC("substep", FunctionBase::Point,
+        "Returns the index of the substep being executed, starting from 0. This is always 0 "
+        "unless the points are executed with multiple substeps.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new Substep()); }
+
+    Substep() : FunctionBase({
+        FunctionSignature<int()>::create(nullptr, std::string("substep"), 0)
+    }) {}
+
+    inline void getDependencies(std::vector<std::string>& identifiers) const override {
+        identifiers.emplace_back("internal_substep");
+    }
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final {
+
+        std::vector<llvm::Value*> internalArgs(args);
+        internalArgs.emplace_back(globals.at("leaf_data"));
+
+        Internal func;
+        return func.execute(internalArgs, globals, builder, M);
+    }
+};
+
+struct TimeStep : public FunctionBase
+{
+    struct Internal : public FunctionBase {
+        DEFINE_IDENTIFIER_CONTEXT_DOC("internal_dt", FunctionBase::Point,
+            "Internal function for querying the substep time step")
+        inline static Ptr create(const FunctionOptions&) { return Ptr(new Internal()); }
+        Internal() : FunctionBase({
+            DECLARE_FUNCTION_SIGNATURE(dt)
+        }) {}
+
+    private:
+        static float dt(const void* const leafDataPtr);
+    };
+
+    DEFINE_IDENTIFIER_CONTEXT_DOC("dt", FunctionBase::Point,
+        "Returns the time step of each substep being executed. This is 1.0f unless the points "
+        "are executed with multiple substeps.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new TimeStep()); }
+
+    TimeStep() : FunctionBase({
+        FunctionSignature<float()>::create(nullptr, std::string("dt"), 0)
+    }) {}
+
+    inline void getDependencies(std::vector<std::string>& identifiers) const override {
+        identifiers.emplace_back("internal_dt");
+    }
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>& args,
+         const std::unordered_map<std::string, llvm::Value*>& globals,
+         llvm::IRBuilder<>& builder,
+         llvm::Module& M) const override final {
+
+        std::vector<llvm::Value*> internalArgs(args);
+        internalArgs.emplace_back(globals.at("leaf_data"));
+
+        Internal func;
+        return func.execute(internalArgs, globals, builder, M);
+    }
+};
+
 struct SetAttribute : public FunctionBase
 {
     DEFINE_IDENTIFIER_CONTEXT_DOC("setattribute", FunctionBase::Point,
@@ -274,10 +358,14 @@ struct SetAttribute : public FunctionBase
         DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Vec3d>),
         DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Vec3f>),
         DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<openvdb::Vec3i>),
+        // storage types pass by ptr
+        DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<half>),
+        DECLARE_FUNCTION_SIGNATURE(set_attribute_ptr<int8_t>),
         // DECLARE_FUNCTION_SIGNATURE(set_attribute_string),
     }) {}
 
 private:
+    friend struct SetAttributeUnsigned;
 
     template <typename ValueT>
     inline static void set_attribute_ptr(void* attributeHandle, const uint64_t index, const ValueT* value)
@@ -359,10 +447,13 @@ struct GetAttribute : public FunctionBase
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Vec3d>, 1),
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Vec3f>, 1),
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<openvdb::Vec3i>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<half>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute<int8_t>, 1),
         // DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_attribute_string, 1)
     }) {}
 
 private:
+    friend struct GetAttributeUnsigned;
     template <typename ValueT>
     inline static void get_attribute(void* attributeHandle, const uint64_t index, ValueT* value)
     {
@@ -385,6 +476,33 @@ private:
                                      const void* const newDataPtr);
 };
 
+/// @brief  uint8 and int8 attributes have the same llvm type, so the values of uint8
+///         attributes are set and retrieved through their own functions
+///
+struct SetAttributeUnsigned : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("setattributeunsigned", FunctionBase::Point,
+        "Internal function for setting the value of an unsigned point attribute.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new SetAttributeUnsigned()); }
+
+    SetAttributeUnsigned() : FunctionBase({
+        DECLARE_FUNCTION_SIGNATURE(SetAttribute::set_attribute_ptr<uint8_t>)
+    }) {}
+};
+
+struct GetAttributeUnsigned : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("getattributeunsigned", FunctionBase::Point,
+        "Internal function for getting the value of an unsigned point attribute.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new GetAttributeUnsigned()); }
+
+    GetAttributeUnsigned() : FunctionBase({
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(GetAttribute::get_attribute<uint8_t>, 1)
+    }) {}
+};
+
 struct GetPointPWS : public FunctionBase
 {
     DEFINE_IDENTIFIER_CONTEXT_DOC("getpointpws", FunctionBase::Point,
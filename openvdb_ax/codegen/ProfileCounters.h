@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file codegen/ProfileCounters.h
+///
+/// @brief Contains the ProfileCounters class which holds the counters that
+///        instrumented code records into
+///
+
+#ifndef OPENVDB_AX_CODEGEN_PROFILE_COUNTERS_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_CODEGEN_PROFILE_COUNTERS_HAS_BEEN_INCLUDED
+
+#include <openvdb/Types.h>
+
+#include <tbb/enumerable_thread_specific.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+namespace codegen {
+
+/// @brief  A list of labelled entries, each representing an instrumented region of
+///         generated code, such as a top level statement or a function call.
+///         Instrumented code calls ProfileCounters::record with the index of an entry
+///         and the elapsed cycles of the region. Counters are held per thread.
+/// @note   Entries are added during code generation and must not be added once the
+///         instrumented code is executing.
+class ProfileCounters
+{
+public:
+
+    // invocation count and cycle count
+    using Counter = std::pair<uint64_t, uint64_t>;
+
+    ProfileCounters()
+        : mLabels()
+        , mIndices()
+        , mCounters() {}
+
+    ~ProfileCounters() = default;
+
+    /// @brief  Add an entry with the given label, returning its index. If an entry
+    ///         already exists with the label, its index is returned
+    /// @param  label  A description of the instrumented region
+    inline size_t addEntry(const std::string& label)
+    {
+        const auto iter = mIndices.find(label);
+        if (iter != mIndices.end()) return iter->second;
+        mLabels.emplace_back(label);
+        mIndices[label] = mLabels.size() - 1;
+        return mLabels.size() - 1;
+    }
+
+    /// @brief  Returns the number of entries
+    inline size_t size() const { return mLabels.size(); }
+
+    /// @brief  Accumulate a single invocation of an instrumented region into the
+    ///         counters of the calling thread. This is called from generated code.
+    /// @param  counters  The ProfileCounters object
+    /// @param  index     The index of the entry
+    /// @param  cycles    The elapsed cycles of the invocation
+    static void record(void* counters, const int64_t index, const int64_t cycles)
+    {
+        ProfileCounters* const self = static_cast<ProfileCounters*>(counters);
+        std::vector<Counter>& local = self->mCounters.local();
+        if (local.size() <= size_t(index)) local.resize(self->mLabels.size());
+        Counter& counter = local[index];
+        ++counter.first;
+        counter.second += cycles;
+    }
+
+    /// @brief  Reset all counters, keeping the entries
+    inline void clear() { mCounters.clear(); }
+
+protected:
+    std::vector<std::string> mLabels;
+    std::unordered_map<std::string, size_t> mIndices;
+    tbb::enumerable_thread_specific<std::vector<Counter>> mCounters;
+};
+
+}
+}
+}
+}
+
+#endif // OPENVDB_AX_CODEGEN_PROFILE_COUNTERS_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file codegen/ScatterData.h
+///
+/// @brief  Thread local storage of the values which volume kernels scatter into
+///         grids at arbitrary world space positions
+///
+
+#ifndef OPENVDB_AX_CODEGEN_SCATTER_DATA_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_CODEGEN_SCATTER_DATA_HAS_BEEN_INCLUDED
+
+#include <openvdb/openvdb.h>
+#include <openvdb/Exceptions.h>
+#include <openvdb/math/Transform.h>
+#include <openvdb/math/Vec3.h>
+#include <openvdb/tree/ValueAccessor.h>
+
+#include <tbb/enumerable_thread_specific.h>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+namespace codegen {
+
+/// @brief  The values scattered by a volume kernel into any of the grids it is executed
+///         with. The grid being iterated is shared by every thread, so a kernel never
+///         writes a scattered value into a grid directly. Each thread instead writes into
+///         its own sparse tree per grid and combine operation, which are merged into the
+///         grids once every leaf has been executed.
+///
+struct ScatterData
+{
+    /// @brief  How a scattered value is combined with the value already held by an
+    ///         active voxel. A voxel which is not active is always set to the value.
+    /// @note   The order in which the trees of different threads are merged is not
+    ///         defined, so OVERWRITE is only deterministic if every scatter into a voxel
+    ///         writes the same value
+    enum Combine { OVERWRITE = 0, ADD, MAX, MIN, N_COMBINE };
+
+    /// @brief  The values scattered into a single grid with a single combine operation
+    ///         by a single thread
+    struct Target
+    {
+        using Ptr = std::unique_ptr<Target>;
+        virtual ~Target() = default;
+
+        virtual void scatter(const Vec3d& position, const double value) = 0;
+        virtual void scatter(const Vec3d& position, const Vec3d& value) = 0;
+
+        /// @brief  Combines every scattered value into the given grid, which is expected
+        ///         to be the grid this target was created for
+        virtual void merge(GridBase& grid) const = 0;
+    };
+
+    ScatterData(const GridPtrVec& grids)
+        : mGrids(grids)
+        , mIndices()
+        , mTargets()
+        , mInvalid()
+    {
+        // the first grid of a given name receives the values, matching the grid
+        // which is bound to an @ access of the same name
+        for (size_t i = 0; i < mGrids.size(); ++i) {
+            mIndices.emplace(mGrids[i]->getName(), i);
+        }
+    }
+
+    /// @brief  Scatters a value into the grid of the given name at a world space position.
+    ///         Scalar values are converted to the value type of the grid, and broadcast to
+    ///         every component of a vector grid. Vector values are ignored by scalar grids.
+    ///         Scatters into grids which do not exist or have an unsupported type are
+    ///         recorded, and reported by merge().
+    template <typename ValueT>
+    inline void scatter(const std::string& name,
+                        const Vec3d& position,
+                        const ValueT& value,
+                        const Combine combine)
+    {
+        if (combine < OVERWRITE || combine >= N_COMBINE) return;
+        Target* target = this->target(name, combine);
+        if (target) target->scatter(position, value);
+    }
+
+    /// @brief  Merges the values scattered by every thread into their grids and clears
+    ///         them. Combine operations are merged in the order of their enum values.
+    ///         Returns true if any value was scattered.
+    /// @throw  LookupError if a value was scattered into a grid which does not exist, or
+    ///         TypeError if the grid has a type which values can not be scattered into.
+    ///         No value is merged in either case.
+    inline bool merge()
+    {
+        std::set<std::string> invalid;
+        for (const std::set<std::string>& names : mInvalid) {
+            invalid.insert(names.cbegin(), names.cend());
+        }
+
+        if (!invalid.empty()) {
+            mTargets.clear();
+            mInvalid.clear();
+            const std::string& name = *invalid.cbegin();
+            const auto iter = mIndices.find(name);
+            if (iter == mIndices.cend()) {
+                OPENVDB_THROW(LookupError, "Missing grid \"" + name + "\" for scatter.");
+            }
+            OPENVDB_THROW(TypeError, "Unable to scatter into grid \"" + name +
+                "\" as it has an unsupported type \"" + mGrids[iter->second]->valueType() + "\".");
+        }
+
+        if (mTargets.empty()) return false;
+
+        for (size_t combine = 0; combine < N_COMBINE; ++combine) {
+            for (const std::vector<Target::Ptr>& targets : mTargets) {
+                for (size_t i = 0; i < mGrids.size(); ++i) {
+                    const Target::Ptr& target = targets[i * N_COMBINE + combine];
+                    if (target) target->merge(*mGrids[i]);
+                }
+            }
+        }
+
+        mTargets.clear();
+        return true;
+    }
+
+private:
+
+    inline Target* target(const std::string& name, const Combine combine)
+    {
+        const auto iter = mIndices.find(name);
+        if (iter == mIndices.cend()) {
+            mInvalid.local().insert(name);
+            return nullptr;
+        }
+
+        std::vector<Target::Ptr>& targets = mTargets.local();
+        if (targets.empty()) targets.resize(mGrids.size() * N_COMBINE);
+
+        Target::Ptr& target = targets[iter->second * N_COMBINE + combine];
+        if (!target) target = createTarget(*mGrids[iter->second], combine);
+        if (!target) mInvalid.local().insert(name);
+        return target.get();
+    }
+
+    template <typename ValueT>
+    static inline typename std::enable_if<!VecTraits<ValueT>::IsVec, bool>::type
+    convert(const double value, ValueT& result) {
+        result = static_cast<ValueT>(value);
+        return true;
+    }
+
+    template <typename ValueT>
+    static inline typename std::enable_if<VecTraits<ValueT>::IsVec, bool>::type
+    convert(const double value, ValueT& result) {
+        result = ValueT(static_cast<typename VecTraits<ValueT>::ElementType>(value));
+        return true;
+    }
+
+    template <typename ValueT>
+    static inline typename std::enable_if<!VecTraits<ValueT>::IsVec, bool>::type
+    convert(const Vec3d&, ValueT&) { return false; }
+
+    template <typename ValueT>
+    static inline typename std::enable_if<VecTraits<ValueT>::IsVec, bool>::type
+    convert(const Vec3d& value, ValueT& result) {
+        using ElementT = typename VecTraits<ValueT>::ElementType;
+        result = ValueT(static_cast<ElementT>(value.x()),
+                        static_cast<ElementT>(value.y()),
+                        static_cast<ElementT>(value.z()));
+        return true;
+    }
+
+    template <typename ValueT>
+    static inline typename std::enable_if<!VecTraits<ValueT>::IsVec, ValueT>::type
+    maximum(const ValueT& a, const ValueT& b) { return std::max(a, b); }
+
+    template <typename ValueT>
+    static inline typename std::enable_if<VecTraits<ValueT>::IsVec, ValueT>::type
+    maximum(const ValueT& a, const ValueT& b) { return math::maxComponent(a, b); }
+
+    template <typename ValueT>
+    static inline typename std::enable_if<!VecTraits<ValueT>::IsVec, ValueT>::type
+    minimum(const ValueT& a, const ValueT& b) { return std::min(a, b); }
+
+    template <typename ValueT>
+    static inline typename std::enable_if<VecTraits<ValueT>::IsVec, ValueT>::type
+    minimum(const ValueT& a, const ValueT& b) { return math::minComponent(a, b); }
+
+    template <typename AccessorT, typename ValueT>
+    static inline void
+    combineValue(AccessorT& accessor, const Coord& ijk, const ValueT& value, const Combine combine)
+    {
+        ValueT current;
+        if (combine == OVERWRITE || !accessor.probeValue(ijk, current)) {
+            accessor.setValueOn(ijk, value);
+            return;
+        }
+
+        if (combine == ADD)      accessor.setValueOn(ijk, static_cast<ValueT>(current + value));
+        else if (combine == MAX) accessor.setValueOn(ijk, maximum(current, value));
+        else if (combine == MIN) accessor.setValueOn(ijk, minimum(current, value));
+    }
+
+    template <typename GridT>
+    struct TypedTarget : public Target
+    {
+        using TreeT = typename GridT::TreeType;
+        using ValueT = typename TreeT::ValueType;
+
+        TypedTarget(const math::Transform& transform, const Combine combine)
+            : mTransform(transform)
+            , mCombine(combine)
+            , mTree(zeroVal<ValueT>())
+            , mAccessor(mTree) {}
+
+        void scatter(const Vec3d& position, const double value) override {
+            this->scatterValue(position, value);
+        }
+
+        void scatter(const Vec3d& position, const Vec3d& value) override {
+            this->scatterValue(position, value);
+        }
+
+        void merge(GridBase& grid) const override
+        {
+            assert(grid.isType<GridT>());
+            typename GridT::Accessor accessor = static_cast<GridT&>(grid).getAccessor();
+            for (auto iter = mTree.cbeginValueOn(); iter; ++iter) {
+                combineValue(accessor, iter.getCoord(), *iter, mCombine);
+            }
+        }
+
+    private:
+        template <typename InputT>
+        inline void scatterValue(const Vec3d& position, const InputT& input)
+        {
+            ValueT value;
+            if (!convert(input, value)) return;
+            const Coord ijk = mTransform.worldToIndexCellCentered(position);
+            combineValue(mAccessor, ijk, value, mCombine);
+        }
+
+        const math::Transform& mTransform;
+        const Combine mCombine;
+        TreeT mTree;
+        tree::ValueAccessor<TreeT> mAccessor;
+    };
+
+    template <typename GridT>
+    static inline Target::Ptr createTargetTyped(const GridBase& grid, const Combine combine) {
+        return Target::Ptr(new TypedTarget<GridT>(grid.transform(), combine));
+    }
+
+    static inline Target::Ptr createTarget(const GridBase& grid, const Combine combine)
+    {
+        // grids of the compact storage types, which have no openvdb grid type definitions
+        using HalfGrid = BoolGrid::ValueConverter<half>::Type;
+        using Int8Grid = BoolGrid::ValueConverter<int8_t>::Type;
+        using UInt8Grid = BoolGrid::ValueConverter<uint8_t>::Type;
+
+        if (grid.isType<BoolGrid>())        return createTargetTyped<BoolGrid>(grid, combine);
+        else if (grid.isType<Int8Grid>())   return createTargetTyped<Int8Grid>(grid, combine);
+        else if (grid.isType<UInt8Grid>())  return createTargetTyped<UInt8Grid>(grid, combine);
+        else if (grid.isType<Int32Grid>())  return createTargetTyped<Int32Grid>(grid, combine);
+        else if (grid.isType<Int64Grid>())  return createTargetTyped<Int64Grid>(grid, combine);
+        else if (grid.isType<HalfGrid>())   return createTargetTyped<HalfGrid>(grid, combine);
+        else if (grid.isType<FloatGrid>())  return createTargetTyped<FloatGrid>(grid, combine);
+        else if (grid.isType<DoubleGrid>()) return createTargetTyped<DoubleGrid>(grid, combine);
+        else if (grid.isType<Vec3IGrid>())  return createTargetTyped<Vec3IGrid>(grid, combine);
+        else if (grid.isType<Vec3fGrid>())  return createTargetTyped<Vec3fGrid>(grid, combine);
+        else if (grid.isType<Vec3dGrid>())  return createTargetTyped<Vec3dGrid>(grid, combine);
+        return Target::Ptr();
+    }
+
+    const GridPtrVec& mGrids;
+    std::unordered_map<std::string, size_t> mIndices;
+    tbb::enumerable_thread_specific<std::vector<Target::Ptr>> mTargets;
+    // names of the grids scattered into which do not exist or have an unsupported type
+    tbb::enumerable_thread_specific<std::set<std::string>> mInvalid;
+};
+
+}
+}
+}
+}
+
+#endif // OPENVDB_AX_CODEGEN_SCATTER_DATA_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
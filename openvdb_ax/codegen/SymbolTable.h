@@ -43,8 +43,12 @@
 
 #include <llvm/IR/Value.h>
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
@@ -94,9 +98,7 @@ struct SymbolTable
     ///
     inline bool insert(const std::string& name, llvm::Value* value)
     {
-        if (exists(name)) return false;
-        mMap[name] = value;
-        return true;
+        return mMap.emplace(name, value).second;
     }
 
     /// @brief  Replace a variable in this symbol table. Returns true if the variable
@@ -107,9 +109,9 @@ struct SymbolTable
     ///
     inline bool replace(const std::string& name, llvm::Value* value)
     {
-        const bool existed = exists(name);
-        mMap[name] = value;
-        return existed;
+        const auto result = mMap.emplace(name, value);
+        if (!result.second) result.first->second = value;
+        return !result.second;
     }
 
     /// @brief  Clear all symbols in this table
@@ -125,7 +127,7 @@ private:
 };
 
 
-/// @brief  A map of unique ids to symbol tables which can be used to represent local
+/// @brief  A set of unique ids to symbol tables which can be used to represent local
 ///         variables within a program. New scopes can be added and erased where necessary
 ///         and iterated through using find(). Find assumes that tables are added through
 ///         parented ascending ids.
@@ -134,18 +136,23 @@ private:
 /// @note   The block symbol table is fairly simple and currently only supports insertion
 ///         by integer ids. Scopes that exist at the same level are expected to be built
 ///         in isolation and erase and re-create the desired ids where necessary.
+/// @note   Tables are stored contiguously by id, so creating, accessing and erasing a
+///         scope is constant time and a lookup only ever visits the tables of the scopes
+///         which enclose it. Tables are heap allocated so that pointers returned from
+///         getOrInsert() remain valid as deeper scopes are added.
 ///
 struct SymbolTableBlocks
 {
-    using MapType = std::map<size_t, SymbolTable>;
+    using TablePtr = std::unique_ptr<SymbolTable>;
+    using TableList = std::vector<TablePtr>;
 
-    SymbolTableBlocks() : mTables({{0, SymbolTable()}}) {}
+    SymbolTableBlocks() : mTables() { mTables.emplace_back(new SymbolTable); }
     ~SymbolTableBlocks() = default;
 
     /// @brief  Access to the list of global variables which are always accessible
     ///
-    inline SymbolTable& globals() { return mTables.at(0); }
-    inline const SymbolTable& globals() const { return mTables.at(0); }
+    inline SymbolTable& globals() { return *mTables.front(); }
+    inline const SymbolTable& globals() const { return *mTables.front(); }
 
     /// @brief  Erase a given scoped indexed SymbolTable from the list of held
     ///         SymbolTables. Returns true if the table previously existed.
@@ -159,9 +166,14 @@ struct SymbolTableBlocks
             throw std::runtime_error("Attempted to erase global variables which is disallowed.");
         }
 
-        const bool existed = (mTables.find(index) != mTables.end());
-        mTables.erase(index);
-        return existed;
+        if (index >= mTables.size() || !mTables[index]) return false;
+        mTables[index].reset();
+
+        // trim any trailing empty slots so that the last entry is always the
+        // deepest existing scope
+
+        while (!mTables.back()) mTables.pop_back();
+        return true;
     }
 
     /// @brief  Get or insert and get a SymbolTable with a unique index
@@ -170,7 +182,10 @@ struct SymbolTableBlocks
     ///
     inline SymbolTable* getOrInsert(const size_t index)
     {
-        return &(mTables[index]);
+        if (index >= mTables.size()) mTables.resize(index + 1);
+        TablePtr& table = mTables[index];
+        if (!table) table.reset(new SymbolTable);
+        return table.get();
     }
 
     /// @brief  Get a SymbolTable with a unique index. If the symbol table does not exist,
@@ -180,8 +195,7 @@ struct SymbolTableBlocks
     ///
     inline SymbolTable& get(const size_t index)
     {
-        auto iter = mTables.find(index);
-        if (iter != mTables.end()) return iter->second;
+        if (index < mTables.size() && mTables[index]) return *mTables[index];
         throw std::runtime_error("Attempted to access invalid symbol table with index "
             + std::to_string(index));
     }
@@ -196,24 +210,18 @@ struct SymbolTableBlocks
     ///
     inline llvm::Value* find(const std::string& name, const size_t startIndex) const
     {
-        // Find the lower bound start index - if it's greater than any value in the
-        // container, start at the beginning
+        // If the start index is greater than any index in the container, start at
+        // the deepest existing table
 
-        auto it = mTables.lower_bound(startIndex);
-        if (it != mTables.end() && it->first != startIndex) {
-            assert(it != mTables.begin());
-            --it;
-        }
-
-        // reverse the iterator (which also make it point to the preceding value)
-        // and decrement
+        size_t index = std::min(startIndex, mTables.size() - 1);
 
-        MapType::const_reverse_iterator iter(it);
-        --iter;
-
-        for (; iter != mTables.crend(); ++iter) {
-            llvm::Value* value = iter->second.get(name);
-            if (value) return value;
+        while (true) {
+            if (const TablePtr& table = mTables[index]) {
+                llvm::Value* value = table->get(name);
+                if (value) return value;
+            }
+            if (index == 0) break;
+            --index;
         }
 
         return nullptr;
@@ -226,7 +234,7 @@ struct SymbolTableBlocks
     ///
     inline llvm::Value* find(const std::string& name) const
     {
-        return this->find(name, mTables.crbegin()->first);
+        return this->find(name, mTables.size() - 1);
     }
 
     /// @brief  Replace the first occurance of a variable with a given name with a
@@ -238,8 +246,8 @@ struct SymbolTableBlocks
     inline bool replace(const std::string& name, llvm::Value* value)
     {
         for (auto it = mTables.rbegin(); it != mTables.rend(); ++it) {
-            if (it->second.get(name)) {
-                it->second.replace(name, value);
+            if (*it && (*it)->get(name)) {
+                (*it)->replace(name, value);
                 return true;
             }
         }
@@ -248,7 +256,7 @@ struct SymbolTableBlocks
     }
 
 private:
-    MapType mTables;
+    TableList mTables;
 };
 
 }
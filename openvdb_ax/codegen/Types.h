@@ -174,6 +174,18 @@ REGISTER_LLVM_TYPE_MAP(uint64_t, llvm::Type::getInt64Ty, llvm::ConstantInt::getS
 REGISTER_LLVM_TYPE_MAP(float, llvm::Type::getFloatTy, llvm::ConstantFP::get);
 REGISTER_LLVM_TYPE_MAP(double, llvm::Type::getDoubleTy, llvm::ConstantFP::get);
 
+template <>
+struct LLVMType<half> {
+    static inline llvm::Type*
+    get(llvm::LLVMContext& C) {
+        return llvm::Type::getHalfTy(C);
+    }
+    static inline llvm::Constant*
+    get(llvm::LLVMContext& C, const half value) {
+        return llvm::ConstantFP::get(LLVMType<half>::get(C), double(float(value)));
+    }
+};
+
 template <>
 struct LLVMType<char> {
     static_assert(std::is_same<uint8_t, unsigned char>::value,
@@ -244,9 +256,12 @@ llvmTypeFromName(const std::string& type,
                  llvm::LLVMContext& C)
 {
     if (type == openvdb::typeNameAsString<bool>())     return LLVMType<bool>::get(C);
+    if (type == openvdb::typeNameAsString<int8_t>())   return LLVMType<int8_t>::get(C);
+    if (type == openvdb::typeNameAsString<uint8_t>())  return LLVMType<uint8_t>::get(C);
     if (type == openvdb::typeNameAsString<int16_t>())  return LLVMType<int16_t>::get(C);
     if (type == openvdb::typeNameAsString<int32_t>())  return LLVMType<int32_t>::get(C);
     if (type == openvdb::typeNameAsString<int64_t>())  return LLVMType<int64_t>::get(C);
+    if (type == openvdb::typeNameAsString<half>())     return LLVMType<half>::get(C);
     if (type == openvdb::typeNameAsString<float>())    return LLVMType<float>::get(C);
     if (type == openvdb::typeNameAsString<double>())   return LLVMType<double>::get(C);
     if (type == openvdb::typeNameAsString<math::Vec3<int32_t>>())  return LLVMType<math::Vec3<int32_t>>::get(C);
@@ -257,6 +272,44 @@ llvmTypeFromName(const std::string& type,
     OPENVDB_THROW(LLVMTypeError, "Attribute Type " + type + " not recognised");
 }
 
+/// @brief  Returns whether the type defined by a string is a compact storage type. Attributes
+///         and volumes of these types are only loaded and stored as their own type and their
+///         values are otherwise computed as the type returned by computeTypeName.
+/// @param type  The name of the type
+///
+inline bool
+isStorageType(const std::string& type)
+{
+    return type == openvdb::typeNameAsString<half>() ||
+           type == openvdb::typeNameAsString<int8_t>() ||
+           type == openvdb::typeNameAsString<uint8_t>();
+}
+
+/// @brief  Returns the name of the type which the values of an attribute or volume of the
+///         given type are computed as. half values are computed as float values and int8
+///         and uint8 values as int values. Any other type is computed as itself.
+/// @param type  The name of the type
+///
+inline std::string
+computeTypeName(const std::string& type)
+{
+    if (type == openvdb::typeNameAsString<half>()) return openvdb::typeNameAsString<float>();
+    if (type == openvdb::typeNameAsString<int8_t>() ||
+        type == openvdb::typeNameAsString<uint8_t>()) return openvdb::typeNameAsString<int32_t>();
+    return type;
+}
+
+/// @brief  Returns whether the type defined by a string is an unsigned integer type. As llvm
+///         integer types do not store their sign, attributes and volumes of these types are
+///         accessed through their own internal functions.
+/// @param type  The name of the type
+///
+inline bool
+isUnsignedType(const std::string& type)
+{
+    return type == openvdb::typeNameAsString<uint8_t>();
+}
+
 /// @brief A LLVM TypeID reference to compare against
 ///
 inline unsigned llvmScalarTypeId()
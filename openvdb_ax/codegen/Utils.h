@@ -438,6 +438,50 @@ arithmeticConversion(llvm::Value* value,
     return llvmCastFunction(builder, value, targetType);
 }
 
+/// @brief  Converts a loaded value of an attribute or volume of a compact storage type to
+///         the type it is computed as, see computeTypeName. half values are extended with
+///         fpext, which llvm lowers to the F16C conversion instructions on hosts which
+///         support them. Values of any other type are returned unchanged.
+///
+/// @param value    The loaded llvm value of the attribute or volume
+/// @param type     The name of the type of the attribute or volume
+/// @param builder  The current llvm IRBuilder
+///
+inline llvm::Value*
+storageToCompute(llvm::Value* value,
+                 const std::string& type,
+                 llvm::IRBuilder<>& builder)
+{
+    if (!isStorageType(type)) return value;
+
+    llvm::Type* computeType = llvmTypeFromName(computeTypeName(type), builder.getContext());
+    if (type == openvdb::typeNameAsString<half>()) return builder.CreateFPExt(value, computeType);
+    if (isUnsignedType(type))                      return builder.CreateZExt(value, computeType);
+    return builder.CreateSExt(value, computeType);
+}
+
+/// @brief  Converts a loaded scalar value to the type of an attribute or volume of a compact
+///         storage type, first converting it to the type the storage type is computed as.
+///         For any other type the value is only converted to that type.
+///
+/// @param value    The loaded llvm scalar value to store
+/// @param type     The name of the type of the attribute or volume
+/// @param builder  The current llvm IRBuilder
+///
+inline llvm::Value*
+computeToStorage(llvm::Value* value,
+                 const std::string& type,
+                 llvm::IRBuilder<>& builder)
+{
+    llvm::LLVMContext& C = builder.getContext();
+    value = arithmeticConversion(value, llvmTypeFromName(computeTypeName(type), C), builder);
+    if (!isStorageType(type)) return value;
+
+    llvm::Type* storageType = llvmTypeFromName(type, C);
+    if (type == openvdb::typeNameAsString<half>()) return builder.CreateFPTrunc(value, storageType);
+    return builder.CreateTrunc(value, storageType);
+}
+
 /// @brief  Casts an array to another array of equal size but of a different element
 ///         type. Both source and target array element types must be scalar types.
 ///         The source array llvm Value should be a pointer to the array to cast.
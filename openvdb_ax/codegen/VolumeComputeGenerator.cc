@@ -55,7 +55,8 @@ const std::array<std::string, ComputeVolumeFunction::N_ARGS> ComputeVolumeFuncti
     "coord_is",
     "coord_ws",
     "accessors",
-    "transforms"
+    "transforms",
+    "scatter_data"
 };
 
 VolumeComputeGenerator::VolumeComputeGenerator(llvm::Module& module,
@@ -176,7 +177,7 @@ void VolumeComputeGenerator::visit(const ast::AssignExpression& node)
     assert(this->globals().exists(getGlobalAttributeAccess(attribute->mName, type)));
 
     llvm::Type* rhsType = rhs->getType()->getContainedType(0);
-    llvm::Type* lhsType = llvmTypeFromName(type, mContext);
+    llvm::Type* lhsType = llvmTypeFromName(computeTypeName(type), mContext);
 
     // convert rhs to match lhs for all supported assignments:
     // (scalar=scalar, vector=vector, scalar=vector, vector=scalar etc)
@@ -234,13 +235,22 @@ void VolumeComputeGenerator::visit(const ast::AssignExpression& node)
         }
     }
 
+    // values of storage types are converted to the volume type and passed by pointer
+
+    if (isStorageType(type)) {
+        llvm::Value* storage = mBuilder.CreateAlloca(llvmTypeFromName(type, mContext));
+        mBuilder.CreateStore(computeToStorage(rhs, type, mBuilder), storage);
+        rhs = storage;
+    }
+
     // construct function arguments
 
     const std::vector<llvm::Value*> argumentValues {
         accessorPtr, mLLVMArguments.get("coord_is"), rhs
     };
 
-    const FunctionBase::Ptr function = this->getFunction("setvoxel", mOptions, true);
+    const FunctionBase::Ptr function =
+        this->getFunction(isUnsignedType(type) ? "setvoxelunsigned" : "setvoxel", mOptions, true);
     function->execute(argumentValues, mLLVMArguments.map(), mBuilder, mModule);
 }
 
@@ -289,11 +299,23 @@ void VolumeComputeGenerator::visit(const ast::Crement& node)
             "\" is an unsupported type for crement. Must be scalar.");
     }
 
+    const std::string& volumeType =
+        static_cast<const ast::Attribute* const>(node.mVariable.get())->mType;
+
+    // values of storage types are converted to the volume type and passed by pointer
+
+    llvm::Value* value = rhs;
+    if (isStorageType(volumeType)) {
+        value = mBuilder.CreateAlloca(llvmTypeFromName(volumeType, mContext));
+        mBuilder.CreateStore(computeToStorage(rhs, volumeType, mBuilder), value);
+    }
+
     const std::vector<llvm::Value*> argumentValues {
-        lhs, mLLVMArguments.get("coord_is"), rhs
+        lhs, mLLVMArguments.get("coord_is"), value
     };
 
-    const FunctionBase::Ptr function = this->getFunction("setvoxel", mOptions, true);
+    const FunctionBase::Ptr function = this->getFunction(isUnsignedType(volumeType) ?
+        "setvoxelunsigned" : "setvoxel", mOptions, true);
     function->execute(argumentValues, mLLVMArguments.map(), mBuilder, mModule);
 
     // decide what to put on the expression stack
@@ -335,8 +357,12 @@ void VolumeComputeGenerator::visit(const ast::FunctionCall& node)
     argumentsFromStack(mValues, args, arguments);
     parseDefaultArgumentState(arguments, mBuilder);
 
+    llvm::Value* start = mProfiler ? this->readCycleCounter() : nullptr;
+
     std::vector<llvm::Value*> results;
     llvm::Value* result = function->execute(arguments, mLLVMArguments.map(), mBuilder, mModule, &results);
+
+    if (mProfiler) this->recordProfile(this->profileLabel(node), start);
     llvm::Type* resultType = result->getType();
 
     if (resultType != LLVMType<void>::get(mContext)) {
@@ -412,12 +438,23 @@ void VolumeComputeGenerator::visit(const ast::AttributeValue& node)
     llvm::Value* returnValue = mBuilder.CreateAlloca(returnType);
 
     const std::vector<llvm::Value*> args {
-        accessorValue, transform, mLLVMArguments.get("coord_ws"), returnValue
+        accessorValue, transform, mLLVMArguments.get("coord_ws"),
+        mLLVMArguments.get("coord_is"), returnValue
     };
 
-    const FunctionBase::Ptr function = this->getFunction("getvoxel", mOptions, true);
+    const std::string& type = node.mAttribute->mType;
+    const FunctionBase::Ptr function =
+        this->getFunction(isUnsignedType(type) ? "getvoxelunsigned" : "getvoxel", mOptions, true);
     function->execute(args, mLLVMArguments.map(), mBuilder, mModule, nullptr, /*add output args*/false);
 
+    // values of storage types are computed as a wider type, see computeTypeName
+
+    if (isStorageType(type)) {
+        llvm::Value* value = storageToCompute(mBuilder.CreateLoad(returnValue), type, mBuilder);
+        returnValue = mBuilder.CreateAlloca(value->getType());
+        mBuilder.CreateStore(value, returnValue);
+    }
+
     mValues.push(returnValue);
 }
 
@@ -41,6 +41,8 @@
 
 #include "ComputeGenerator.h"
 #include "FunctionTypes.h"
+#include "ScatterData.h"
+#include "VolumeFunctions.h"
 
 #include <openvdb_ax/compiler/TargetRegistry.h>
 
@@ -64,7 +66,17 @@ namespace OPENVDB_VERSION_NAME {
 namespace ax {
 namespace codegen {
 
-struct Accessors { using Ptr = std::unique_ptr<Accessors>; };
+struct Accessors
+{
+    using Ptr = std::unique_ptr<Accessors>;
+    virtual ~Accessors() = default;
+
+    /// @brief  Binds the leaf node of the volume at the origin of the leaf node being
+    ///         iterated, see LeafAccessor
+    virtual void beginLeaf(const Coord& origin) = 0;
+    virtual void endLeaf() = 0;
+    virtual void prefetchLeaf(const Coord& origin) const = 0;
+};
 
 template <typename TreeT>
 struct TypedAccessor : public Accessors
@@ -72,12 +84,17 @@ struct TypedAccessor : public Accessors
     using Ptr = std::unique_ptr<TypedAccessor<TreeT>>;
 
     inline void*
-    init(TreeT& tree) {
-        mAccessor.reset(new tree::ValueAccessor<TreeT>(tree));
+    init(TreeT& tree, const bool indexSpace) {
+        mAccessor.reset(new LeafAccessor<TreeT>(tree));
+        mAccessor->setIndexSpace(indexSpace);
         return static_cast<void*>(mAccessor.get());
     }
 
-    std::unique_ptr<tree::ValueAccessor<TreeT>> mAccessor;
+    void beginLeaf(const Coord& origin) override { mAccessor->beginLeaf(origin); }
+    void endLeaf() override { mAccessor->endLeaf(); }
+    void prefetchLeaf(const Coord& origin) const override { mAccessor->prefetchLeaf(origin); }
+
+    std::unique_ptr<LeafAccessor<TreeT>> mAccessor;
 };
 
 /// @brief  The function definition and signature which is built by the
@@ -92,8 +109,10 @@ struct TypedAccessor : public Accessors
 ///                  current voxel world space coord being accessed
 ///             4) - A void pointer to a vector of void pointers, representing an array
 ///                  of grid accessors
-///             4) - A void pointer to a vector of void pointers, representing an array
+///             5) - A void pointer to a vector of void pointers, representing an array
 ///                  of grid transforms
+///             6) - A void pointer to the ScatterData which holds the values scattered
+///                  into grids, or a null pointer if the function does not scatter values
 ///
 struct ComputeVolumeFunction
 {
@@ -106,7 +125,8 @@ struct ComputeVolumeFunction
              const int32_t (*)[3],
              const float (*)[3],
              void**,
-             void**
+             void**,
+             void*
             );
 
     using SignaturePtr = std::add_pointer<Signature>::type;
@@ -122,8 +142,9 @@ struct ComputeVolumeFunction
     /// The arguments of the generated function
     struct Arguments
     {
-        Arguments(const CustomData& customData)
+        Arguments(const CustomData& customData, ScatterData* const scatterData = nullptr)
             : mCustomDataPtr(&customData)
+            , mScatterDataPtr(scatterData)
             , mCoord()
             , mCoordWS()
             , mVoidAccessors()
@@ -145,34 +166,59 @@ struct ComputeVolumeFunction
                 reinterpret_cast<FunctionTraitsT::Arg<1>::Type>(mCoord.data()),
                 reinterpret_cast<FunctionTraitsT::Arg<2>::Type>(mCoordWS.asV()),
                 static_cast<FunctionTraitsT::Arg<3>::Type>(mVoidAccessors.data()),
-                static_cast<FunctionTraitsT::Arg<4>::Type>(mVoidTransforms.data()));
+                static_cast<FunctionTraitsT::Arg<4>::Type>(mVoidTransforms.data()),
+                static_cast<FunctionTraitsT::Arg<5>::Type>(mScatterDataPtr));
         }
 
+        /// @brief  Add an accessor for a volume
+        /// @param  tree        The tree of the volume
+        /// @param  indexSpace  Whether the volume has the same transform as the volume
+        ///                     being iterated, so that it can be accessed by index
         template <typename TreeT>
         inline void
-        addAccessor(TreeT& tree)
+        addAccessor(TreeT& tree, const bool indexSpace = false)
         {
             typename TypedAccessor<TreeT>::Ptr accessor(new TypedAccessor<TreeT>());
-            mVoidAccessors.emplace_back(accessor->init(tree));
+            mVoidAccessors.emplace_back(accessor->init(tree, indexSpace));
             mAccessors.emplace_back(std::move(accessor));
         }
 
-        template <typename TreeT>
         inline void
-        addConstAccessor(const TreeT& tree)
+        addTransform(math::Transform::Ptr transform)
         {
-            typename TypedAccessor<const TreeT>::Ptr accessor(new TypedAccessor<const TreeT>());
-            mVoidAccessors.emplace_back(accessor->init(tree));
-            mAccessors.emplace_back(std::move(accessor));
+            mVoidTransforms.emplace_back(static_cast<void*>(transform.get()));
+        }
+
+        /// @brief  Binds the leaf node at the given origin of every accessed volume, which
+        ///         remains bound until endLeaf is called
+        inline void beginLeaf(const Coord& origin)
+        {
+            for (const Accessors::Ptr& accessor : mAccessors) accessor->beginLeaf(origin);
+        }
+
+        inline void endLeaf()
+        {
+            for (const Accessors::Ptr& accessor : mAccessors) accessor->endLeaf();
         }
 
+        /// @brief  Prefetches the values of the leaf node at the given origin of every
+        ///         volume accessed by index, ahead of that leaf being bound
+        inline void prefetchLeaf(const Coord& origin) const
+        {
+            for (const Accessors::Ptr& accessor : mAccessors) accessor->prefetchLeaf(origin);
+        }
+
+        /// @brief  Add an empty accessor and transform for a volume which is never
+        ///         accessed, keeping the remaining volumes at their registry index
         inline void
-        addTransform(math::Transform::Ptr transform)
+        addNullAccessor()
         {
-            mVoidTransforms.emplace_back(static_cast<void*>(transform.get()));
+            mVoidAccessors.emplace_back(nullptr);
+            mVoidTransforms.emplace_back(nullptr);
         }
 
         const CustomData* const mCustomDataPtr;
+        ScatterData* const mScatterDataPtr;
         openvdb::Coord mCoord;
         openvdb::math::Vec3<float> mCoordWS;
 
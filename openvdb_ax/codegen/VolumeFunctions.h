@@ -44,6 +44,7 @@
 
 #include "Functions.h"
 #include "FunctionTypes.h"
+#include "ScatterData.h"
 #include "Types.h"
 #include "Utils.h"
 
@@ -52,8 +53,11 @@
 #include <openvdb_ax/compiler/CustomData.h>
 #include <openvdb_ax/Exceptions.h>
 
+#include <openvdb/openvdb.h>
+#include <openvdb/tree/ValueAccessor.h>
 #include <openvdb/version.h>
 
+#include <algorithm>
 #include <unordered_map>
 
 namespace openvdb {
@@ -143,6 +147,170 @@ struct GetCoordZ : public FunctionBase
     }
 };
 
+/// @brief  Issues a software prefetch of every cache line of the given range of memory.
+///         Has no effect on compilers without prefetch builtins.
+inline void prefetch(const void* data, const size_t bytes)
+{
+#if defined(__GNUC__)
+    const char* const begin = static_cast<const char*>(data);
+    for (size_t offset = 0; offset < bytes; offset += 64) __builtin_prefetch(begin + offset);
+#else
+    (void)data; (void)bytes;
+#endif
+}
+
+/// @brief  The accessor of a volume bound to the compute function. The leaf node of the
+///         volume at the origin of each leaf node being iterated is bound before that leaf
+///         is executed, so that every volume resolves its leaf once per leaf rather than
+///         once per voxel. Voxels of the bound leaf are read and written directly through
+///         its buffer, while any other voxel goes through the tree accessor. Volumes with
+///         the same transform as the iterated volume also use the index space coordinate
+///         of the current voxel rather than converting its world space position.
+///
+template <typename TreeT>
+struct LeafAccessor
+{
+    using LeafT = typename TreeT::LeafNodeType;
+    using ValueT = typename TreeT::ValueType;
+
+    LeafAccessor(TreeT& tree)
+        : mAccessor(tree)
+        , mLeaf(nullptr)
+        , mIndexSpace(false) {}
+
+    /// @brief  Binds the leaf node at the given origin, if the volume has one. Only volumes
+    ///         accessed by index bind a leaf, as the voxels of any other volume are not
+    ///         aligned with the leaf nodes being iterated.
+    inline void beginLeaf(const openvdb::Coord& origin)
+    {
+        if (mIndexSpace) mLeaf = mAccessor.probeLeaf(origin);
+    }
+
+    inline void endLeaf() { mLeaf = nullptr; }
+
+    /// @brief  Prefetches the values of the leaf node at the given origin, if the volume
+    ///         has one, so that they are in cache by the time that leaf is bound
+    inline void prefetchLeaf(const openvdb::Coord& origin) const
+    {
+        if (!mIndexSpace) return;
+        const LeafT* const leaf = mAccessor.probeConstLeaf(origin);
+        if (leaf) prefetch(leaf->buffer().data(), sizeof(ValueT) * LeafT::SIZE);
+    }
+
+    /// @brief  Whether the volume shares the transform of the iterated volume, in which case
+    ///         voxels are accessed by index rather than world space position
+    inline void setIndexSpace(const bool indexSpace) { mIndexSpace = indexSpace; }
+    inline bool indexSpace() const { return mIndexSpace; }
+
+    inline ValueT getValue(const openvdb::Coord& ijk) const
+    {
+        if (!this->isBound(ijk)) return mAccessor.getValue(ijk);
+        return mLeaf->getValue(LeafT::coordToOffset(ijk));
+    }
+
+    inline void setValueOnly(const openvdb::Coord& ijk, const ValueT& value)
+    {
+        if (!this->isBound(ijk)) mAccessor.setValueOnly(ijk, value);
+        else mLeaf->setValueOnly(LeafT::coordToOffset(ijk), value);
+    }
+
+private:
+    inline bool isBound(const openvdb::Coord& ijk) const {
+        return mLeaf && (ijk & ~(int32_t(LeafT::DIM) - 1)) == mLeaf->origin();
+    }
+
+    tree::ValueAccessor<TreeT> mAccessor;
+    LeafT* mLeaf;
+    bool mIndexSpace;
+};
+
+/// @brief  Bool leaf nodes store their values as bits, so writing a single voxel modifies
+///         a bit of the leaf buffer in place. The values of the bound leaf are instead held
+///         as a local copy of the buffer words, which are stored back into the leaf buffer
+///         as whole words if any of them were written.
+///
+template <>
+struct LeafAccessor<openvdb::BoolTree>
+{
+    using TreeT = openvdb::BoolTree;
+    using LeafT = TreeT::LeafNodeType;
+    using WordT = LeafT::Buffer::WordType;
+
+    static const openvdb::Index WORD_COUNT = LeafT::Buffer::WORD_COUNT;
+
+    LeafAccessor(TreeT& tree)
+        : mAccessor(tree)
+        , mLeaf(nullptr)
+        , mWords()
+        , mWritten(false)
+        , mIndexSpace(false) {}
+
+    inline void beginLeaf(const openvdb::Coord& origin)
+    {
+        if (mIndexSpace) mLeaf = mAccessor.probeLeaf(origin);
+        if (!mLeaf) return;
+        const WordT* const words = mLeaf->buffer().data();
+        std::copy(words, words + WORD_COUNT, mWords);
+        mWritten = false;
+    }
+
+    inline void endLeaf()
+    {
+        if (mLeaf && mWritten) {
+            std::copy(mWords, mWords + WORD_COUNT, mLeaf->buffer().data());
+        }
+        mLeaf = nullptr;
+    }
+
+    inline void prefetchLeaf(const openvdb::Coord& origin) const
+    {
+        if (!mIndexSpace) return;
+        const LeafT* const leaf = mAccessor.probeConstLeaf(origin);
+        if (leaf) prefetch(leaf->buffer().data(), sizeof(WordT) * WORD_COUNT);
+    }
+
+    inline void setIndexSpace(const bool indexSpace) { mIndexSpace = indexSpace; }
+    inline bool indexSpace() const { return mIndexSpace; }
+
+    inline bool getValue(const openvdb::Coord& ijk) const
+    {
+        if (!this->isBound(ijk)) return mAccessor.getValue(ijk);
+        const openvdb::Index offset = LeafT::coordToOffset(ijk);
+        return (mWords[offset >> 6] >> (offset & 63)) & WordT(1);
+    }
+
+    inline void setValueOnly(const openvdb::Coord& ijk, const bool value)
+    {
+        if (!this->isBound(ijk)) {
+            mAccessor.setValueOnly(ijk, value);
+            return;
+        }
+        const openvdb::Index offset = LeafT::coordToOffset(ijk);
+        const WordT bit = WordT(1) << (offset & 63);
+        if (value) mWords[offset >> 6] |= bit;
+        else       mWords[offset >> 6] &= ~bit;
+        mWritten = true;
+    }
+
+private:
+    inline bool isBound(const openvdb::Coord& ijk) const {
+        return mLeaf && (ijk & ~(int32_t(LeafT::DIM) - 1)) == mLeaf->origin();
+    }
+
+    tree::ValueAccessor<TreeT> mAccessor;
+    LeafT* mLeaf;
+    WordT mWords[WORD_COUNT];
+    bool mWritten;
+    bool mIndexSpace;
+};
+
+/// @brief  The type of the accessor bound for a volume of the given value type
+template <typename ValueT>
+struct VolumeAccessor
+{
+    using Type = LeafAccessor<typename openvdb::BoolGrid::ValueConverter<ValueT>::Type::TreeType>;
+};
+
 struct SetVoxel : public FunctionBase
 {
     DEFINE_IDENTIFIER_CONTEXT_DOC("setvoxel", FunctionBase::Volume,
@@ -161,15 +329,19 @@ struct SetVoxel : public FunctionBase
         // non-pod types pass by ptr
         DECLARE_FUNCTION_SIGNATURE(set_voxel_ptr<openvdb::Vec3d>),
         DECLARE_FUNCTION_SIGNATURE(set_voxel_ptr<openvdb::Vec3f>),
-        DECLARE_FUNCTION_SIGNATURE(set_voxel_ptr<openvdb::Vec3i>)
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_ptr<openvdb::Vec3i>),
+        // storage types pass by ptr
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_ptr<half>),
+        DECLARE_FUNCTION_SIGNATURE(set_voxel_ptr<int8_t>)
     }) {}
 
 private:
+    friend struct SetVoxelUnsigned;
+
     template <typename ValueT>
     inline static void set_voxel_ptr(void* accessor, const int32_t (*coord)[3], const ValueT* value)
     {
-        using GridType = typename openvdb::BoolGrid::ValueConverter<ValueT>::Type;
-        using AccessorType = typename GridType::Accessor;
+        using AccessorType = typename VolumeAccessor<ValueT>::Type;
 
         assert(accessor);
         assert(coord);
@@ -204,32 +376,162 @@ struct GetVoxel : public FunctionBase
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel<bool>, 1),
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel<openvdb::Vec3d>, 1),
         DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel<openvdb::Vec3f>, 1),
-        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel<openvdb::Vec3i>, 1)
-
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel<openvdb::Vec3i>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel<half>, 1),
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(get_voxel<int8_t>, 1)
     }) {}
 
 private:
+    friend struct GetVoxelUnsigned;
+
     template <typename ValueT>
-    inline static void get_voxel(void* accessor, void* transform, const float (*coord)[3], ValueT* value)
+    inline static void get_voxel(void* accessor,
+                                 void* transform,
+                                 const float (*coordWS)[3],
+                                 const int32_t (*coordIS)[3],
+                                 ValueT* value)
     {
-        using GridType = typename openvdb::BoolGrid::ValueConverter<ValueT>::Type;
-        using AccessorType = typename GridType::Accessor;
+        using AccessorType = typename VolumeAccessor<ValueT>::Type;
 
         assert(accessor);
-        assert(coord);
+        assert(coordWS);
+        assert(coordIS);
         assert(transform);
 
         const AccessorType* const accessorPtr = static_cast<const AccessorType* const>(accessor);
+
+        if (accessorPtr->indexSpace()) {
+            (*value) = accessorPtr->getValue(openvdb::Coord(coordIS[0]));
+            return;
+        }
+
         const openvdb::math::Transform* const transformPtr =
                 static_cast<const openvdb::math::Transform* const>(transform);
-        openvdb::Vec3d coordWS(*coord);
-        openvdb::Coord coordIS = transformPtr->worldToIndexCellCentered(coordWS);
+        openvdb::Vec3d position(*coordWS);
+        openvdb::Coord ijk = transformPtr->worldToIndexCellCentered(position);
 
-        (*value) = accessorPtr->getValue(coordIS);
+        (*value) = accessorPtr->getValue(ijk);
     }
 
 };
 
+/// @brief  uint8 and int8 volumes have the same llvm type, so the values of uint8 volumes
+///         are set and retrieved through their own functions
+///
+struct SetVoxelUnsigned : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("setvoxelunsigned", FunctionBase::Volume,
+        "Internal function for setting the value of a voxel of an unsigned volume.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new SetVoxelUnsigned()); }
+
+    SetVoxelUnsigned() : FunctionBase({
+        DECLARE_FUNCTION_SIGNATURE(SetVoxel::set_voxel_ptr<uint8_t>)
+    }) {}
+};
+
+struct GetVoxelUnsigned : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("getvoxelunsigned", FunctionBase::Volume,
+        "Internal function for getting the value of a voxel of an unsigned volume.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new GetVoxelUnsigned()); }
+
+    GetVoxelUnsigned() : FunctionBase({
+        DECLARE_FUNCTION_SIGNATURE_OUTPUT(GetVoxel::get_voxel<uint8_t>, 1)
+    }) {}
+};
+
+struct ScatterInternal : public FunctionBase
+{
+    DEFINE_IDENTIFIER_CONTEXT_DOC("internal_scatter", FunctionBase::Volume,
+        "Internal function for scattering a value into a volume.")
+
+    inline static Ptr create(const FunctionOptions&) { return Ptr(new ScatterInternal()); }
+
+    ScatterInternal() : FunctionBase({
+        DECLARE_FUNCTION_SIGNATURE(scatter_value),
+        DECLARE_FUNCTION_SIGNATURE(scatter_vector)
+    }) {}
+
+private:
+    inline static void scatter_value(const uint8_t* const name,
+                                     const float (*position)[3],
+                                     const double value,
+                                     const int32_t combine,
+                                     void* const scatterData)
+    {
+        if (!scatterData) return;
+        const std::string nameStr(reinterpret_cast<const char* const>(name));
+        static_cast<ScatterData*>(scatterData)->scatter(nameStr, openvdb::Vec3d(*position),
+            value, static_cast<ScatterData::Combine>(combine));
+    }
+
+    inline static void scatter_vector(const uint8_t* const name,
+                                      const float (*position)[3],
+                                      const openvdb::Vec3d* value,
+                                      const int32_t combine,
+                                      void* const scatterData)
+    {
+        if (!scatterData) return;
+        const std::string nameStr(reinterpret_cast<const char* const>(name));
+        static_cast<ScatterData*>(scatterData)->scatter(nameStr, openvdb::Vec3d(*position),
+            *value, static_cast<ScatterData::Combine>(combine));
+    }
+};
+
+// Scatter functions, which only differ by the operation used to combine the values
+// written into the same voxel
+
+#define DEFINE_SCATTER_FUNCTION(ClassName, Identifier, Combine, Doc) \
+    struct ClassName : public FunctionBase { \
+        DEFINE_IDENTIFIER_CONTEXT_DOC(Identifier, FunctionBase::Volume, Doc) \
+        inline static Ptr create(const FunctionOptions&) { return Ptr(new ClassName()); } \
+        ClassName() : FunctionBase({ \
+            FunctionSignature<void(StringPtrType, V3F*, double)>::create \
+                (nullptr, std::string(Identifier), 0), \
+            FunctionSignature<void(StringPtrType, V3F*, V3D*)>::create \
+                (nullptr, std::string(Identifier), 0) \
+        }) {} \
+        inline void getDependencies(std::vector<std::string>& identifiers) const override { \
+            identifiers.emplace_back("internal_scatter"); \
+        } \
+        llvm::Value* \
+        generate(const std::vector<llvm::Value*>& args, \
+             const std::unordered_map<std::string, llvm::Value*>& globals, \
+             llvm::IRBuilder<>& builder, \
+             llvm::Module& M) const override final { \
+            std::vector<llvm::Value*> internalArgs(args); \
+            internalArgs.emplace_back(llvm::ConstantInt::get \
+                (LLVMType<int32_t>::get(builder.getContext()), Combine)); \
+            internalArgs.emplace_back(globals.at("scatter_data")); \
+            ScatterInternal func; \
+            return func.execute(internalArgs, globals, builder, M); \
+        } \
+    };
+
+DEFINE_SCATTER_FUNCTION(ScatterSet, "scatter", ScatterData::OVERWRITE,
+    "Sets the voxel of the named volume which contains the given world space position to the "
+    "given value. The value is written once every voxel has been executed, so it is not visible "
+    "to any voxel during the execution of the current code. Vector values are ignored by scalar "
+    "volumes, and scalar values are set to every component of vector volumes. Scattering into a "
+    "volume which does not exist, or a mask volume, is an error.")
+
+DEFINE_SCATTER_FUNCTION(ScatterAdd, "scatteradd", ScatterData::ADD,
+    "Adds the given value to the voxel of the named volume which contains the given world space "
+    "position. The value is written once every voxel has been executed, and inactive voxels are "
+    "activated and set to the value. All values scattered into the same voxel are summed.")
+
+DEFINE_SCATTER_FUNCTION(ScatterMax, "scattermax", ScatterData::MAX,
+    "Sets the voxel of the named volume which contains the given world space position to the "
+    "maximum of its value and the given value. The value is written once every voxel has been "
+    "executed, and inactive voxels are activated and set to the value.")
+
+DEFINE_SCATTER_FUNCTION(ScatterMin, "scattermin", ScatterData::MIN,
+    "Sets the voxel of the named volume which contains the given world space position to the "
+    "minimum of its value and the given value. The value is written once every voxel has been "
+    "executed, and inactive voxels are activated and set to the value.")
+
 }
 }
 }
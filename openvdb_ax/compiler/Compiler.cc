@@ -40,20 +40,32 @@
 #include <openvdb_ax/Exceptions.h>
 
 #include <openvdb/Exceptions.h>
+#include <openvdb/points/AttributeArray.h>
 
+#include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/Triple.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/ExecutionEngine/RuntimeDyld.h>
 #include <llvm/InitializePasses.h>
+#include <llvm/IR/DiagnosticInfo.h>
+#include <llvm/IR/DiagnosticPrinter.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/Object/ObjectFile.h>
+#include <llvm/Object/SymbolSize.h>
+#include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/ManagedStatic.h> // llvm_shutdown
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/raw_os_ostream.h>
 #include <llvm/Support/SourceMgr.h> // SMDiagnostic
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/Utils/Cloning.h> // CloneModule
 
 // @note  As of adding support for LLVM 5.0 we not longer explicitly
 // perform standrd compiler passes (-std-compile-opts) based on the changes
@@ -72,8 +84,17 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
+#include <tbb/atomic.h>
 #include <tbb/mutex.h>
 
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#if defined(__linux__)
+#include <unistd.h> // getpid
+#endif
+
 
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
@@ -87,6 +108,21 @@ namespace {
 tbb::mutex sInitMutex;
 bool sIsInitialized = false;
 bool sShutdown = false;
+
+/// @brief  The runtime half precision conversions which llvm lowers half conversions to
+///         on hosts without F16C. These are provided by compiler-rt, which the JIT does
+///         not link against.
+float halfToFloat(const uint16_t bits)
+{
+    half value;
+    value.setBits(bits);
+    return float(value);
+}
+
+uint16_t floatToHalf(const float value)
+{
+    return half(value).bits();
+}
 }
 
 
@@ -142,6 +178,22 @@ void initialize()
     llvm::initializeUnreachableBlockElimLegacyPassPass(registry);
     llvm::initializeExpandReductionsPass(registry);
 
+    llvm::sys::DynamicLibrary::AddSymbol("__gnu_h2f_ieee", reinterpret_cast<void*>(&halfToFloat));
+    llvm::sys::DynamicLibrary::AddSymbol("__gnu_f2h_ieee", reinterpret_cast<void*>(&floatToHalf));
+
+    // Register the point attribute arrays of the storage types which openvdb does
+    // not register itself
+
+    if (!points::TypedAttributeArray<half>::isRegistered()) {
+        points::TypedAttributeArray<half>::registerType();
+    }
+    if (!points::TypedAttributeArray<int8_t>::isRegistered()) {
+        points::TypedAttributeArray<int8_t>::registerType();
+    }
+    if (!points::TypedAttributeArray<uint8_t>::isRegistered()) {
+        points::TypedAttributeArray<uint8_t>::registerType();
+    }
+
     sIsInitialized = true;
 }
 
@@ -221,11 +273,119 @@ void addOptimizationPasses(llvm::legacy::PassManagerBase& passes,
 }
 
 
+/// @brief  Collects optimisation remarks emitted by a subset of the llvm optimisation
+///         passes into a list of strings. The remarks are of the form:
+///           remark [passed|missed|analysis] <pass> in <function>: <message>
+///         The AST does not carry source locations, so remarks are attributed to the
+///         generated compute function unless the IR contains debug locations.
+///
+struct OptimisationRemarkCollector
+{
+    OptimisationRemarkCollector(llvm::LLVMContext& context, std::vector<std::string>* remarks)
+        : mContext(context)
+        , mRemarks(remarks)
+        , mPreviousHandler(context.getDiagnosticHandler())
+        , mPreviousContext(context.getDiagnosticContext())
+        , mPreviousRespectFilters(context.getDiagnosticHandlerRespectsFilters())
+    {
+        if (mRemarks) {
+            // don't respect filters, otherwise remarks are only forwarded if the
+            // -pass-remarks options have been set
+            mContext.setDiagnosticHandler(OptimisationRemarkCollector::handle,
+                this, /*RespectFilters*/false);
+        }
+    }
+
+    ~OptimisationRemarkCollector()
+    {
+        if (mRemarks) {
+            mContext.setDiagnosticHandler(mPreviousHandler,
+                mPreviousContext, mPreviousRespectFilters);
+        }
+    }
+
+    static void handle(const llvm::DiagnosticInfo& info, void* context)
+    {
+        OptimisationRemarkCollector* collector =
+            static_cast<OptimisationRemarkCollector*>(context);
+
+        const llvm::DiagnosticInfoOptimizationBase* remark =
+            llvm::dyn_cast<llvm::DiagnosticInfoOptimizationBase>(&info);
+
+        if (!remark) {
+            // forward anything which isn't a remark, falling back to the default
+            // behaviour of llvm if there is no previous handler
+            if (collector->mPreviousHandler) {
+                collector->mPreviousHandler(info, collector->mPreviousContext);
+            }
+            else {
+                printDiagnostic(info);
+            }
+            return;
+        }
+
+        const std::string pass = remark->getPassName();
+        if (pass != "loop-vectorize" && pass != "slp-vectorizer" &&
+            pass != "inline" && pass != "licm") return;
+
+        std::string kind;
+        if (llvm::isa<llvm::OptimizationRemark>(info))              kind = "passed";
+        else if (llvm::isa<llvm::OptimizationRemarkMissed>(info))   kind = "missed";
+        else if (llvm::isa<llvm::OptimizationRemarkAnalysis>(info)) kind = "analysis";
+        else return;
+
+        std::string message = "remark [" + kind + "] " + pass;
+
+        const llvm::DiagnosticInfoIROptimization* optimisation =
+            llvm::dyn_cast<llvm::DiagnosticInfoIROptimization>(&info);
+        if (optimisation) {
+            message += " in " + optimisation->getFunction().getName().str();
+            if (optimisation->isLocationAvailable()) {
+                message += " (" + optimisation->getLocationStr() + ")";
+            }
+        }
+
+        message += ": " + remark->getMsg();
+        collector->mRemarks->emplace_back(message);
+    }
+
+private:
+
+    /// @brief  Prints a diagnostic to stderr and exits on errors, which matches the
+    ///         handling of diagnostics by an LLVMContext without a handler
+    static void printDiagnostic(const llvm::DiagnosticInfo& info)
+    {
+        const char* prefix = "";
+        switch (info.getSeverity()) {
+            case llvm::DS_Error   : prefix = "error"; break;
+            case llvm::DS_Warning : prefix = "warning"; break;
+            case llvm::DS_Remark  : prefix = "remark"; break;
+            case llvm::DS_Note    : prefix = "note"; break;
+        }
+
+        llvm::DiagnosticPrinterRawOStream printer(llvm::errs());
+        llvm::errs() << prefix << ": ";
+        info.print(printer);
+        llvm::errs() << "\n";
+        if (info.getSeverity() == llvm::DS_Error) exit(1);
+    }
+
+    llvm::LLVMContext& mContext;
+    std::vector<std::string>* const mRemarks;
+    const llvm::LLVMContext::DiagnosticHandlerTy mPreviousHandler;
+    void* const mPreviousContext;
+    const bool mPreviousRespectFilters;
+};
+
 void LLVMoptimise(llvm::Module* module,
                   const unsigned optLevel,
                   const unsigned sizeLevel,
-                  const bool verify = false)
+                  const bool verify = false,
+                  std::vector<std::string>* remarks = nullptr,
+                  PhaseListener* listener = nullptr)
 {
+    OptimisationRemarkCollector collector(module->getContext(), remarks);
+
     // Pass manager setup and IR optimisations - Do target independent optimisations
     // only - i.e. the following do not require an llvm TargetMachine analysis pass
 
@@ -245,13 +405,18 @@ void LLVMoptimise(llvm::Module* module,
     addStandardLinkPasses(passes);
     addOptimizationPasses(passes, functionPasses, nullptr, optLevel, sizeLevel);
 
-    functionPasses.doInitialization();
-    for (llvm::Function& function : *module) {
-      functionPasses.run(function);
+    {
+        ScopedPhase phase(listener, "function passes");
+        functionPasses.doInitialization();
+        for (llvm::Function& function : *module) {
+          functionPasses.run(function);
+        }
+        functionPasses.doFinalization();
     }
-    functionPasses.doFinalization();
 
     if (verify) passes.add(llvm::createVerifierPass());
+
+    ScopedPhase phase(listener, "module passes");
     passes.run(*module);
 }
 
@@ -299,9 +464,23 @@ void initializeGlobalFunctions(const codegen::FunctionRegistry& registry,
     }
 }
 
-void optimiseAndVerify(llvm::Module* module, const bool verify, const CompilerOptions::OptLevel optLevel)
+void initializeProfileFunction(llvm::ExecutionEngine& engine, llvm::Module& module)
+{
+    // only exists if the code was instrumented and has not been optimised away
+    const llvm::Function* function =
+        module.getFunction(codegen::ComputeGenerator::ProfileFunctionName);
+    if (!function) return;
+    engine.addGlobalMapping(function, reinterpret_cast<void*>(&codegen::ProfileCounters::record));
+}
+
+void optimiseAndVerify(llvm::Module* module,
+                       const bool verify,
+                       const CompilerOptions::OptLevel optLevel,
+                       std::vector<std::string>* remarks = nullptr,
+                       PhaseListener* listener = nullptr)
 {
     if (verify) {
+        ScopedPhase phase(listener, "verify");
         llvm::raw_os_ostream out(std::cout);
         if (llvm::verifyModule(*module, &out)) {
             OPENVDB_THROW(LLVMIRError, "LLVM IR is not valid.");
@@ -310,27 +489,27 @@ void optimiseAndVerify(llvm::Module* module, const bool verify, const CompilerOp
 
     switch (optLevel) {
         case CompilerOptions::OptLevel::O0 : {
-            LLVMoptimise(module, 0, 0, verify);
+            LLVMoptimise(module, 0, 0, verify, remarks, listener);
             break;
         }
         case CompilerOptions::OptLevel::O1 : {
-            LLVMoptimise(module, 1, 0, verify);
+            LLVMoptimise(module, 1, 0, verify, remarks, listener);
             break;
         }
         case CompilerOptions::OptLevel::O2 : {
-            LLVMoptimise(module, 2, 0, verify);
+            LLVMoptimise(module, 2, 0, verify, remarks, listener);
             break;
         }
         case CompilerOptions::OptLevel::Os : {
-            LLVMoptimise(module, 2, 1, verify);
+            LLVMoptimise(module, 2, 1, verify, remarks, listener);
             break;
         }
         case CompilerOptions::OptLevel::Oz : {
-            LLVMoptimise(module, 2, 2, verify);
+            LLVMoptimise(module, 2, 2, verify, remarks, listener);
             break;
         }
         case CompilerOptions::OptLevel::O3 : {
-            LLVMoptimise(module, 3, 0, verify);
+            LLVMoptimise(module, 3, 0, verify, remarks, listener);
             break;
         }
         case CompilerOptions::OptLevel::NONE :
@@ -338,6 +517,175 @@ void optimiseAndVerify(llvm::Module* module, const bool verify, const CompilerOp
     }
 }
 
+void printModule(const llvm::Module& module, std::ostream& os)
+{
+    llvm::raw_os_ostream out(os);
+    module.print(out, nullptr);
+}
+
+/// @brief  Returns the target features which are enabled in addition to those of the
+///         default CPU. Half precision conversions are only lowered to the F16C
+///         instructions if the feature is enabled, so it is enabled when the host
+///         supports it. No other host features are enabled, so that all other code
+///         generation does not depend on the host.
+std::vector<std::string> targetFeatures()
+{
+    std::vector<std::string> features;
+    llvm::StringMap<bool> hostFeatures;
+    if (llvm::sys::getHostCPUFeatures(hostFeatures) && hostFeatures.lookup("f16c")) {
+        features.emplace_back("+f16c");
+    }
+    return features;
+}
+
+/// @brief  Print the native assembly of a module for the host target. The host
+///         target machine is selected in the same way as the ExecutionEngine which
+///         is used to JIT the module. As code generation modifies the module, a
+///         copy is compiled.
+void printAssembly(const llvm::Module& module, std::ostream& os)
+{
+    std::unique_ptr<llvm::Module> copy(llvm::CloneModule(&module));
+
+    llvm::EngineBuilder builder;
+    builder.setMAttrs(targetFeatures());
+    std::unique_ptr<llvm::TargetMachine> targetMachine(builder.selectTarget());
+    if (!targetMachine) {
+        OPENVDB_THROW(AXCompilerError, "Failed to select target machine for assembly output.");
+    }
+
+    copy->setDataLayout(targetMachine->createDataLayout());
+
+    llvm::SmallVector<char, 0> buffer;
+    llvm::raw_svector_ostream out(buffer);
+
+    llvm::legacy::PassManager passes;
+    if (targetMachine->addPassesToEmitFile(passes, out,
+            llvm::TargetMachine::CGFT_AssemblyFile)) {
+        OPENVDB_THROW(AXCompilerError, "Target machine is unable to emit assembly.");
+    }
+
+    passes.run(*copy);
+    os.write(buffer.data(), buffer.size());
+}
+
+/// @brief  A JITEventListener which appends the address, size and name of every
+///         function symbol in an emitted object to the perf map file of this process,
+///         /tmp/perf-<pid>.map. Names are prefixed with the given identifier.
+class PerfMapListener : public llvm::JITEventListener
+{
+public:
+    PerfMapListener(const std::string& identifier)
+        : mIdentifier(identifier) {}
+
+    ~PerfMapListener() override = default;
+
+    void NotifyObjectEmitted(const llvm::object::ObjectFile& object,
+                             const llvm::RuntimeDyld::LoadedObjectInfo& info) override
+    {
+        // the debug object has its section addresses set to their loaded locations
+
+        llvm::object::OwningBinary<llvm::object::ObjectFile> debugObject =
+            info.getObjectForDebug(object);
+        if (!debugObject.getBinary()) return;
+
+        std::ostringstream entries;
+        entries << std::hex;
+
+        for (const auto& symbolSize :
+                llvm::object::computeSymbolSizes(*debugObject.getBinary())) {
+
+            const llvm::object::SymbolRef& symbol = symbolSize.first;
+            const uint64_t size = symbolSize.second;
+            if (size == 0) continue;
+
+            llvm::Expected<llvm::object::SymbolRef::Type> type = symbol.getType();
+            if (!type) {
+                llvm::consumeError(type.takeError());
+                continue;
+            }
+            if (*type != llvm::object::SymbolRef::ST_Function) continue;
+
+            llvm::Expected<llvm::StringRef> name = symbol.getName();
+            if (!name) {
+                llvm::consumeError(name.takeError());
+                continue;
+            }
+
+            llvm::Expected<uint64_t> address = symbol.getAddress();
+            if (!address) {
+                llvm::consumeError(address.takeError());
+                continue;
+            }
+
+            entries << *address << " " << size << " "
+                << mIdentifier << "::" << name->str() << "\n";
+        }
+
+        write(entries.str());
+    }
+
+    static std::string filename()
+    {
+#if defined(__linux__)
+        return "/tmp/perf-" + std::to_string(::getpid()) + ".map";
+#else
+        return "";
+#endif
+    }
+
+private:
+    static void write(const std::string& entries)
+    {
+        static tbb::mutex sPerfMapMutex;
+
+        const std::string file = PerfMapListener::filename();
+        if (file.empty() || entries.empty()) return;
+
+        tbb::mutex::scoped_lock lock(sPerfMapMutex);
+        std::ofstream out(file, std::ios::out | std::ios::app);
+        out << entries;
+    }
+
+    const std::string mIdentifier;
+};
+
+/// @brief  Create an ExecutionEngine which takes ownership of the given module,
+///         registering any JITEventListeners requested by the compiler options.
+///         Listeners which are owned by the engine are destroyed with it.
+std::shared_ptr<llvm::ExecutionEngine>
+createExecutionEngine(std::unique_ptr<llvm::Module> module, const CompilerOptions& options)
+{
+    std::string error;
+    std::unique_ptr<llvm::ExecutionEngine>
+        engine(llvm::EngineBuilder(std::move(module))
+            .setErrorStr(&error)
+            .setMAttrs(targetFeatures())
+            .create());
+
+    if (!engine) {
+        OPENVDB_THROW(AXExecutionError, "Failed to create ExecutionEngine: " + error);
+    }
+
+    if (options.gdbRegistration) {
+        // the GDB listener is a managed static and is not owned
+        engine->RegisterJITEventListener(llvm::JITEventListener::createGDBRegistrationListener());
+    }
+
+    if (!options.perfMap || PerfMapListener::filename().empty()) {
+        return std::shared_ptr<llvm::ExecutionEngine>(engine.release());
+    }
+
+    static tbb::atomic<size_t> sCompilationCount;
+    const std::string identifier = !options.identifier.empty() ? options.identifier :
+        "ax_" + std::to_string(sCompilationCount.fetch_and_increment());
+
+    std::shared_ptr<PerfMapListener> listener(new PerfMapListener(identifier));
+    engine->RegisterJITEventListener(listener.get());
+
+    return std::shared_ptr<llvm::ExecutionEngine>(engine.release(),
+        [listener](llvm::ExecutionEngine* ptr) { delete ptr; });
+}
+
 template <typename RegistryT>
 inline typename RegistryT::Ptr
 registerAccesses(const codegen::SymbolTable& globals, const ast::Tree& tree)
@@ -506,7 +854,9 @@ public:
                   const FunctionOptions& options,
                   codegen::SymbolTable& globals,
                   codegen::FunctionRegistry& functionRegistry,
-                  std::vector<std::string>* warnings)
+                  std::vector<std::string>* warnings,
+                  Profiler* profiler = nullptr,
+                  PhaseListener* listener = nullptr)
     {
         ModifyVolumeAssignments modifier;
         int volumeCount = 0;
@@ -516,18 +866,32 @@ public:
 
             openvdb::SharedPtr<ast::Tree> tree(syntaxTree.copy());
 
-            tree->accept(modifier);
+            {
+                ScopedPhase phase(listener, "modify ModifyVolumeAssignments");
+                tree->accept(modifier);
+            }
 
             const std::string funcName("compute_volume_" + std::to_string(volumeCount));
+            ScopedPhase phase(listener, "codegen " + funcName);
+
             codegen::VolumeComputeGenerator
                 codeGenerator(module, &customData, options, functionRegistry, warnings, funcName);
+            codeGenerator.setProfiler(profiler);
             tree->accept(codeGenerator);
 
             mBlockFunctionNames.push_back(std::vector<std::string>());
             codeGenerator.getFunctionList(mBlockFunctionNames.back());
 
-            if (globals.map().empty() && !codeGenerator.globals().map().empty()) {
-                globals = codeGenerator.globals();
+            // a block may access volumes which no earlier block accesses, so collect the
+            // globals of every block and record the volumes accessed by this one
+
+            mBlockAccesses.push_back(std::set<std::string>());
+            std::string name, type;
+            for (const auto& global : codeGenerator.globals().map()) {
+                if (!globals.exists(global.first)) globals.insert(global.first, global.second);
+                if (codegen::isGlobalAttributeAccess(global.first, name, type)) {
+                    mBlockAccesses.back().insert(global.first);
+                }
             }
 
             // increment "initial"/"base" volume assignment if we found another assignment
@@ -578,13 +942,41 @@ public:
         return mBlockFunctionAddresses;
     }
 
+    /// Returns the registry indices of the volumes accessed by each block, in ascending order
+    std::vector<std::vector<size_t>> accessesForAllBlocks(const VolumeRegistry& registry) const
+    {
+        const VolumeRegistry::VolumeDataVec& volumeData = registry.volumeData();
+        std::vector<std::vector<size_t>> accesses(mVolumesAssigned.size());
+
+        for (size_t i = 0; i < accesses.size(); ++i) {
+            for (size_t index = 0; index < volumeData.size(); ++index) {
+                const std::string token =
+                    codegen::getGlobalAttributeAccess(volumeData[index].mName, volumeData[index].mType);
+                if (mBlockAccesses[i].count(token)) accesses[i].emplace_back(index);
+            }
+        }
+
+        return accesses;
+    }
+
 private:
     std::vector<std::vector<std::string> > mBlockFunctionNames;
+    std::vector<std::set<std::string>> mBlockAccesses;
     std::vector<std::map<std::string, uint64_t> > mBlockFunctionAddresses;
     std::vector<std::string> mVolumesAssigned;
 };
 
 
+/// @brief  Returns whether a syntax tree calls any of the scatter functions, which
+///         write values into grids once the code has been executed
+inline bool scattersValues(const ast::Tree& syntaxTree)
+{
+    for (const std::string name : { "scatter", "scatteradd", "scattermax", "scattermin" }) {
+        if (ast::callsFunction(syntaxTree, name)) return true;
+    }
+    return false;
+}
+
 struct PointDefaultModifier : public openvdb::ax::ast::Modifier
 {
     PointDefaultModifier() = default;
@@ -643,9 +1035,14 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
                                    const CustomData::Ptr& data,
                                    std::vector<std::string>* warnings)
 {
+    PhaseListener* const listener = mCompilerOptions.phaseListener.get();
+
     openvdb::SharedPtr<ast::Tree> tree(syntaxTree.copy());
-    PointDefaultModifier modifier;
-    tree->accept(modifier);
+    {
+        ScopedPhase phase(listener, "modify PointDefaultModifier");
+        PointDefaultModifier modifier;
+        tree->accept(modifier);
+    }
 
     // verify the attributes requested in the syntax tree only have a single type
     // note that the executer
@@ -677,12 +1074,22 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
     codegen::PointComputeGenerator
         codeGenerator(*module, data.get(), mCompilerOptions.functionOptions,
             *mFunctionRegistry, warnings);
-    tree->accept(codeGenerator);
 
-    // map accesses (always do this prior to optimising as globals may be removed)
+    Profiler::Ptr profiler;
+    if (mCompilerOptions.profile) {
+        profiler.reset(new Profiler);
+        codeGenerator.setProfiler(profiler.get());
+    }
+
+    AttributeRegistry::Ptr registry;
+    {
+        ScopedPhase phase(listener, "codegen");
+        tree->accept(codeGenerator);
 
-    AttributeRegistry::Ptr registry =
-        registerAccesses<AttributeRegistry>(codeGenerator.globals(), *tree);
+        // map accesses (always do this prior to optimising as globals may be removed)
+
+        registry = registerAccesses<AttributeRegistry>(codeGenerator.globals(), *tree);
+    }
 
     // as P is accessed specially and not accessed via a global, need to add it to the registry
 
@@ -694,27 +1101,39 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
 
     // get module, verify and create execution engine
     llvm::Module* modulePtr = module.get();
-    optimiseAndVerify(modulePtr, mCompilerOptions.verify, mCompilerOptions.optLevel);
+    if (mCompilerOptions.irOutput) printModule(*modulePtr, *mCompilerOptions.irOutput);
+
+    {
+        ScopedPhase phase(listener, "optimise");
+        optimiseAndVerify(modulePtr, mCompilerOptions.verify, mCompilerOptions.optLevel,
+            mCompilerOptions.optimisationRemarks ? warnings : nullptr, listener);
+    }
+
+    if (mCompilerOptions.optimisedIROutput) {
+        printModule(*modulePtr, *mCompilerOptions.optimisedIROutput);
+    }
+    if (mCompilerOptions.assemblyOutput) {
+        printAssembly(*modulePtr, *mCompilerOptions.assemblyOutput);
+    }
+
+    ScopedPhase jitPhase(listener, "jit");
 
     // create the llvm execution engine which will build our function pointers
 
-    std::string error;
     std::shared_ptr<llvm::ExecutionEngine>
-        executionEngine(llvm::EngineBuilder(std::move(module))
-            .setErrorStr(&error)
-            .create());
-
-    if (!executionEngine) {
-        OPENVDB_THROW(AXExecutionError, "Failed to create ExecutionEngine: " + error);
-    }
+        executionEngine(createExecutionEngine(std::move(module), mCompilerOptions));
 
     // map functions
 
     initializeGlobalFunctions(*mFunctionRegistry, *executionEngine, *modulePtr);
+    initializeProfileFunction(*executionEngine, *modulePtr);
 
     // finalize mapping
 
-    executionEngine->finalizeObject();
+    {
+        ScopedPhase phase(listener, "jit finalize");
+        executionEngine->finalizeObject();
+    }
 
     // get the built function pointers
 
@@ -733,7 +1152,7 @@ Compiler::compile<PointExecutable>(const ast::Tree& syntaxTree,
 
     // create final executable object
     PointExecutable::Ptr executable(new PointExecutable(executionEngine, mContext, registry, data,
-        functionMap));
+        functionMap, profiler, mCompilerOptions.phaseListener));
     return executable;
 }
 
@@ -750,36 +1169,57 @@ Compiler::compile<VolumeExecutable>(const ast::Tree& syntaxTree,
     VolumeCodeBlocks volumeCodeBlocks;
     codegen::SymbolTable globals;
 
-    volumeCodeBlocks.compileBlocks(syntaxTree, *customData, *module,
-        mCompilerOptions.functionOptions, globals, *mFunctionRegistry, warnings);
+    Profiler::Ptr profiler;
+    if (mCompilerOptions.profile) profiler.reset(new Profiler);
 
-    // map accesses (always do this prior to optimising as globals may be removed)
+    PhaseListener* const listener = mCompilerOptions.phaseListener.get();
 
-    const VolumeRegistry::Ptr registry =
-        registerAccesses<VolumeRegistry>(globals, syntaxTree);
+    VolumeRegistry::Ptr registry;
+    {
+        ScopedPhase phase(listener, "codegen");
+        volumeCodeBlocks.compileBlocks(syntaxTree, *customData, *module,
+            mCompilerOptions.functionOptions, globals, *mFunctionRegistry, warnings,
+            profiler.get(), listener);
+
+        // map accesses (always do this prior to optimising as globals may be removed)
+
+        registry = registerAccesses<VolumeRegistry>(globals, syntaxTree);
+    }
 
 
     llvm::Module* modulePtr = module.get();
-    optimiseAndVerify(modulePtr, mCompilerOptions.verify, mCompilerOptions.optLevel);
+    if (mCompilerOptions.irOutput) printModule(*modulePtr, *mCompilerOptions.irOutput);
 
-    std::string error;
-    std::shared_ptr<llvm::ExecutionEngine>
-        executionEngine(llvm::EngineBuilder(std::move(module))
-            .setErrorStr(&error)
-            .create());
+    {
+        ScopedPhase phase(listener, "optimise");
+        optimiseAndVerify(modulePtr, mCompilerOptions.verify, mCompilerOptions.optLevel,
+            mCompilerOptions.optimisationRemarks ? warnings : nullptr, listener);
+    }
 
-    if (!executionEngine) {
-        OPENVDB_THROW(AXExecutionError, "Failed to create ExecutionEngine: " + error);
+    if (mCompilerOptions.optimisedIROutput) {
+        printModule(*modulePtr, *mCompilerOptions.optimisedIROutput);
+    }
+    if (mCompilerOptions.assemblyOutput) {
+        printAssembly(*modulePtr, *mCompilerOptions.assemblyOutput);
     }
 
+    ScopedPhase jitPhase(listener, "jit");
+
+    std::shared_ptr<llvm::ExecutionEngine>
+        executionEngine(createExecutionEngine(std::move(module), mCompilerOptions));
+
     // map functions
 
     initializeGlobalFunctions(*mFunctionRegistry, *executionEngine,
         *modulePtr);
+    initializeProfileFunction(*executionEngine, *modulePtr);
 
     // finalize mapping
 
-    executionEngine->finalizeObject();
+    {
+        ScopedPhase phase(listener, "jit finalize");
+        executionEngine->finalizeObject();
+    }
 
     volumeCodeBlocks.generateLLVMFunctions(*executionEngine);
     std::vector<std::string> volumesAssigned;
@@ -788,7 +1228,10 @@ Compiler::compile<VolumeExecutable>(const ast::Tree& syntaxTree,
     // create final executable object
     VolumeExecutable::Ptr
         executable(new VolumeExecutable(executionEngine, mContext, registry, customData,
-            volumeCodeBlocks.functionsForAllBlocks(), volumesAssigned));
+            volumeCodeBlocks.functionsForAllBlocks(), volumesAssigned,
+            volumeCodeBlocks.accessesForAllBlocks(*registry), profiler,
+            mCompilerOptions.phaseListener, mCompilerOptions.leafOrder,
+            scattersValues(syntaxTree)));
     return executable;
 }
 
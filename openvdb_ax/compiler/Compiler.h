@@ -127,7 +127,11 @@ public:
             const CustomData::Ptr& data,
             std::vector<std::string>* compilerErrors = nullptr)
     {
-        ast::Tree::Ptr syntaxTree = mParser(code.c_str());
+        ast::Tree::Ptr syntaxTree;
+        {
+            ScopedPhase phase(mCompilerOptions.phaseListener.get(), "parse");
+            syntaxTree = mParser(code.c_str());
+        }
         return compile<ExecutableT>(*syntaxTree, data, compilerErrors);
     }
 
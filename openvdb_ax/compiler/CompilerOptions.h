@@ -31,8 +31,13 @@
 #ifndef OPENVDB_AX_COMPILER_COMPILER_OPTIONS_HAS_BEEN_INCLUDED
 #define OPENVDB_AX_COMPILER_COMPILER_OPTIONS_HAS_BEEN_INCLUDED
 
+#include <openvdb_ax/compiler/PhaseListener.h>
+
 #include <openvdb/openvdb.h>
 
+#include <ostream>
+#include <string>
+
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
 namespace OPENVDB_VERSION_NAME {
@@ -68,11 +73,52 @@ struct CompilerOptions
         O3  // Optimization level 3. Similar to clang -O3
     };
 
+    /// @brief Controls the order in which compiled volume code executes the leaf nodes
+    ///        of the volume it writes to
+    enum class LeafOrder
+    {
+        TREE, // Execute leaf nodes in the order of tree iteration
+        MORTON // Execute leaf nodes along a Morton (Z-order) curve of their origins,
+               // prefetching the values of the next leaf node of every accessed volume
+    };
+
     OptLevel optLevel = OptLevel::O3;
+    LeafOrder leafOrder = LeafOrder::TREE;
 
     /// @brief If this flag is true, the generated llvm module will be verified when compilation
     ///        occurs, resulting in an exception being thrown if it is not valid
     bool verify = true;
+    /// @brief If this flag is true, optimisation remarks (passed, missed and analysis) from
+    ///        the loop vectorizer, SLP vectorizer, inliner and LICM passes are collected
+    ///        during optimisation and appended to the warnings provided to compile()
+    bool optimisationRemarks = false;
+    /// @brief Optional streams which, if provided, receive the generated llvm IR prior to
+    ///        optimisation, the llvm IR after optimisation and the native assembly of the
+    ///        optimised module for the host target used by the JIT. These are primarily
+    ///        for debugging and performance investigation of compiled code.
+    std::ostream* irOutput = nullptr;
+    std::ostream* optimisedIROutput = nullptr;
+    std::ostream* assemblyOutput = nullptr;
+    /// @brief If this flag is true, the symbols of JIT compiled functions are appended to
+    ///        the perf map file /tmp/perf-<pid>.map so that they can be resolved by Linux
+    ///        profilers such as perf. Has no effect on other platforms.
+    bool perfMap = false;
+    /// @brief If this flag is true, JIT compiled objects are registered with GDB through
+    ///        its JIT compilation interface.
+    bool gdbRegistration = false;
+    /// @brief An identifier for the compiled code which is used to prefix registered JIT
+    ///        symbol names, i.e. <identifier>::compute_point. If empty, a unique identifier
+    ///        of the form ax_<n> is generated per compilation.
+    std::string identifier = "";
+    /// @brief If this flag is true, the generated code is instrumented with counters
+    ///        which record the invocation and cycle counts of every top level statement
+    ///        and function call. The counters are accessible through the profiler()
+    ///        method of the compiled executable.
+    bool profile = false;
+    /// @brief An optional listener which is notified as compilation enters and leaves
+    ///        the "parse", "codegen", "optimise" and "jit" phases. The listener is also
+    ///        passed to the compiled executable which reports the "execute" phase.
+    PhaseListener::Ptr phaseListener = nullptr;
     /// @brief Options for the function registry
     FunctionOptions functionOptions = FunctionOptions();
 };
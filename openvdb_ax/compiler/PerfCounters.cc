@@ -0,0 +1,345 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "PerfCounters.h"
+
+#include <cassert>
+#include <iomanip>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring> // memset
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+namespace {
+
+using Values = std::array<uint64_t, PerfCounters::NUM_EVENTS>;
+
+#if defined(__x86_64__) && defined(__GNUC__)
+/// @brief  Returns true if the host is an Intel core from Broadwell onwards, which
+///         all implement the FP_ARITH_INST_RETIRED event. Hybrid processors are
+///         excluded as their cores expose separate performance monitoring units.
+bool hasFpArithEvent()
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__builtin_cpu_is("intel") || !__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+
+    const unsigned int family = (eax >> 8) & 0xF;
+    if (family != 6) return false;
+    const unsigned int model = ((eax >> 12) & 0xF0) | ((eax >> 4) & 0xF);
+
+    switch (model) {
+        case 0x3D : case 0x47 : case 0x4F : case 0x56 : // broadwell
+        case 0x4E : case 0x5E : case 0x55 :             // skylake, cascade lake
+        case 0x8E : case 0x9E : case 0xA5 : case 0xA6 : // kaby, coffee, comet lake
+        case 0x66 : case 0xA7 :                         // cannon, rocket lake
+        case 0x6A : case 0x6C : case 0x7D : case 0x7E : // ice lake
+        case 0x8C : case 0x8D :                         // tiger lake
+        case 0x8F : case 0xCF :                         // sapphire, emerald rapids
+            return true;
+        default :
+            return false;
+    }
+}
+#endif
+
+/// @brief  Open a counter of the given event for the calling thread on any cpu in
+///         the group of the leader, or as the leader if it is -1, returning its file
+///         descriptor or -1 if the event is not available
+int openCounter(const PerfCounters::Event event, const int leader)
+{
+#if defined(__linux__)
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(perf_event_attr));
+    attr.size = sizeof(perf_event_attr);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP |
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (event) {
+        case PerfCounters::CYCLES :
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfCounters::INSTRUCTIONS :
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfCounters::CACHE_MISSES :
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfCounters::BRANCH_MISSES :
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfCounters::SIMD_INSTRUCTIONS :
+#if defined(__x86_64__) && defined(__GNUC__)
+            // FP_ARITH_INST_RETIRED with the umask of all 128, 256 and 512 bit
+            // packed single and double precision instructions. The raw encoding
+            // is model specific so is only used where it is known to be valid
+            static const bool fpArith = hasFpArithEvent();
+            if (!fpArith) return -1;
+            attr.type = PERF_TYPE_RAW;
+            attr.config = 0xFCC7;
+            break;
+#else
+            return -1;
+#endif
+        default :
+            return -1;
+    }
+
+    // pid 0 and cpu -1 counts the calling thread on any cpu
+    const long fd = syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+    return static_cast<int>(fd);
+#else
+    (void)event;
+    (void)leader;
+    return -1;
+#endif
+}
+
+void closeCounter(const int fd)
+{
+#if defined(__linux__)
+    if (fd >= 0) close(fd);
+#else
+    (void)fd;
+#endif
+}
+
+/// @brief  The counters of all available events, opened as a single group so that
+///         they are always scheduled onto the hardware together and so count over
+///         the same intervals. The first available event leads the group.
+struct CounterGroup
+{
+    CounterGroup()
+    {
+        mFds.fill(-1);
+        for (size_t i = 0; i < PerfCounters::NUM_EVENTS; ++i) {
+            const int leader = mOrder.empty() ? -1 : mFds[mOrder.front()];
+            mFds[i] = openCounter(static_cast<PerfCounters::Event>(i), leader);
+            if (mFds[i] >= 0) mOrder.emplace_back(i);
+        }
+    }
+
+    ~CounterGroup()
+    {
+        // close the members before the leader
+        for (auto iter = mOrder.rbegin(); iter != mOrder.rend(); ++iter) {
+            closeCounter(mFds[*iter]);
+        }
+    }
+
+    bool available(const size_t event) const { return mFds[event] >= 0; }
+
+    /// @brief  Read the values of all events, scaled by the fraction of the time the
+    ///         group was enabled for which it was running. Should the kernel have had
+    ///         to multiplex the group with other counters this estimates the counts
+    ///         over the whole time. Unavailable events read as zero.
+    void read(Values& values) const
+    {
+        values.fill(0);
+#if defined(__linux__)
+        if (mOrder.empty()) return;
+
+        // nr, time enabled, time running, then the value of each member in the
+        // order they were added to the group
+        std::array<uint64_t, 3 + PerfCounters::NUM_EVENTS> data;
+        const ssize_t size = (3 + mOrder.size()) * sizeof(uint64_t);
+        if (::read(mFds[mOrder.front()], data.data(), size) != size) return;
+
+        const uint64_t enabled = data[1], running = data[2];
+        if (running == 0) return;
+        const double scale = double(enabled) / double(running);
+
+        for (size_t i = 0; i < mOrder.size(); ++i) {
+            values[mOrder[i]] = static_cast<uint64_t>(double(data[3 + i]) * scale);
+        }
+#endif
+    }
+
+    std::array<int, PerfCounters::NUM_EVENTS> mFds;
+    // the available events in the order they were added to the group
+    std::vector<size_t> mOrder;
+};
+
+}
+
+/// @brief  The counters of a single thread. These are only ever accessed by the
+///         thread which created them, other than when reporting.
+struct PerfCounters::ThreadCounters
+{
+    void read(Values& values) const { mGroup.read(values); }
+
+    CounterGroup mGroup;
+    // the counter values at the beginning of each active phase, innermost last
+    std::vector<Values> mStack;
+    std::map<std::string, Counts> mCounts;
+};
+
+PerfCounters::PerfCounters()
+    : mThreadCounters() {}
+
+PerfCounters::~PerfCounters() = default;
+
+const char* PerfCounters::eventName(const Event event)
+{
+    switch (event) {
+        case CYCLES            : return "cycles";
+        case INSTRUCTIONS      : return "instructions";
+        case CACHE_MISSES      : return "cache misses";
+        case BRANCH_MISSES     : return "branch misses";
+        case SIMD_INSTRUCTIONS : return "simd instructions";
+        default                : return "unknown";
+    }
+}
+
+bool PerfCounters::supported(const Event event)
+{
+    static const std::array<bool, NUM_EVENTS> available = []() {
+        const CounterGroup group;
+        std::array<bool, NUM_EVENTS> result;
+        for (size_t i = 0; i < NUM_EVENTS; ++i) {
+            result[i] = group.available(i);
+        }
+        return result;
+    }();
+
+    return event < NUM_EVENTS && available[event];
+}
+
+void PerfCounters::begin(const std::string&)
+{
+    std::shared_ptr<ThreadCounters>& counters = mThreadCounters.local();
+    if (!counters) counters.reset(new ThreadCounters);
+
+    counters->mStack.emplace_back();
+    counters->read(counters->mStack.back());
+}
+
+void PerfCounters::end(const std::string& phase)
+{
+    Values values;
+    ThreadCounters& counters = *mThreadCounters.local();
+    counters.read(values);
+
+    assert(!counters.mStack.empty());
+    const Values& start = counters.mStack.back();
+
+    Counts& counts = counters.mCounts[phase];
+    for (size_t i = 0; i < NUM_EVENTS; ++i) {
+        counts.mValues[i] += values[i] - start[i];
+    }
+    ++counts.mInvocations;
+    counts.mThreads = 1;
+
+    counters.mStack.pop_back();
+}
+
+std::map<std::string, PerfCounters::Counts> PerfCounters::report() const
+{
+    std::map<std::string, Counts> result;
+    for (const std::shared_ptr<ThreadCounters>& counters : mThreadCounters) {
+        if (!counters) continue;
+        for (const auto& iter : counters->mCounts) {
+            Counts& counts = result[iter.first];
+            for (size_t i = 0; i < NUM_EVENTS; ++i) {
+                counts.mValues[i] += iter.second.mValues[i];
+            }
+            counts.mInvocations += iter.second.mInvocations;
+            counts.mThreads += iter.second.mThreads;
+        }
+    }
+    return result;
+}
+
+void PerfCounters::clear()
+{
+    for (std::shared_ptr<ThreadCounters>& counters : mThreadCounters) {
+        if (counters) counters->mCounts.clear();
+    }
+}
+
+void PerfCounters::print(std::ostream& os) const
+{
+    const std::map<std::string, Counts> counts = this->report();
+
+    for (const auto& iter : counts) {
+        const Counts& phase = iter.second;
+        os << iter.first << ": " << phase.mInvocations << " invocations on "
+           << phase.mThreads << " thread(s)\n";
+
+        for (size_t i = 0; i < NUM_EVENTS; ++i) {
+            const Event event = static_cast<Event>(i);
+            os << "  " << std::setw(18) << std::left << eventName(event);
+            if (supported(event)) os << phase.mValues[i] << "\n";
+            else                  os << "unavailable\n";
+        }
+
+        const uint64_t cycles = phase.mValues[CYCLES];
+        const uint64_t instructions = phase.mValues[INSTRUCTIONS];
+        if (cycles > 0 && supported(INSTRUCTIONS)) {
+            os << "  " << std::setw(18) << std::left << "ipc"
+               << double(instructions) / double(cycles) << "\n";
+        }
+        if (instructions > 0 && supported(BRANCH_MISSES)) {
+            os << "  " << std::setw(18) << std::left << "branch mpki"
+               << 1000.0 * double(phase.mValues[BRANCH_MISSES]) / double(instructions) << "\n";
+        }
+        if (instructions > 0 && supported(CACHE_MISSES)) {
+            os << "  " << std::setw(18) << std::left << "cache mpki"
+               << 1000.0 * double(phase.mValues[CACHE_MISSES]) / double(instructions) << "\n";
+        }
+    }
+}
+
+}
+}
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file compiler/PerfCounters.h
+///
+/// @brief Contains the PerfCounters PhaseListener which samples hardware
+///        performance counters around compilation and execution phases
+///
+
+#ifndef OPENVDB_AX_COMPILER_PERF_COUNTERS_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_COMPILER_PERF_COUNTERS_HAS_BEEN_INCLUDED
+
+#include <openvdb_ax/compiler/PhaseListener.h>
+
+#include <openvdb/Types.h>
+
+#include <tbb/enumerable_thread_specific.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+/// @brief  A PhaseListener which reads the hardware performance counters of the
+///         calling thread as each phase begins and ends, accumulating the difference
+///         per phase. Counters are opened lazily on each thread with perf_event_open
+///         as a single group, so that all events count over the same intervals, and
+///         are scaled should the kernel multiplex the group with other counters. They
+///         are only available on Linux. Events which cannot be opened, for example
+///         due to the perf_event_paranoid setting, missing hardware support or when
+///         running inside a virtual machine, are silently reported as unavailable.
+/// @note   As counters are per thread, the "execute" phase only measures the thread
+///         which calls execute(). The "leaf range" phase is reported by every thread
+///         which processes leaf nodes and measures the complete kernel.
+class PerfCounters : public PhaseListener
+{
+public:
+    using Ptr = std::shared_ptr<PerfCounters>;
+
+    enum Event
+    {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        CACHE_MISSES,
+        BRANCH_MISSES,
+        // Retired packed SIMD floating point instructions. Currently only supported
+        // on known Intel processor models from Broadwell onwards
+        SIMD_INSTRUCTIONS,
+        NUM_EVENTS
+    };
+
+    /// @brief  The accumulated counters of a phase
+    struct Counts
+    {
+        Counts() : mValues(), mInvocations(0), mThreads(0) { mValues.fill(0); }
+
+        // counter values, indexed by Event. Values of unavailable events are zero
+        std::array<uint64_t, NUM_EVENTS> mValues;
+        // the number of times the phase was entered
+        uint64_t mInvocations;
+        // the number of threads which entered the phase
+        size_t mThreads;
+    };
+
+    PerfCounters();
+    ~PerfCounters() override;
+
+    /// @brief  Returns a printable name of an event
+    static const char* eventName(const Event event);
+
+    /// @brief  Returns true if the event can be counted on this host. This opens
+    ///         and closes a counter on the calling thread on first use.
+    static bool supported(const Event event);
+
+    void begin(const std::string& phase) override;
+    void end(const std::string& phase) override;
+
+    /// @brief  Returns the counters of each phase summed over all threads
+    /// @note   This must not be called whilst any phase is active
+    std::map<std::string, Counts> report() const;
+
+    /// @brief  Reset all accumulated counters
+    /// @note   This must not be called whilst any phase is active
+    void clear();
+
+    /// @brief  Print a report of all phases with their counters and derived metrics
+    /// @param  os  The stream to print to
+    void print(std::ostream& os) const;
+
+private:
+    struct ThreadCounters;
+    tbb::enumerable_thread_specific<std::shared_ptr<ThreadCounters>> mThreadCounters;
+};
+
+}
+}
+}
+
+#endif // OPENVDB_AX_COMPILER_PERF_COUNTERS_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
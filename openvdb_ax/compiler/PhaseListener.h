@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file compiler/PhaseListener.h
+///
+/// @brief Contains the PhaseListener interface which is notified of the named
+///        phases of compilation and execution, and a scoped helper which reports
+///        them
+///
+
+#ifndef OPENVDB_AX_COMPILER_PHASE_LISTENER_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_COMPILER_PHASE_LISTENER_HAS_BEEN_INCLUDED
+
+#include <openvdb/version.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+/// @brief  An interface which is notified as the Compiler and the executables enter
+///         and leave named phases, such as "codegen", "optimise", "jit" or "execute".
+///         Phases may be nested and are always ended on the thread which began them,
+///         in reverse order. Implementations may be called from multiple threads
+///         concurrently and must be thread safe.
+class PhaseListener
+{
+public:
+    using Ptr = std::shared_ptr<PhaseListener>;
+
+    virtual ~PhaseListener() = default;
+
+    /// @brief  Called when a phase begins on the calling thread
+    /// @param  phase  The name of the phase
+    virtual void begin(const std::string& phase) = 0;
+
+    /// @brief  Called when the most recently begun phase of the calling thread ends
+    /// @param  phase  The name of the phase
+    virtual void end(const std::string& phase) = 0;
+};
+
+/// @brief  A PhaseListener which forwards all phases to a list of listeners, allowing
+///         multiple listeners to observe a single compilation or execution. Phases
+///         begin in the order the listeners were added and end in reverse order.
+class PhaseListenerList : public PhaseListener
+{
+public:
+    using Ptr = std::shared_ptr<PhaseListenerList>;
+
+    /// @brief  Add a listener. Null listeners are ignored
+    inline void add(const PhaseListener::Ptr& listener)
+    {
+        if (listener) mListeners.emplace_back(listener);
+    }
+
+    void begin(const std::string& phase) override
+    {
+        for (const PhaseListener::Ptr& listener : mListeners) {
+            listener->begin(phase);
+        }
+    }
+
+    void end(const std::string& phase) override
+    {
+        for (auto iter = mListeners.rbegin(); iter != mListeners.rend(); ++iter) {
+            (*iter)->end(phase);
+        }
+    }
+
+private:
+    std::vector<PhaseListener::Ptr> mListeners;
+};
+
+/// @brief  Reports a phase to a PhaseListener for the lifetime of this object. If the
+///         listener is a null pointer, nothing is reported.
+class ScopedPhase
+{
+public:
+    ScopedPhase(PhaseListener* listener, const std::string& phase)
+        : mListener(listener)
+        , mPhase(listener ? phase : std::string())
+    {
+        if (mListener) mListener->begin(mPhase);
+    }
+
+    ~ScopedPhase() { if (mListener) mListener->end(mPhase); }
+
+private:
+    PhaseListener* const mListener;
+    const std::string mPhase;
+};
+
+}
+}
+}
+
+#endif // OPENVDB_AX_COMPILER_PHASE_LISTENER_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
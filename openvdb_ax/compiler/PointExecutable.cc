@@ -46,6 +46,11 @@
 #include <openvdb/points/PointMove.h>
 #include <openvdb/Types.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <map>
 #include <type_traits> // std::enable_if
 
 namespace openvdb {
@@ -65,27 +70,27 @@ struct PointExecuterDeformer
         const FilterT& filter)
         : mData(data)
         , mFilter(filter)
-        , mPositions(nullptr) {}
+        , mLeafData(nullptr) {}
 
     template <typename LeafT>
     void reset(const LeafT& leaf, const size_t idx)
     {
         mFilter.reset(leaf);
-        mPositions = &mData[idx]->getPositions();
+        mLeafData = mData[idx].get();
     }
 
     template <typename IterT>
     void apply(Vec3d& position, const IterT& iter) const
     {
         if (mFilter.valid(iter)) {
-            assert(mPositions);
-            position = (*mPositions)[*iter];
+            assert(mLeafData);
+            position = mLeafData->getPosition(*iter);
         }
     }
 
     std::vector<codegen::LeafLocalData::UniquePtr>& mData;
     FilterT                                         mFilter;
-    const codegen::LeafLocalData::PositionVector*   mPositions;
+    const codegen::LeafLocalData*                   mLeafData;
 };
 
 
@@ -112,9 +117,12 @@ addAttributeHandle(codegen::ComputePointFunction::Arguments& args,
                    const bool write)
 {
     if (valueType == openvdb::typeNameAsString<bool>())                     addAttributeHandleTyped<bool>(args, leaf, name, write);
+    else if (valueType == openvdb::typeNameAsString<int8_t>())              addAttributeHandleTyped<int8_t>(args, leaf, name, write);
+    else if (valueType == openvdb::typeNameAsString<uint8_t>())             addAttributeHandleTyped<uint8_t>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<int16_t>())             addAttributeHandleTyped<int16_t>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<int32_t>())             addAttributeHandleTyped<int32_t>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<int64_t>())             addAttributeHandleTyped<int64_t>(args, leaf, name, write);
+    else if (valueType == openvdb::typeNameAsString<half>())                addAttributeHandleTyped<half>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<float>())               addAttributeHandleTyped<float>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<double>())              addAttributeHandleTyped<double>(args, leaf, name, write);
     else if (valueType == openvdb::typeNameAsString<math::Vec3<int32_t>>()) addAttributeHandleTyped<math::Vec3<int32_t>>(args, leaf, name, write);
@@ -144,13 +152,19 @@ struct PointExecuterOp
                FunctionT computeFunction,
                const math::Transform& transform,
                const GroupIndex* const groupIndex,
-               std::vector<codegen::LeafLocalData::UniquePtr>& leafLocalData)
+               std::vector<codegen::LeafLocalData::UniquePtr>& leafLocalData,
+               const size_t substeps = 1,
+               const float dt = 1.0f,
+               PhaseListener* listener = nullptr)
         : mComputeFunction(computeFunction)
         , mCustomData(customData)
         , mTransform(transform)
         , mGroupIndex(groupIndex)
         , mAttributeRegistry(attributeRegistry)
-        , mLeafLocalData(leafLocalData) {}
+        , mLeafLocalData(leafLocalData)
+        , mSubsteps(substeps)
+        , mTimeStep(dt)
+        , mListener(listener) {}
 
     // UseGroup = true
     template<bool UseG>
@@ -231,12 +245,17 @@ struct PointExecuterOp
         // if we are using position we need to initialise the local storage
 
         if (UseTransform && UseGroup) {
-            GroupFilter filter(*mGroupIndex);
-            args.mLeafLocalData->initPositions<GroupFilter>(leaf, mTransform, filter);
+            args.mLeafLocalData->initPositions(leaf, mTransform, *mGroupIndex);
         }
         else if (UseTransform) args.mLeafLocalData->initPositions(leaf, mTransform);
 
-        execute<UseGroup>(leaf, args);
+        // run every substep on this leaf before moving on, so that positions written
+        // to the local storage are read back by the next substep
+
+        for (size_t substep = 0; substep < mSubsteps; ++substep) {
+            args.mLeafLocalData->setSubstep(int32_t(substep), mTimeStep);
+            execute<UseGroup>(leaf, args);
+        }
 
         // as multiple groups can be stored in a single array, attempt to compact the
         // arrays directly so that we're not trying to call compact multiple times
@@ -247,23 +266,363 @@ struct PointExecuterOp
         mLeafLocalData[idx] = std::move(args.mLeafLocalData);
     }
 
-    void operator()(const LeafManagerT::LeafRange& range) const
-    {
-        for (auto leaf = range.begin(); leaf; ++leaf) {
-            (*this)(*leaf, leaf.pos());
-        }
-    }
-
 private:
 
     FunctionT                       mComputeFunction;
     const CustomData&               mCustomData;
-    const math::Transform&          mTransform;
+    const codegen::PositionTransform mTransform;
     const GroupIndex* const         mGroupIndex;
     const AttributeRegistry&        mAttributeRegistry;
     std::vector<codegen::LeafLocalData::UniquePtr>& mLeafLocalData;
+    const size_t                    mSubsteps;
+    const float                     mTimeStep;
+    PhaseListener* const            mListener;
+};
+
+/// @brief  The per grid state of an execution over multiple grids
+struct GridExecution
+{
+    using LeafManagerT = openvdb::tree::LeafManager<openvdb::points::PointDataTree>;
+    using GroupIndex = openvdb::points::AttributeSet::Descriptor::GroupIndex;
+    using UniquePtr = std::unique_ptr<GridExecution>;
+
+    GridExecution(openvdb::points::PointDataGrid& grid)
+        : mGrid(grid)
+        , mLeafManager(grid.tree())
+        , mGroupIndex()
+        , mLeafLocalData(mLeafManager.leafCount())
+        , mGroups()
+        , mNewStrings(false) {}
+
+    openvdb::points::PointDataGrid& mGrid;
+    LeafManagerT mLeafManager;
+    GroupIndex mGroupIndex;
+    std::vector<codegen::LeafLocalData::UniquePtr> mLeafLocalData;
+    std::set<std::string> mGroups;
+    bool mNewStrings;
+};
+
+/// @brief  A leaf node of one of the grids of an execution, by the index of the grid and
+///         the index of the leaf in the grid's leaf manager
+using LeafEntry = std::pair<size_t, size_t>;
+
+/// @brief  Executes the leaf nodes of all grids in a single parallel region
+template<bool UseTransform, bool UseGroup, typename FunctionT>
+void executeLeaves(std::vector<GridExecution::UniquePtr>& grids,
+                   const std::vector<LeafEntry>& leaves,
+                   const AttributeRegistry& attributeRegistry,
+                   const CustomData& customData,
+                   FunctionT compute,
+                   const size_t substeps,
+                   const float dt,
+                   PhaseListener* listener)
+{
+    using OpT = PointExecuterOp<UseTransform, UseGroup>;
+
+    std::vector<OpT> ops;
+    ops.reserve(grids.size());
+    for (const auto& grid : grids) {
+        ops.emplace_back(attributeRegistry, customData, compute, grid->mGrid.transform(),
+            &grid->mGroupIndex, grid->mLeafLocalData, substeps, dt, listener);
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, leaves.size()),
+        [&](const tbb::blocked_range<size_t>& range) {
+            ScopedPhase phase(listener, "leaf range");
+            for (size_t n = range.begin(); n < range.end(); ++n) {
+                const LeafEntry& entry = leaves[n];
+                ops[entry.first](grids[entry.first]->mLeafManager.leaf(entry.second), entry.second);
+            }
+        });
+}
+
+/// @brief  The destination of a point relocated after its position has been written
+struct PointDestination
+{
+    // the leaf node and index the point is copied from
+    const openvdb::points::PointDataTree::LeafNodeType* mSource;
+    Index mIndex;
+    // the voxel offset and voxel local position in the destination leaf node
+    Index mVoxel;
+    openvdb::Vec3f mPosition;
 };
 
+/// @brief  The destinations of the points of a single leaf node
+struct LeafRelocation
+{
+    using LeavingT = std::pair<openvdb::Coord, PointDestination>;
+
+    LeafRelocation() : mStaying(), mLeaving(), mReordered(false) {}
+
+    // the points remaining in the leaf, in index order
+    std::vector<PointDestination> mStaying;
+    // the points moving to another leaf, keyed by the origin of that leaf
+    std::vector<LeavingT> mLeaving;
+    // whether any point has changed voxel or leaf
+    bool mReordered;
+};
+
+/// @brief  Buckets the points leaving their leaf nodes by the origin of their destination
+///         leaf node. The buckets of adjacent ranges of leaf nodes are joined in order, so
+///         that the points of each bucket are ordered by source leaf node and index.
+struct LeavingBuckets
+{
+    using BucketsT = std::map<openvdb::Coord, std::vector<PointDestination>>;
+
+    LeavingBuckets(const std::vector<LeafRelocation>& relocations)
+        : mRelocations(relocations)
+        , mBuckets() {}
+
+    LeavingBuckets(const LeavingBuckets& other, tbb::split)
+        : mRelocations(other.mRelocations)
+        , mBuckets() {}
+
+    void operator()(const tbb::blocked_range<size_t>& range)
+    {
+        for (size_t idx = range.begin(); idx < range.end(); ++idx) {
+            for (const LeafRelocation::LeavingT& leaving : mRelocations[idx].mLeaving) {
+                mBuckets[leaving.first].emplace_back(leaving.second);
+            }
+        }
+    }
+
+    void join(LeavingBuckets& rhs)
+    {
+        for (auto& bucket : rhs.mBuckets) {
+            std::vector<PointDestination>& points = mBuckets[bucket.first];
+            if (points.empty()) points.swap(bucket.second);
+            else points.insert(points.end(), bucket.second.cbegin(), bucket.second.cend());
+        }
+    }
+
+    const std::vector<LeafRelocation>& mRelocations;
+    BucketsT mBuckets;
+};
+
+/// @brief  A leaf node whose attribute arrays are rebuilt from its remaining and
+///         incoming points
+struct LeafRebuild
+{
+    using LeafNode = openvdb::points::PointDataTree::LeafNodeType;
+
+    LeafRebuild(LeafNode* leaf)
+        : mLeaf(leaf)
+        , mStaying(nullptr)
+        , mIncoming(nullptr)
+        , mAttributeSet()
+        , mOffsets() {}
+
+    LeafNode* mLeaf;
+    const std::vector<PointDestination>* mStaying;
+    const std::vector<PointDestination>* mIncoming;
+    std::unique_ptr<openvdb::points::AttributeSet> mAttributeSet;
+    std::vector<LeafNode::ValueType> mOffsets;
+};
+
+/// @brief  Builds the attribute set of a rebuilt leaf node by copying every attribute
+///         of its points from their source leaf nodes, ordered by voxel
+inline void
+rebuildAttributeSet(LeafRebuild& rebuild,
+                    const openvdb::points::AttributeSet& reference)
+{
+    using LeafNode = LeafRebuild::LeafNode;
+
+    std::vector<const PointDestination*> points;
+    points.reserve((rebuild.mStaying ? rebuild.mStaying->size() : 0) +
+        (rebuild.mIncoming ? rebuild.mIncoming->size() : 0));
+    if (rebuild.mStaying) {
+        for (const PointDestination& point : *rebuild.mStaying) points.emplace_back(&point);
+    }
+    if (rebuild.mIncoming) {
+        for (const PointDestination& point : *rebuild.mIncoming) points.emplace_back(&point);
+    }
+
+    // stable counting sort of the points by voxel, producing the new voxel offsets
+
+    std::vector<Index> counts(LeafNode::SIZE, 0);
+    for (const PointDestination* point : points) ++counts[point->mVoxel];
+
+    rebuild.mOffsets.resize(LeafNode::SIZE);
+    std::vector<Index> cursors(LeafNode::SIZE);
+    Index offset = 0;
+    for (Index n = 0; n < LeafNode::SIZE; ++n) {
+        cursors[n] = offset;
+        offset += counts[n];
+        rebuild.mOffsets[n] = offset;
+    }
+
+    std::vector<const PointDestination*> ordered(points.size());
+    for (const PointDestination* point : points) ordered[cursors[point->mVoxel]++] = point;
+
+    // copy all attributes except position, which is set from the destinations
+
+    rebuild.mAttributeSet.reset(new openvdb::points::AttributeSet(
+        reference.descriptorPtr(), Index(ordered.size())));
+
+    const size_t positionIndex = reference.find("P");
+
+    for (size_t pos = 0; pos < reference.size(); ++pos) {
+        openvdb::points::AttributeArray* array = rebuild.mAttributeSet->get(pos);
+        assert(array);
+        array->setHidden(reference.getConst(pos)->isHidden());
+        array->setTransient(reference.getConst(pos)->isTransient());
+        if (ordered.empty()) continue;
+
+        if (pos == positionIndex) {
+            openvdb::points::AttributeWriteHandle<openvdb::Vec3f> handle(*array);
+            for (size_t i = 0; i < ordered.size(); ++i) {
+                handle.set(Index(i), ordered[i]->mPosition);
+            }
+            continue;
+        }
+
+        array->expand();
+        for (size_t i = 0; i < ordered.size(); ++i) {
+            const PointDestination& point = *ordered[i];
+            array->set(Index(i), point.mSource->constAttributeArray(pos), point.mIndex);
+        }
+    }
+}
+
+/// @brief  Moves the points of a grid to the positions written by a kernel. Points which
+///         remain in their voxel are updated in place, leaf nodes whose points change
+///         voxel are rebuilt, and only points which leave their leaf node are exchanged
+///         between leaf nodes, creating any new leaf nodes required.
+///
+/// @note   Returns false without modifying the grid if an attribute is strided, in which
+///         case the grid should be moved with openvdb::points::movePoints().
+///
+bool relocatePoints(GridExecution& execution)
+{
+    using LeafNode = LeafRebuild::LeafNode;
+
+    GridExecution::LeafManagerT& manager = execution.mLeafManager;
+    if (manager.leafCount() == 0) return true;
+
+    const openvdb::points::AttributeSet& reference = manager.leaf(0).attributeSet();
+    for (size_t pos = 0; pos < reference.size(); ++pos) {
+        if (reference.getConst(pos)->stride() != 1) return false;
+    }
+
+    const codegen::PositionTransform transform(execution.mGrid.transform());
+
+    // find the destination of every point
+
+    std::vector<LeafRelocation> relocations(manager.leafCount());
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, manager.leafCount()),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t idx = range.begin(); idx < range.end(); ++idx) {
+                const LeafNode& leaf = manager.leaf(idx);
+                const codegen::LeafLocalData& data = *execution.mLeafLocalData[idx];
+                const openvdb::points::AttributeHandle<openvdb::Vec3f>
+                    position(leaf.constAttributeArray("P"));
+
+                LeafRelocation& relocation = relocations[idx];
+                relocation.mStaying.reserve(leaf.getLastValue());
+
+                Index start = 0;
+                for (Index n = 0; n < LeafNode::SIZE; ++n) {
+                    const Index end = leaf.getValue(n);
+                    for (Index i = start; i < end; ++i) {
+                        PointDestination point { &leaf, i, n, openvdb::Vec3f() };
+                        if (!data.hasPosition(i)) {
+                            point.mPosition = position.get(i);
+                            relocation.mStaying.emplace_back(point);
+                            continue;
+                        }
+
+                        const openvdb::Vec3d indexPosition =
+                            transform.worldToIndex(data.getPosition(i));
+                        const openvdb::Coord ijk = openvdb::Coord::round(indexPosition);
+                        point.mPosition = openvdb::Vec3f(indexPosition - ijk.asVec3d());
+                        point.mVoxel = LeafNode::coordToOffset(ijk);
+
+                        const openvdb::Coord origin = ijk & ~(Int32(LeafNode::DIM) - 1);
+                        if (origin == leaf.origin()) {
+                            if (point.mVoxel != n) relocation.mReordered = true;
+                            relocation.mStaying.emplace_back(point);
+                        }
+                        else {
+                            relocation.mReordered = true;
+                            relocation.mLeaving.emplace_back(origin, point);
+                        }
+                    }
+                    start = end;
+                }
+            }
+        });
+
+    // bucket the points leaving their leaf nodes by destination leaf
+
+    LeavingBuckets buckets(relocations);
+    tbb::parallel_reduce(tbb::blocked_range<size_t>(0, relocations.size()), buckets);
+    const LeavingBuckets::BucketsT& incoming = buckets.mBuckets;
+
+    std::vector<LeafRebuild> rebuilds;
+    std::vector<size_t> inPlace;
+
+    for (size_t idx = 0; idx < manager.leafCount(); ++idx) {
+        LeafNode& leaf = manager.leaf(idx);
+        const auto iter = incoming.find(leaf.origin());
+        if (!relocations[idx].mReordered && iter == incoming.end()) {
+            inPlace.emplace_back(idx);
+            continue;
+        }
+        rebuilds.emplace_back(&leaf);
+        rebuilds.back().mStaying = &relocations[idx].mStaying;
+        if (iter != incoming.end()) rebuilds.back().mIncoming = &iter->second;
+    }
+
+    // create the leaf nodes of any buckets which are destined for leaf nodes
+    // which do not yet exist
+
+    openvdb::points::PointDataTree& tree = execution.mGrid.tree();
+    for (const auto& bucket : incoming) {
+        if (tree.probeConstLeaf(bucket.first)) continue;
+        rebuilds.emplace_back(tree.touchLeaf(bucket.first));
+        rebuilds.back().mIncoming = &bucket.second;
+    }
+
+    // update the positions of leaf nodes whose points all remain in their voxels
+
+    tbb::parallel_for(size_t(0), inPlace.size(), [&](const size_t i) {
+        LeafNode& leaf = manager.leaf(inPlace[i]);
+        openvdb::points::AttributeWriteHandle<openvdb::Vec3f> handle(leaf.attributeArray("P"));
+        for (const PointDestination& point : relocations[inPlace[i]].mStaying) {
+            handle.set(point.mIndex, point.mPosition);
+        }
+    });
+
+    if (rebuilds.empty()) return true;
+
+    // build all new attribute sets before replacing any, as they are copied
+    // from the existing attribute sets of other leaf nodes
+
+    tbb::parallel_for(size_t(0), rebuilds.size(), [&](const size_t i) {
+        rebuildAttributeSet(rebuilds[i], reference);
+    });
+
+    // new leaf nodes do not yet have a descriptor, so allow mismatching descriptors
+
+    tbb::parallel_for(size_t(0), rebuilds.size(), [&](const size_t i) {
+        LeafRebuild& rebuild = rebuilds[i];
+        rebuild.mLeaf->replaceAttributeSet(rebuild.mAttributeSet.release(),
+            /*allowMismatchingDescriptors*/true);
+        rebuild.mLeaf->setOffsets(rebuild.mOffsets);
+    });
+
+    // remove the rebuilt leaf nodes which no longer hold any points. Other leaf nodes
+    // are kept, as their points may lie in inactive voxels
+
+    for (const LeafRebuild& rebuild : rebuilds) {
+        if (rebuild.mOffsets.back() != 0) continue;
+        tree.addTile(/*level*/1, rebuild.mLeaf->origin(), tree.background(), /*active*/false);
+    }
+
+    return true;
+}
+
 void appendMissingAttributes(openvdb::points::PointDataGrid& grid,
                              const AttributeRegistry::AttributeDataVec& attributes)
 {
@@ -309,27 +668,73 @@ uint64_t PointExecutable::functionAddress(const std::string &name) const
 void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
                               const std::string* const group) const
 {
-    using LeafManagerT = openvdb::tree::LeafManager<openvdb::points::PointDataTree>;
+    this->executeGrids(std::vector<openvdb::points::PointDataGrid*>{&grid}, group);
+}
 
-    const auto leafIter = grid.tree().cbeginLeaf();
-    if (!leafIter) return;
+void PointExecutable::execute(const std::vector<openvdb::points::PointDataGrid::Ptr>& grids,
+                              const std::string* const group) const
+{
+    std::vector<openvdb::points::PointDataGrid*> ptrs;
+    ptrs.reserve(grids.size());
+    for (const auto& grid : grids) {
+        if (grid) ptrs.emplace_back(grid.get());
+    }
+    this->executeGrids(ptrs, group);
+}
+
+void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
+                              const size_t substeps,
+                              const float dt,
+                              const std::string* const group) const
+{
+    if (substeps == 0) return;
+    this->executeGrids(std::vector<openvdb::points::PointDataGrid*>{&grid}, group, substeps, dt);
+}
+
+void PointExecutable::executeGrids(const std::vector<openvdb::points::PointDataGrid*>& grids,
+                                   const std::string* const group,
+                                   const size_t substeps,
+                                   const float dt) const
+{
+    using LeafManagerT = GridExecution::LeafManagerT;
+
+    // ignore empty grids, which have no descriptor
+
+    std::vector<openvdb::points::PointDataGrid*> targets;
+    for (openvdb::points::PointDataGrid* grid : grids) {
+        if (grid->tree().cbeginLeaf()) targets.emplace_back(grid);
+    }
+    if (targets.empty()) return;
+
+    ScopedPhase phase(mPhaseListener.get(), "execute");
 
     // create any missing attributes
 
-    appendMissingAttributes(grid, mAttributeRegistry->attributeData());
+    tbb::parallel_for(size_t(0), targets.size(), [&](const size_t i) {
+        appendMissingAttributes(*targets[i], mAttributeRegistry->attributeData());
+    });
 
     const bool usingPosition = mAttributeRegistry->isAttributeRegistered("P");
     const bool usingGroup(static_cast<bool>(group) ? !group->empty() : false);
-    const math::Transform& transform = grid.transform();
 
-    openvdb::points::AttributeSet::Descriptor::GroupIndex groupIndex;
-    if (usingGroup) {
-        groupIndex = leafIter->attributeSet().groupIndex(*group);
+    std::vector<GridExecution::UniquePtr> executions;
+    std::vector<LeafEntry> leaves;
+    executions.reserve(targets.size());
+
+    for (openvdb::points::PointDataGrid* grid : targets) {
+        GridExecution::UniquePtr execution(new GridExecution(*grid));
+        if (usingGroup) {
+            execution->mGroupIndex =
+                grid->tree().cbeginLeaf()->attributeSet().groupIndex(*group);
+        }
+        for (size_t i = 0; i < execution->mLeafManager.leafCount(); ++i) {
+            leaves.emplace_back(executions.size(), i);
+        }
+        executions.emplace_back(std::move(execution));
     }
 
-    LeafManagerT leafManager(grid.tree());
+    std::unique_ptr<ScopedPhase> kernelPhase(new ScopedPhase(mPhaseListener.get(), "kernel"));
 
-    std::vector<codegen::LeafLocalData::UniquePtr> leafLocalData(leafManager.leafCount());
     if (!usingGroup) {
 
         using FunctionType = codegen::ComputePointRangeFunction;
@@ -343,16 +748,12 @@ void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
         }
 
         if(!usingPosition) {
-            PointExecuterOp</*UseTransform*/false, /*UseGroup*/false>
-                executerOp(*mAttributeRegistry, *mCustomData, compute, transform, &groupIndex,
-                    leafLocalData);
-            leafManager.foreach(executerOp);
+            executeLeaves</*UseTransform*/false, /*UseGroup*/false>(executions, leaves,
+                *mAttributeRegistry, *mCustomData, compute, substeps, dt, mPhaseListener.get());
         }
         else {
-            PointExecuterOp</*UseTransform*/true, /*UseGroup*/false>
-                executerOp(*mAttributeRegistry, *mCustomData, compute, transform, &groupIndex,
-                    leafLocalData);
-            leafManager.foreach(executerOp);
+            executeLeaves</*UseTransform*/true, /*UseGroup*/false>(executions, leaves,
+                *mAttributeRegistry, *mCustomData, compute, substeps, dt, mPhaseListener.get());
         }
     }
     else {
@@ -368,31 +769,29 @@ void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
         }
 
         if (!usingPosition && usingGroup) {
-            PointExecuterOp</*UseTransform*/false, /*UseGroup*/true>
-                executerOp(*mAttributeRegistry, *mCustomData, compute, transform, &groupIndex,
-                    leafLocalData);
-            leafManager.foreach(executerOp);
+            executeLeaves</*UseTransform*/false, /*UseGroup*/true>(executions, leaves,
+                *mAttributeRegistry, *mCustomData, compute, substeps, dt, mPhaseListener.get());
         }
         else {
             // usingGroup && usingPosition
-            PointExecuterOp</*UseTransform*/true, /*UseGroup*/true>
-                executerOp(*mAttributeRegistry, *mCustomData, compute, transform, &groupIndex,
-                    leafLocalData);
-            leafManager.foreach(executerOp);
+            executeLeaves</*UseTransform*/true, /*UseGroup*/true>(executions, leaves,
+                *mAttributeRegistry, *mCustomData, compute, substeps, dt, mPhaseListener.get());
         }
     }
 
-    // Check to see if any new data has been added and apply it accordingly
+    kernelPhase.reset();
 
-    std::set<std::string> groups;
-    bool newStrings = false;
+    // Check to see if any new data has been added and apply it accordingly
 
     {
-        points::StringMetaInserter
-            inserter(leafIter->attributeSet().descriptorPtr()->getMetadata());
-        for (const auto& data : leafLocalData) {
-            data->getGroups(groups);
-            newStrings |= data->insertNewStrings(inserter);
+        ScopedPhase phase(mPhaseListener.get(), "string merge");
+        for (const auto& execution : executions) {
+            points::StringMetaInserter inserter(execution->mGrid.tree().cbeginLeaf()->
+                attributeSet().descriptorPtr()->getMetadata());
+            for (const auto& data : execution->mLeafLocalData) {
+                data->getGroups(execution->mGroups);
+                execution->mNewStrings |= data->insertNewStrings(inserter);
+            }
         }
     }
 
@@ -400,16 +799,27 @@ void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
     // @todo  We should just be able to steal the arrays and compact
     // groups but the API for this isn't very nice at the moment
 
-    for (const auto& name : groups) {
-        points::appendGroup(grid.tree(), name);
-    }
+    std::unique_ptr<ScopedPhase> mergePhase(new ScopedPhase(mPhaseListener.get(), "group merge"));
+
+    tbb::parallel_for(size_t(0), executions.size(), [&](const size_t i) {
+        for (const auto& name : executions[i]->mGroups) {
+            points::appendGroup(executions[i]->mGrid.tree(), name);
+        }
+    });
+
+    // add new groups and set strings, over the leaf nodes of all grids at once
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, leaves.size()),
+        [&](const tbb::blocked_range<size_t>& range) {
 
-    // add new groups and set strings
+        for (size_t n = range.begin(); n < range.end(); ++n) {
 
-    leafManager.foreach(
-        [&groups, &leafLocalData, newStrings] (LeafManagerT::LeafNodeType& leaf, size_t idx) {
+            GridExecution& execution = *executions[leaves[n].first];
+            const std::set<std::string>& groups = execution.mGroups;
+            const size_t idx = leaves[n].second;
 
-            codegen::LeafLocalData::UniquePtr& data = leafLocalData[idx];
+            LeafManagerT::LeafNodeType& leaf = execution.mLeafManager.leaf(idx);
+            codegen::LeafLocalData::UniquePtr& data = execution.mLeafLocalData[idx];
 
             for (const auto& name : groups) {
 
@@ -433,7 +843,7 @@ void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
                 }
             }
 
-            if (newStrings) {
+            if (execution.mNewStrings) {
                 const MetaMap& metadata = leaf.attributeSet().descriptor().getMetadata();
                 const codegen::LeafLocalData::StringArrayMap& stringArrayMap = data->getStringArrayMap();
 
@@ -446,19 +856,29 @@ void PointExecutable::execute(openvdb::points::PointDataGrid& grid,
                     }
                 }
             }
+        }
     });
 
+    mergePhase.reset();
+
     if (mAttributeRegistry->isAttributeWritable("P")) {
-        if (usingGroup) {
-            openvdb::points::GroupFilter filter(groupIndex);
-            PointExecuterDeformer<openvdb::points::GroupFilter> deformer(leafLocalData, filter);
-            openvdb::points::movePoints(grid, deformer);
-        }
-        else {
-            openvdb::points::NullFilter nullFilter;
-            PointExecuterDeformer<openvdb::points::NullFilter> deformer(leafLocalData, nullFilter);
-            openvdb::points::movePoints(grid, deformer);
-        }
+        ScopedPhase phase(mPhaseListener.get(), "movePoints");
+        tbb::parallel_for(size_t(0), executions.size(), [&](const size_t i) {
+            GridExecution& execution = *executions[i];
+            if (relocatePoints(execution)) return;
+            if (usingGroup) {
+                openvdb::points::GroupFilter filter(execution.mGroupIndex);
+                PointExecuterDeformer<openvdb::points::GroupFilter>
+                    deformer(execution.mLeafLocalData, filter);
+                openvdb::points::movePoints(execution.mGrid, deformer);
+            }
+            else {
+                openvdb::points::NullFilter nullFilter;
+                PointExecuterDeformer<openvdb::points::NullFilter>
+                    deformer(execution.mLeafLocalData, nullFilter);
+                openvdb::points::movePoints(execution.mGrid, deformer);
+            }
+        });
     }
 }
 
@@ -39,6 +39,8 @@
 #define OPENVDB_AX_COMPILER_POINT_EXECUTABLE_HAS_BEEN_INCLUDED
 
 #include <openvdb_ax/compiler/CustomData.h>
+#include <openvdb_ax/compiler/PhaseListener.h>
+#include <openvdb_ax/compiler/Profiler.h>
 #include <openvdb_ax/compiler/TargetRegistry.h>
 
 #include <openvdb/openvdb.h>
@@ -75,18 +77,25 @@ public:
     ///        used to retrieve external data from within the AX code
     /// @param functions A map of function names to physical memory addresses which were built
     ///        by llvm using exeEngine
+    /// @param profiler Optional profiler which the compiled code records to, if it was
+    ///        compiled with CompilerOptions::profile
+    /// @param listener Optional listener which is notified of the "execute" phase
     /// @note  This object is normally be constructed by the Compiler::compile method, rather
     ///        than directly
     PointExecutable(const std::shared_ptr<const llvm::ExecutionEngine>& exeEngine,
                     const std::shared_ptr<const llvm::LLVMContext>& context,
                     const Registry::ConstPtr& attributeRegistry,
                     const CustomData::Ptr& customData,
-                    const std::map<std::string, uint64_t>& functions)
+                    const std::map<std::string, uint64_t>& functions,
+                    const Profiler::Ptr& profiler = Profiler::Ptr(),
+                    const PhaseListener::Ptr& listener = PhaseListener::Ptr())
         : mExecutionEngine(exeEngine)
         , mContext(context)
         , mAttributeRegistry(attributeRegistry)
         , mCustomData(customData)
-        , mFunctionAddresses(functions) {}
+        , mFunctionAddresses(functions)
+        , mProfiler(profiler)
+        , mPhaseListener(listener) {}
 
     ~PointExecutable() = default;
 
@@ -97,11 +106,51 @@ public:
     void execute(points::PointDataGrid& grid,
                  const std::string* const group = nullptr) const;
 
+    /// @brief executes compiled AX code on a collection of target grids at once
+    /// @details The leaf nodes of all grids are executed in a single parallel region and
+    ///          the appending of attributes and groups and the moving of points are
+    ///          batched across grids, so that many small grids are processed as
+    ///          efficiently as one large grid
+    /// @param grids Grids to apply code to
+    /// @param group Optional name of a group for filtering.  If this is not NULL,
+    ///        the code will only be applied to points in this group
+    void execute(const std::vector<points::PointDataGrid::Ptr>& grids,
+                 const std::string* const group = nullptr) const;
+
+    /// @brief executes compiled AX code on target grid a number of times in succession,
+    ///        as substeps of a single execution
+    /// @details Every substep is run on a leaf node before moving on to the next leaf node.
+    ///          Positions written by a substep are read back by the next substep, and the
+    ///          points are only moved, and new groups and strings only merged, once after
+    ///          the last substep. The index of the substep and the time step are available
+    ///          to the AX code through the substep() and dt() functions.
+    /// @param grid Grid to apply code to
+    /// @param substeps The number of times to execute the code. Nothing is executed if this
+    ///        is zero
+    /// @param dt The time step of each substep
+    /// @param group Optional name of a group for filtering.  If this is not NULL,
+    ///        the code will only be applied to points in this group
+    void execute(points::PointDataGrid& grid,
+                 const size_t substeps,
+                 const float dt,
+                 const std::string* const group = nullptr) const;
+
+    /// @brief Returns the profiler holding the per statement and per function call
+    ///        counters accumulated over all calls to execute, or a null pointer if
+    ///        the code was not compiled with CompilerOptions::profile
+    inline Profiler::Ptr profiler() const { return mProfiler; }
+
 private:
 
     /// @brief Returns the in-memory address of the function with the given name
     uint64_t functionAddress(const std::string &name) const;
 
+    /// @brief Executes on the given grids, which must all be non-null
+    void executeGrids(const std::vector<points::PointDataGrid*>& grids,
+                      const std::string* const group,
+                      const size_t substeps = 1,
+                      const float dt = 1.0f) const;
+
     // these 2 shared pointers exist _only_ for object lifetime management
     // as these objects must not be destroyed before this one
     const std::shared_ptr<const llvm::ExecutionEngine> mExecutionEngine;
@@ -111,6 +160,10 @@ private:
     const CustomData::Ptr mCustomData;
     // addresses of actual compiled code
     const std::map<std::string, uint64_t> mFunctionAddresses;
+    // counters of instrumented code, if compiled with profiling
+    const Profiler::Ptr mProfiler;
+    // optional listener of execution phases
+    const PhaseListener::Ptr mPhaseListener;
 };
 
 }
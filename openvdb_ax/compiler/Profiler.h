@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file compiler/Profiler.h
+///
+/// @brief Contains the Profiler class which accumulates the counters of
+///        executables compiled with CompilerOptions::profile enabled
+///
+
+#ifndef OPENVDB_AX_COMPILER_PROFILER_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_COMPILER_PROFILER_HAS_BEEN_INCLUDED
+
+#include <openvdb_ax/codegen/ProfileCounters.h>
+
+#include <openvdb/Types.h>
+
+#include <algorithm>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+/// @brief  The profiler holds a list of labelled entries, each representing an
+///         instrumented region of generated code, such as a top level statement or
+///         a function call. Instrumented code records into the counters of each
+///         entry, see codegen::ProfileCounters. Counters are held per thread and
+///         are only combined when a report is requested.
+class Profiler : public codegen::ProfileCounters
+{
+public:
+
+    using Ptr = std::shared_ptr<Profiler>;
+    using ConstPtr = std::shared_ptr<const Profiler>;
+
+    /// @brief  A single aggregated entry of a profile report
+    struct Entry
+    {
+        std::string mLabel;
+        uint64_t mCount;
+        uint64_t mCycles;
+    };
+
+    Profiler() = default;
+    ~Profiler() = default;
+
+    /// @brief  Returns the entries with their counters aggregated over all threads,
+    ///         sorted by descending cycle count
+    inline std::vector<Entry> report() const
+    {
+        std::vector<Entry> entries;
+        entries.reserve(mLabels.size());
+        for (const std::string& label : mLabels) {
+            entries.push_back(Entry{label, 0, 0});
+        }
+
+        for (const std::vector<Counter>& counters : mCounters) {
+            for (size_t i = 0; i < counters.size(); ++i) {
+                entries[i].mCount += counters[i].first;
+                entries[i].mCycles += counters[i].second;
+            }
+        }
+
+        std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.mCycles > b.mCycles; });
+        return entries;
+    }
+
+    /// @brief  Print a report of all entries with a non zero count
+    /// @param  os  The stream to print to
+    inline void print(std::ostream& os) const
+    {
+        const std::vector<Entry> entries = this->report();
+
+        uint64_t total = 0;
+        for (const Entry& entry : entries) total += entry.mCycles;
+
+        for (const Entry& entry : entries) {
+            if (entry.mCount == 0) continue;
+            const double percent = total == 0 ? 0.0 :
+                100.0 * double(entry.mCycles) / double(total);
+            os << entry.mLabel << ": " << entry.mCycles << " cycles ("
+               << percent << "%), " << entry.mCount << " invocations, "
+               << (entry.mCycles / entry.mCount) << " cycles per invocation\n";
+        }
+    }
+};
+
+}
+}
+}
+
+#endif // OPENVDB_AX_COMPILER_PROFILER_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
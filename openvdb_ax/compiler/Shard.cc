@@ -0,0 +1,499 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "Shard.h"
+
+#include <openvdb/Exceptions.h>
+#include <openvdb/math/Math.h>
+#include <openvdb/points/AttributeArrayString.h>
+#include <openvdb/points/PointDataGrid.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+namespace {
+
+const char* const sShardIndexMeta = "ax_shard_index";
+const char* const sShardCountMeta = "ax_shard_count";
+const char* const sShardAxisMeta = "ax_shard_axis";
+const char* const sShardMinMeta = "ax_shard_min";
+const char* const sShardMaxMeta = "ax_shard_max";
+
+template <typename GridT, typename BaseT>
+using CopyConstT = typename std::conditional<std::is_const<BaseT>::value, const GridT, GridT>::type;
+
+/// @brief  Invoke op with the typed volume, returning false if the grid is not of a
+///         supported volume type
+template <typename BaseT, typename OpT>
+inline bool applyToVolume(BaseT& grid, OpT& op)
+{
+    if (grid.template isType<BoolGrid>())        op(static_cast<CopyConstT<BoolGrid, BaseT>&>(grid));
+    else if (grid.template isType<Int32Grid>())  op(static_cast<CopyConstT<Int32Grid, BaseT>&>(grid));
+    else if (grid.template isType<Int64Grid>())  op(static_cast<CopyConstT<Int64Grid, BaseT>&>(grid));
+    else if (grid.template isType<FloatGrid>())  op(static_cast<CopyConstT<FloatGrid, BaseT>&>(grid));
+    else if (grid.template isType<DoubleGrid>()) op(static_cast<CopyConstT<DoubleGrid, BaseT>&>(grid));
+    else if (grid.template isType<Vec3IGrid>())  op(static_cast<CopyConstT<Vec3IGrid, BaseT>&>(grid));
+    else if (grid.template isType<Vec3fGrid>())  op(static_cast<CopyConstT<Vec3fGrid, BaseT>&>(grid));
+    else if (grid.template isType<Vec3dGrid>())  op(static_cast<CopyConstT<Vec3dGrid, BaseT>&>(grid));
+    else if (grid.template isType<MaskGrid>())   op(static_cast<CopyConstT<MaskGrid, BaseT>&>(grid));
+    else return false;
+    return true;
+}
+
+template <typename LeafT>
+inline math::BBox<Vec3d>
+leafBounds(const LeafT& leaf, const math::Transform& transform)
+{
+    return transform.indexToWorld(leaf.getNodeBoundingBox());
+}
+
+/// @brief  Collects the world space centre of every leaf node along with a weight, the
+///         number of points or active voxels it holds
+struct SampleOp
+{
+    std::vector<std::pair<Vec3d, Index64>> mSamples;
+
+    void operator()(const points::PointDataGrid& grid)
+    {
+        for (auto leaf = grid.tree().cbeginLeaf(); leaf; ++leaf) {
+            mSamples.emplace_back(leafBounds(*leaf, grid.transform()).getCenter(),
+                std::max(Index64(1), leaf->pointCount()));
+        }
+    }
+
+    template <typename GridT>
+    void operator()(const GridT& grid)
+    {
+        for (auto leaf = grid.tree().cbeginLeaf(); leaf; ++leaf) {
+            mSamples.emplace_back(leafBounds(*leaf, grid.transform()).getCenter(),
+                std::max(Index64(1), leaf->onVoxelCount()));
+        }
+    }
+};
+
+/// @brief  Removes all leaf nodes of a grid which lie further than halo voxels from a
+///         shard. A negative halo removes all leaf nodes the shard does not own.
+struct ExtractOp
+{
+    ExtractOp(const Shard& shard, const int halo)
+        : mShard(shard), mHalo(halo) {}
+
+    template <typename GridT>
+    void operator()(GridT& grid) const
+    {
+        using LeafT = typename GridT::TreeType::LeafNodeType;
+
+        const math::Transform& transform = grid.transform();
+        const double halo = double(mHalo) * transform.voxelSize()[mShard.mAxis];
+
+        std::vector<LeafT*> leaves;
+        grid.tree().stealNodes(leaves, grid.tree().background(), false);
+
+        for (LeafT* leaf : leaves) {
+            const math::BBox<Vec3d> bounds = leafBounds(*leaf, transform);
+            const bool keep = mHalo < 0 ? mShard.owns(bounds.getCenter()) :
+                (bounds.max()[mShard.mAxis] >= mShard.mMin - halo &&
+                 bounds.min()[mShard.mAxis] < mShard.mMax + halo);
+            if (keep) grid.tree().addLeaf(leaf);
+            else      delete leaf;
+        }
+    }
+
+    const Shard& mShard;
+    const int mHalo;
+};
+
+/// @brief  Moves the leaf nodes each shard owns into the first grid
+struct MergeVolumeOp
+{
+    MergeVolumeOp(const GridPtrVec& parts, const std::vector<Shard>& shards)
+        : mParts(parts), mShards(shards) {}
+
+    template <typename GridT>
+    void operator()(GridT& target) const
+    {
+        using LeafT = typename GridT::TreeType::LeafNodeType;
+
+        std::vector<LeafT*> leaves;
+        for (size_t i = 0; i < mParts.size(); ++i) {
+            GridT& grid = static_cast<GridT&>(*mParts[i]);
+            leaves.clear();
+            grid.tree().stealNodes(leaves, grid.tree().background(), false);
+            for (LeafT* leaf : leaves) {
+                if (mShards[i].owns(leafBounds(*leaf, grid.transform()).getCenter())) {
+                    target.tree().addLeaf(leaf);
+                }
+                else {
+                    delete leaf;
+                }
+            }
+        }
+    }
+
+    const GridPtrVec& mParts;
+    const std::vector<Shard>& mShards;
+};
+
+/// @brief  Append the points of source to target, which have the same origin and
+///         descriptor. The points of each voxel are ordered with those of target first.
+void appendLeaf(points::PointDataTree::LeafNodeType& target,
+                const points::PointDataTree::LeafNodeType& source)
+{
+    using LeafT = points::PointDataTree::LeafNodeType;
+
+    const points::AttributeSet::Descriptor::Ptr descriptor =
+        target.attributeSet().descriptorPtr();
+    const Index count = Index(target.pointCount() + source.pointCount());
+
+    // the index in the merged leaf of each point of target and source
+
+    std::vector<Index> targetIndices, sourceIndices;
+    targetIndices.reserve(target.pointCount());
+    sourceIndices.reserve(source.pointCount());
+
+    std::vector<LeafT::ValueType> offsets(LeafT::SIZE);
+    Index index = 0, targetStart = 0, sourceStart = 0;
+    for (Index n = 0; n < LeafT::SIZE; ++n) {
+        const Index targetEnd = target.getValue(n), sourceEnd = source.getValue(n);
+        for (; targetStart < targetEnd; ++targetStart) targetIndices.push_back(index++);
+        for (; sourceStart < sourceEnd; ++sourceStart) sourceIndices.push_back(index++);
+        offsets[n] = index;
+    }
+
+    std::unique_ptr<points::AttributeSet> attributeSet(
+        new points::AttributeSet(descriptor, count));
+
+    for (size_t pos = 0; pos < attributeSet->size(); ++pos) {
+        points::AttributeArray* array = attributeSet->get(pos);
+        const points::AttributeArray& targetArray = target.constAttributeArray(pos);
+        const points::AttributeArray& sourceArray = source.constAttributeArray(pos);
+
+        if (targetArray.stride() != 1 || sourceArray.stride() != 1) {
+            OPENVDB_THROW(TypeError, "Unable to merge strided point attribute \""
+                + descriptor->valueType(pos) + "\"");
+        }
+
+        targetArray.loadData();
+        sourceArray.loadData();
+
+        for (Index n = 0; n < targetIndices.size(); ++n) {
+            array->set(targetIndices[n], targetArray, n);
+        }
+        for (Index n = 0; n < sourceIndices.size(); ++n) {
+            array->set(sourceIndices[n], sourceArray, n);
+        }
+
+        array->setHidden(targetArray.isHidden());
+        array->setTransient(targetArray.isTransient());
+    }
+
+    target.replaceAttributeSet(attributeSet.release());
+    target.setOffsets(offsets);
+}
+
+/// @brief  Merge the points of source into target, consuming source
+void mergePoints(points::PointDataGrid& target, points::PointDataGrid& source)
+{
+    using LeafT = points::PointDataTree::LeafNodeType;
+    using Descriptor = points::AttributeSet::Descriptor;
+
+    if (source.tree().leafCount() == 0) return;
+    if (target.tree().leafCount() == 0) {
+        target.setTree(source.treePtr());
+        return;
+    }
+
+    const Descriptor::Ptr descriptor =
+        target.tree().cbeginLeaf()->attributeSet().descriptorPtr();
+    const Descriptor::Ptr sourceDescriptor =
+        source.tree().cbeginLeaf()->attributeSet().descriptorPtr();
+
+    if (!descriptor->hasSameAttributes(*sourceDescriptor) ||
+        descriptor->groupMap() != sourceDescriptor->groupMap()) {
+        OPENVDB_THROW(ValueError, "Unable to merge the shards of \"" + target.getName()
+            + "\" as they have different attributes or groups");
+    }
+
+    std::vector<size_t> strings;
+    for (const auto& attribute : descriptor->map()) {
+        if (points::isString(source.tree().cbeginLeaf()->constAttributeArray(attribute.second))) {
+            strings.push_back(attribute.second);
+        }
+    }
+
+    // add the strings of source to the string table of target
+
+    if (!strings.empty()) {
+        points::StringMetaInserter inserter(descriptor->getMetadata());
+        for (auto meta = sourceDescriptor->getMetadata().beginMeta();
+            meta != sourceDescriptor->getMetadata().endMeta(); ++meta) {
+            if (meta->first.compare(0, 7, "string:") != 0) continue;
+            const StringMetadata* value = dynamic_cast<const StringMetadata*>(meta->second.get());
+            if (value) inserter.insert(value->value());
+        }
+    }
+
+    std::vector<LeafT*> leaves;
+    source.tree().stealNodes(leaves, source.tree().background(), false);
+
+    for (LeafT* leaf : leaves) {
+
+        // remap string indices from the table of source to the table of target
+
+        for (const size_t pos : strings) {
+            points::StringAttributeHandle handle(leaf->constAttributeArray(pos),
+                sourceDescriptor->getMetadata());
+            std::vector<Name> values(handle.size());
+            for (Index n = 0; n < handle.size(); ++n) values[n] = handle.get(n);
+
+            points::StringAttributeWriteHandle writeHandle(leaf->attributeArray(pos),
+                descriptor->getMetadata());
+            for (Index n = 0; n < writeHandle.size(); ++n) writeHandle.set(n, values[n]);
+        }
+
+        leaf->resetDescriptor(descriptor);
+
+        LeafT* existing = target.tree().probeLeaf(leaf->origin());
+        if (existing) {
+            appendLeaf(*existing, *leaf);
+            delete leaf;
+        }
+        else {
+            target.tree().addLeaf(leaf);
+        }
+    }
+}
+
+void removeShardMeta(GridBase& grid)
+{
+    grid.removeMeta(sShardIndexMeta);
+    grid.removeMeta(sShardCountMeta);
+    grid.removeMeta(sShardAxisMeta);
+    grid.removeMeta(sShardMinMeta);
+    grid.removeMeta(sShardMaxMeta);
+}
+
+}
+
+Shard computeShard(const GridCPtrVec& grids, const size_t index, const size_t count)
+{
+    if (count == 0 || index >= count) {
+        OPENVDB_THROW(ValueError, "Invalid shard " + std::to_string(index) + "/"
+            + std::to_string(count));
+    }
+
+    Shard shard;
+    shard.mIndex = index;
+    shard.mCount = count;
+    if (count == 1) return shard;
+
+    // balance the shards by the points if there are any, otherwise by active voxels
+
+    SampleOp points, volumes;
+    for (const GridBase::ConstPtr& grid : grids) {
+        if (grid->isType<points::PointDataGrid>()) {
+            points(static_cast<const points::PointDataGrid&>(*grid));
+        }
+        else {
+            applyToVolume(*grid, volumes);
+        }
+    }
+
+    std::vector<std::pair<Vec3d, Index64>>& samples =
+        points.mSamples.empty() ? volumes.mSamples : points.mSamples;
+
+    if (samples.empty()) {
+        // all grids are empty, the first shard owns everything
+        if (index > 0) shard.mMin = shard.mMax;
+        return shard;
+    }
+
+    math::BBox<Vec3d> bounds;
+    Index64 total = 0;
+    for (const auto& sample : samples) {
+        bounds.expand(sample.first);
+        total += sample.second;
+    }
+
+    const int axis = int(math::MaxIndex(bounds.extents()));
+    shard.mAxis = axis;
+
+    std::sort(samples.begin(), samples.end(),
+        [axis](const std::pair<Vec3d, Index64>& a, const std::pair<Vec3d, Index64>& b) {
+            return a.first[axis] < b.first[axis];
+        });
+
+    // cut between distinct leaf positions once each shard has its share of the weight
+
+    std::vector<double> cuts;
+    Index64 accumulated = 0;
+    size_t next = 0;
+    for (size_t i = 1; i < count; ++i) {
+        const Index64 target = (total * i) / count;
+        while (next < samples.size() && accumulated < target) {
+            accumulated += samples[next++].second;
+        }
+        while (next > 0 && next < samples.size() &&
+            samples[next].first[axis] == samples[next - 1].first[axis]) {
+            accumulated += samples[next++].second;
+        }
+        if (next == 0)                   cuts.push_back(-std::numeric_limits<double>::max());
+        else if (next == samples.size()) cuts.push_back(std::numeric_limits<double>::max());
+        else cuts.push_back(0.5 * (samples[next - 1].first[axis] + samples[next].first[axis]));
+    }
+
+    if (index > 0)         shard.mMin = cuts[index - 1];
+    if (index < count - 1) shard.mMax = cuts[index];
+    return shard;
+}
+
+void extractShard(GridPtrVec& grids, const Shard& shard, const int halo)
+{
+    for (const GridBase::Ptr& grid : grids) {
+        if (grid->isType<points::PointDataGrid>()) {
+            ExtractOp op(shard, -1);
+            op(static_cast<points::PointDataGrid&>(*grid));
+        }
+        else {
+            ExtractOp op(shard, std::max(0, halo));
+            if (!applyToVolume(*grid, op)) {
+                OPENVDB_THROW(TypeError, "Unable to shard \"" + grid->getName()
+                    + "\" as it has an unsupported type \"" + grid->type() + "\"");
+            }
+        }
+
+        grid->insertMeta(sShardIndexMeta, Int32Metadata(int32_t(shard.mIndex)));
+        grid->insertMeta(sShardCountMeta, Int32Metadata(int32_t(shard.mCount)));
+        grid->insertMeta(sShardAxisMeta, Int32Metadata(shard.mAxis));
+        grid->insertMeta(sShardMinMeta, DoubleMetadata(shard.mMin));
+        grid->insertMeta(sShardMaxMeta, DoubleMetadata(shard.mMax));
+    }
+}
+
+bool readShard(const GridBase& grid, Shard& shard)
+{
+    const Int32Metadata::ConstPtr index = grid.getMetadata<Int32Metadata>(sShardIndexMeta);
+    const Int32Metadata::ConstPtr count = grid.getMetadata<Int32Metadata>(sShardCountMeta);
+    const Int32Metadata::ConstPtr axis = grid.getMetadata<Int32Metadata>(sShardAxisMeta);
+    const DoubleMetadata::ConstPtr min = grid.getMetadata<DoubleMetadata>(sShardMinMeta);
+    const DoubleMetadata::ConstPtr max = grid.getMetadata<DoubleMetadata>(sShardMaxMeta);
+    if (!index || !count || !axis || !min || !max) return false;
+
+    shard.mIndex = size_t(index->value());
+    shard.mCount = size_t(count->value());
+    shard.mAxis = axis->value();
+    shard.mMin = min->value();
+    shard.mMax = max->value();
+    return true;
+}
+
+GridPtrVec mergeShards(std::vector<GridPtrVec>& shards)
+{
+    GridPtrVec merged;
+    if (shards.empty()) return merged;
+
+    for (const GridBase::Ptr& grid : shards.front()) {
+        const std::string& name = grid->getName();
+
+        // gather this grid from every shard, ordered by shard index
+
+        std::vector<std::pair<Shard, GridBase::Ptr>> parts;
+        for (const GridPtrVec& grids : shards) {
+            auto iter = std::find_if(grids.begin(), grids.end(),
+                [&name](const GridBase::Ptr& other) { return other->getName() == name; });
+            if (iter == grids.end()) {
+                OPENVDB_THROW(LookupError, "Grid \"" + name + "\" is missing from a shard");
+            }
+            Shard shard;
+            if (!readShard(**iter, shard)) {
+                OPENVDB_THROW(ValueError, "Grid \"" + name + "\" is not a shard");
+            }
+            if ((*iter)->type() != grid->type()) {
+                OPENVDB_THROW(TypeError, "Grid \"" + name + "\" has different types in different shards");
+            }
+            parts.emplace_back(shard, *iter);
+        }
+
+        std::sort(parts.begin(), parts.end(),
+            [](const std::pair<Shard, GridBase::Ptr>& a, const std::pair<Shard, GridBase::Ptr>& b) {
+                return a.first.mIndex < b.first.mIndex;
+            });
+
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (parts[i].first.mIndex != i || parts[i].first.mCount != parts.size()) {
+                OPENVDB_THROW(ValueError, "Expected shards 0 to " + std::to_string(parts.size() - 1)
+                    + " of " + std::to_string(parts.size()) + " for grid \"" + name + "\"");
+            }
+        }
+
+        const GridBase::Ptr& target = parts.front().second;
+
+        if (target->isType<points::PointDataGrid>()) {
+            points::PointDataGrid& points = static_cast<points::PointDataGrid&>(*target);
+            for (size_t i = 1; i < parts.size(); ++i) {
+                mergePoints(points, static_cast<points::PointDataGrid&>(*parts[i].second));
+            }
+        }
+        else {
+            GridPtrVec grids;
+            std::vector<Shard> owners;
+            for (const auto& part : parts) {
+                owners.push_back(part.first);
+                grids.push_back(part.second);
+            }
+            MergeVolumeOp op(grids, owners);
+            if (!applyToVolume(*target, op)) {
+                OPENVDB_THROW(TypeError, "Unable to merge \"" + name
+                    + "\" as it has an unsupported type \"" + target->type() + "\"");
+            }
+        }
+
+        removeShardMeta(*target);
+        merged.push_back(target);
+    }
+
+    return merged;
+}
+
+}
+}
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
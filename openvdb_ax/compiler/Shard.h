@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file compiler/Shard.h
+///
+/// @brief Methods for splitting a set of grids into spatial shards which can be
+///        executed independently, for example by separate processes, and for
+///        merging the executed shards back together
+///
+/// @details Shards are slabs along the axis of greatest extent, cut such that each
+///   holds an equal share of the points (or active voxels, if there are no point
+///   grids). Every leaf node is owned by exactly one shard, determined by the world
+///   space position of its centre, so a shard is always leaf aligned. The partition
+///   depends only on the topology of the input grids, so every process computes the
+///   same partition from the same file, which may be opened with delayed loading.
+///
+///   Volumes additionally keep a halo of leaf nodes around the owned region so that
+///   snippets can read neighbouring values. Points are only ever read at their own
+///   position and so have no halo. Points which move across a shard boundary during
+///   execution are carried in the executed shard and are reconciled by mergeShards.
+///
+
+#ifndef OPENVDB_AX_COMPILER_SHARD_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_COMPILER_SHARD_HAS_BEEN_INCLUDED
+
+#include <openvdb/openvdb.h>
+
+#include <limits>
+#include <vector>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+/// @brief  Shard i of n of a set of grids, the region of world space between mMin
+///         and mMax along mAxis. The first and last shards are unbounded below and
+///         above respectively.
+struct Shard
+{
+    size_t mIndex = 0;
+    size_t mCount = 1;
+    int mAxis = 0;
+    double mMin = -std::numeric_limits<double>::max();
+    double mMax = std::numeric_limits<double>::max();
+
+    /// @brief  Returns true if a leaf node with the given world space centre is owned
+    ///         by this shard
+    inline bool owns(const Vec3d& center) const {
+        return center[mAxis] >= mMin && center[mAxis] < mMax;
+    }
+};
+
+/// @brief  Compute shard index of count from the topology of the given grids. Only
+///         the leaf node topology and point counts are accessed, so the grids may
+///         be delay loaded.
+/// @param  grids  The grids to partition
+/// @param  index  The index of the shard to compute, less than count
+/// @param  count  The total number of shards
+Shard computeShard(const GridCPtrVec& grids, const size_t index, const size_t count);
+
+/// @brief  Reduce the given grids in place to a shard. Point grids keep the leaf nodes
+///         the shard owns, volumes additionally keep all leaf nodes within halo voxels
+///         of the owned region. The shard is recorded in the metadata of each grid.
+/// @param  grids  The grids to reduce
+/// @param  shard  The shard, as returned by computeShard
+/// @param  halo   The width in voxels of the region around the shard kept for volumes
+void extractShard(GridPtrVec& grids, const Shard& shard, const int halo = 2);
+
+/// @brief  Merge executed shards, each the grids of one shard as extracted with
+///         extractShard, into a single set of grids. Grids are matched by name and
+///         returned in the order of the first shard. Volumes keep the leaf nodes
+///         owned by each shard, discarding the halos. Point grids combine the points
+///         of all shards, including points which moved between shards; the leaf
+///         nodes of different shards with the same origin are concatenated.
+///         Attributes and groups must have been created identically in all shards,
+///         as is the case when they are executed with the same snippet. String
+///         attributes are remapped to a single string table.
+/// @param  shards  The grids of each shard. These are consumed by the merge.
+GridPtrVec mergeShards(std::vector<GridPtrVec>& shards);
+
+/// @brief  Returns the shard recorded in the metadata of a grid by extractShard, or
+///         false if the grid is not a shard
+bool readShard(const GridBase& grid, Shard& shard);
+
+}
+}
+}
+
+#endif // OPENVDB_AX_COMPILER_SHARD_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
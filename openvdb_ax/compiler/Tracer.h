@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+/// @file compiler/Tracer.h
+///
+/// @brief Contains the Tracer PhaseListener which records a timeline of the
+///        phases of compilation and execution in the Chrome trace event format
+///
+
+#ifndef OPENVDB_AX_COMPILER_TRACER_HAS_BEEN_INCLUDED
+#define OPENVDB_AX_COMPILER_TRACER_HAS_BEEN_INCLUDED
+
+#include <openvdb_ax/compiler/PhaseListener.h>
+
+#include <openvdb/Types.h>
+
+#include <tbb/atomic.h>
+#include <tbb/enumerable_thread_specific.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace openvdb {
+OPENVDB_USE_VERSION_NAMESPACE
+namespace OPENVDB_VERSION_NAME {
+
+namespace ax {
+
+/// @brief  A PhaseListener which records every phase as a timed span on the thread
+///         which ran it. The spans can be written as Chrome trace event JSON which
+///         can be viewed with chrome://tracing or Perfetto, showing how compilation
+///         and execution are distributed over threads. Spans are held per thread
+///         and are only combined when written.
+class Tracer : public PhaseListener
+{
+public:
+    using Ptr = std::shared_ptr<Tracer>;
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief  A single recorded span
+    struct Span
+    {
+        std::string mName;
+        // start time and duration in microseconds, relative to the tracer's creation
+        double mStart;
+        double mDuration;
+        // a sequential index of the thread which recorded the span
+        size_t mThread;
+    };
+
+    Tracer()
+        : mOrigin(Clock::now())
+        , mThreads()
+        , mThreadCount() {}
+
+    ~Tracer() override = default;
+
+    void begin(const std::string&) override
+    {
+        this->local().mStarts.emplace_back(Clock::now());
+    }
+
+    void end(const std::string& phase) override
+    {
+        const Clock::time_point now = Clock::now();
+        ThreadTrace& trace = this->local();
+        const Clock::time_point start = trace.mStarts.back();
+        trace.mStarts.pop_back();
+        trace.mSpans.push_back(Span{phase,
+            std::chrono::duration<double, std::micro>(start - mOrigin).count(),
+            std::chrono::duration<double, std::micro>(now - start).count(),
+            trace.mId});
+    }
+
+    /// @brief  Returns all recorded spans sorted by their start time
+    /// @note   This must not be called whilst any phase is active
+    inline std::vector<Span> spans() const
+    {
+        std::vector<Span> spans;
+        for (const ThreadTrace& trace : mThreads) {
+            spans.insert(spans.end(), trace.mSpans.begin(), trace.mSpans.end());
+        }
+        std::stable_sort(spans.begin(), spans.end(),
+            [](const Span& a, const Span& b) { return a.mStart < b.mStart; });
+        return spans;
+    }
+
+    /// @brief  Discard all recorded spans
+    /// @note   This must not be called whilst any phase is active
+    inline void clear()
+    {
+        for (ThreadTrace& trace : mThreads) trace.mSpans.clear();
+    }
+
+    /// @brief  Write all recorded spans as a Chrome trace event JSON object
+    /// @param  os  The stream to write to
+    inline void write(std::ostream& os) const
+    {
+        const std::vector<Span> spans = this->spans();
+
+        // microseconds with nanosecond precision
+        const std::ios_base::fmtflags flags = os.flags();
+        const std::streamsize precision = os.precision();
+        os << std::fixed << std::setprecision(3);
+
+        os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+        bool first = true;
+        for (size_t i = 0; i < mThreadCount; ++i) {
+            os << (first ? "\n" : ",\n");
+            os << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << i
+               << ", \"args\": {\"name\": \"" << (i == 0 ? "main" : "worker ")
+               << (i == 0 ? "" : std::to_string(i)) << "\"}}";
+            first = false;
+        }
+
+        for (const Span& span : spans) {
+            os << (first ? "\n" : ",\n");
+            os << "{\"name\": \"" << escape(span.mName) << "\", \"cat\": \"ax\", "
+               << "\"ph\": \"X\", \"pid\": 1, \"tid\": " << span.mThread
+               << ", \"ts\": " << span.mStart << ", \"dur\": " << span.mDuration << "}";
+            first = false;
+        }
+
+        os << "\n]}\n";
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+private:
+    struct ThreadTrace
+    {
+        size_t mId = 0;
+        std::vector<Clock::time_point> mStarts;
+        std::vector<Span> mSpans;
+    };
+
+    inline ThreadTrace& local()
+    {
+        bool exists;
+        ThreadTrace& trace = mThreads.local(exists);
+        // threads are numbered in the order they first report a phase, so the thread
+        // which begins compilation or execution is always 0
+        if (!exists) trace.mId = mThreadCount++;
+        return trace;
+    }
+
+    static inline std::string escape(const std::string& str)
+    {
+        std::string result;
+        result.reserve(str.size());
+        for (const char c : str) {
+            if (c == '"' || c == '\\') result.push_back('\\');
+            result.push_back(c);
+        }
+        return result;
+    }
+
+    const Clock::time_point mOrigin;
+    tbb::enumerable_thread_specific<ThreadTrace> mThreads;
+    tbb::atomic<size_t> mThreadCount;
+};
+
+}
+}
+}
+
+#endif // OPENVDB_AX_COMPILER_TRACER_HAS_BEEN_INCLUDED
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -32,6 +32,7 @@
 
 // @TODO refactor so we don't have to include VolumeComputeGenerator.h, but still have the functions
 // defined in one place
+#include <openvdb_ax/codegen/ScatterData.h>
 #include <openvdb_ax/codegen/VolumeComputeGenerator.h>
 #include <openvdb_ax/Exceptions.h>
 
@@ -39,7 +40,13 @@
 #include <openvdb/tree/LeafManager.h>
 #include <openvdb/Types.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <utility>
+#include <vector>
 
 namespace openvdb {
 OPENVDB_USE_VERSION_NAMESPACE
@@ -52,80 +59,352 @@ namespace {
 template <typename ValueType>
 inline void
 retrieveAccessorTyped(codegen::ComputeVolumeFunction::Arguments& args,
-                      openvdb::GridBase::Ptr grid)
+                      openvdb::GridBase::Ptr grid,
+                      const bool indexSpace)
 {
     using GridType = typename openvdb::BoolGrid::ValueConverter<ValueType>::Type;
     typename GridType::Ptr typed = openvdb::StaticPtrCast<GridType>(grid);
-    args.addAccessor(typed->tree());
+    args.addAccessor(typed->tree(), indexSpace);
 }
 
 inline void
 retrieveAccessor(codegen::ComputeVolumeFunction::Arguments& args,
                  const openvdb::GridBase::Ptr grid,
-                 const std::string& valueType)
+                 const std::string& valueType,
+                 const bool indexSpace)
 {
-    if (valueType == typeNameAsString<bool>())                      retrieveAccessorTyped<bool>(args, grid);
-    else if (valueType == typeNameAsString<int16_t>())              retrieveAccessorTyped<int16_t>(args, grid);
-    else if (valueType == typeNameAsString<int32_t>())              retrieveAccessorTyped<int32_t>(args, grid);
-    else if (valueType == typeNameAsString<int64_t>())              retrieveAccessorTyped<int64_t>(args, grid);
-    else if (valueType == typeNameAsString<float>())                retrieveAccessorTyped<float>(args, grid);
-    else if (valueType == typeNameAsString<double>())               retrieveAccessorTyped<double>(args, grid);
-    else if (valueType == typeNameAsString<math::Vec3<int32_t>>())  retrieveAccessorTyped<math::Vec3<int32_t>>(args, grid);
-    else if (valueType == typeNameAsString<math::Vec3<float>>())    retrieveAccessorTyped<math::Vec3<float>>(args, grid);
-    else if (valueType == typeNameAsString<math::Vec3<double>>())   retrieveAccessorTyped<math::Vec3<double>>(args, grid);
+    if (valueType == typeNameAsString<bool>())                      retrieveAccessorTyped<bool>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<int8_t>())               retrieveAccessorTyped<int8_t>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<uint8_t>())              retrieveAccessorTyped<uint8_t>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<int16_t>())              retrieveAccessorTyped<int16_t>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<int32_t>())              retrieveAccessorTyped<int32_t>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<int64_t>())              retrieveAccessorTyped<int64_t>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<half>())                 retrieveAccessorTyped<half>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<float>())                retrieveAccessorTyped<float>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<double>())               retrieveAccessorTyped<double>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<math::Vec3<int32_t>>())  retrieveAccessorTyped<math::Vec3<int32_t>>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<math::Vec3<float>>())    retrieveAccessorTyped<math::Vec3<float>>(args, grid, indexSpace);
+    else if (valueType == typeNameAsString<math::Vec3<double>>())   retrieveAccessorTyped<math::Vec3<double>>(args, grid, indexSpace);
     else {
         OPENVDB_THROW(TypeError, "Could not retrieve attribute '" + grid->getName()
             + "' as it has an unknown value type '" + valueType + "'");
     }
 }
 
+/// @brief  Spreads the lowest 21 bits of the given value so that they occupy every third
+///         bit of the result
+inline uint64_t
+spreadBits(uint64_t x)
+{
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffff;
+    x = (x | x << 16) & 0x1f0000ff0000ff;
+    x = (x | x << 8)  & 0x100f00f00f00f00f;
+    x = (x | x << 4)  & 0x10c30c30c30c30c3;
+    x = (x | x << 2)  & 0x1249249249249249;
+    return x;
+}
+
+/// @brief  Returns the position of the leaf node at the given origin along a Morton
+///         (Z-order) curve, interleaving the bits of its coordinates in units of leaf
+///         nodes. Only the lowest 21 bits of each coordinate are used, so leaf nodes more
+///         than 2^21 leaf nodes apart may be ordered less coherently, but are still
+///         all executed.
+template <typename LeafT>
+inline uint64_t
+mortonKey(const Coord& origin)
+{
+    const uint64_t offset = uint64_t(1) << 20;
+    const uint64_t x = uint64_t(int64_t(origin.x() >> LeafT::LOG2DIM) + offset);
+    const uint64_t y = uint64_t(int64_t(origin.y() >> LeafT::LOG2DIM) + offset);
+    const uint64_t z = uint64_t(int64_t(origin.z() >> LeafT::LOG2DIM) + offset);
+    return spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+}
+
+/// @brief  The arguments of a block, bound once per thread and reused by every leaf
+///         range the thread executes
+using ThreadArguments =
+    tbb::enumerable_thread_specific<std::shared_ptr<codegen::ComputeVolumeFunction::Arguments>>;
+
 template <typename TreeT>
 struct VolumeExecuterOp
 {
     using LeafManagerT = typename tree::LeafManager<TreeT>;
+    using LeafT = typename TreeT::LeafNodeType;
     using FunctionT = codegen::ComputeVolumeFunction::SignaturePtr;
+    using ArgumentsT = codegen::ComputeVolumeFunction::Arguments;
 
         VolumeExecuterOp(const VolumeRegistry& volumeRegistry,
                          const CustomData& customData,
                          const math::Transform& assignedVolumeTransform,
                          FunctionT computeFunction,
-                         openvdb::GridPtrVec& grids)
+                         openvdb::GridPtrVec& grids,
+                         const std::vector<size_t>& accesses,
+                         ThreadArguments& arguments,
+                         codegen::ScatterData* scatterData,
+                         PhaseListener* listener = nullptr)
         : mVolumeRegistry(volumeRegistry)
         , mCustomData(customData)
         , mComputeFunction(computeFunction)
         , mGrids(grids)
-        , mTargetVolumeTransform(assignedVolumeTransform) {
+        , mAccesses(accesses)
+        , mArguments(&arguments)
+        , mScatterData(scatterData)
+        , mTargetVolumeTransform(assignedVolumeTransform)
+        , mIterations(1)
+        , mLeaves(nullptr)
+        , mListener(listener) {
             assert(!mGrids.empty());
         }
 
     void operator()(const typename LeafManagerT::LeafRange& range) const
     {
-        codegen::ComputeVolumeFunction::Arguments args(mCustomData);
+        ScopedPhase phase(mListener, "leaf range");
+
+        ArgumentsT& args = this->arguments();
 
-        size_t location(0);
-        for (const auto& iter : mVolumeRegistry.volumeData()) {
-            retrieveAccessor(args, mGrids[location], iter.mType);
-            args.addTransform(mGrids[location]->transformPtr());
-            ++location;
+        // the accessors are bound once for all iterations over the range
+
+        for (size_t iteration = 0; iteration < mIterations; ++iteration) {
+            for (auto leaf = range.begin(); leaf; ++leaf) {
+                this->executeLeaf(args, *leaf);
+            }
         }
+    }
+
+    /// @brief  Executes a range of the leaf nodes set with setLeaves. The leaf node after
+    ///         the current one, and its values in every volume accessed by index, are
+    ///         prefetched before the current leaf node is executed.
+    void operator()(const tbb::blocked_range<size_t>& range) const
+    {
+        ScopedPhase phase(mListener, "leaf range");
+
+        assert(mLeaves);
+        ArgumentsT& args = this->arguments();
+
+        for (size_t iteration = 0; iteration < mIterations; ++iteration) {
+            for (size_t n = range.begin(); n < range.end(); ++n) {
+                if (n + 1 < range.end()) {
+                    const LeafT* const next = (*mLeaves)[n + 1];
+                    codegen::prefetch(next, sizeof(LeafT));
+                    args.prefetchLeaf(next->origin());
+                }
+                this->executeLeaf(args, *(*mLeaves)[n]);
+            }
+        }
+    }
+
+    inline void executeLeaf(ArgumentsT& args, const LeafT& leaf) const
+    {
+        args.beginLeaf(leaf.origin());
+        for (auto voxel = leaf.cbeginValueOn(); voxel; ++voxel) {
+            args.mCoord = voxel.getCoord();
+            args.mCoordWS = mTargetVolumeTransform.indexToWorld(args.mCoord);
+            args.bind(mComputeFunction)();
+        }
+        args.endLeaf();
+    }
 
-        for (auto leaf = range.begin(); leaf; ++leaf) {
-            for (auto voxel = leaf->cbeginValueOn(); voxel; ++voxel) {
-                args.mCoord = voxel.getCoord();
-                args.mCoordWS = mTargetVolumeTransform.indexToWorld(args.mCoord);
-                args.bind(mComputeFunction)();
+    /// @brief  Returns the arguments of the calling thread, binding them if this is the
+    ///         first leaf range the thread executes
+    inline ArgumentsT& arguments() const
+    {
+        std::shared_ptr<ArgumentsT>& args = mArguments->local();
+        if (!args) args = this->bindArguments();
+        return *args;
+    }
+
+    /// @brief  Creates the arguments of the block, with an accessor and transform for
+    ///         only the volumes the block accesses. The arguments are indexed by the
+    ///         position of the volume in the registry, so that volumes which are not
+    ///         accessed are given null entries.
+    std::shared_ptr<ArgumentsT> bindArguments() const
+    {
+        std::shared_ptr<ArgumentsT> args(new ArgumentsT(mCustomData, mScatterData));
+
+        const VolumeRegistry::VolumeDataVec& volumeData = mVolumeRegistry.volumeData();
+        auto access = mAccesses.cbegin();
+
+        for (size_t location = 0; location < volumeData.size(); ++location) {
+            if (access == mAccesses.cend() || *access != location) {
+                args->addNullAccessor();
+                continue;
             }
+            const bool indexSpace = (mGrids[location]->transform() == mTargetVolumeTransform);
+            retrieveAccessor(*args, mGrids[location], volumeData[location].mType, indexSpace);
+            args->addTransform(mGrids[location]->transformPtr());
+            ++access;
         }
+
+        return args;
     }
 
+    /// @brief  Sets the number of times each leaf range is executed in succession
+    inline void setIterations(const size_t iterations) { mIterations = iterations; }
+
+    /// @brief  Sets the leaf nodes executed by ranges of indices
+    inline void setLeaves(const std::vector<LeafT*>* leaves) { mLeaves = leaves; }
+
 private:
     const VolumeRegistry&       mVolumeRegistry;
     const CustomData&           mCustomData;
     FunctionT                   mComputeFunction;
     const openvdb::GridPtrVec&  mGrids;
+    const std::vector<size_t>&  mAccesses;
+    ThreadArguments* const      mArguments;
+    codegen::ScatterData* const mScatterData;
     const math::Transform&      mTargetVolumeTransform;
+    size_t                      mIterations;
+    const std::vector<LeafT*>*  mLeaves;
+    PhaseListener* const        mListener;
 };
 
+/// @brief  The execution of a single compiled block over the topology of the grid it
+///         writes to. The leaf manager is built once and reused by every iteration until
+///         the topology of the grids changes.
+struct VolumeBlock
+{
+    using UniquePtr = std::unique_ptr<VolumeBlock>;
+    virtual ~VolumeBlock() = default;
+
+    /// @brief  Executes the block over every active voxel the given number of times,
+    ///         running all iterations on a leaf range before moving on to the next
+    virtual void execute(const size_t iterations) = 0;
+
+    /// @brief  Rebuilds the leaf array and accessors of the block, which must be called
+    ///         once leaf nodes have been added to any of the grids
+    virtual void rebuild() = 0;
+};
+
+template <typename GridT>
+struct TypedVolumeBlock : public VolumeBlock
+{
+    using TreeT = typename GridT::TreeType;
+    using LeafT = typename TreeT::LeafNodeType;
+
+    TypedVolumeBlock(GridT& grid,
+                     const VolumeRegistry& volumeRegistry,
+                     const CustomData& customData,
+                     codegen::ComputeVolumeFunction::SignaturePtr compute,
+                     openvdb::GridPtrVec& usableGrids,
+                     const std::vector<size_t>& accesses,
+                     codegen::ScatterData* scatterData,
+                     const CompilerOptions::LeafOrder leafOrder,
+                     PhaseListener* listener)
+        : mLeafManager(grid.tree())
+        , mArguments()
+        , mLeafOrder(leafOrder)
+        , mSortedLeaves()
+        , mOp(volumeRegistry, customData, grid.transform(), compute, usableGrids,
+            accesses, mArguments, scatterData, listener) {}
+
+    void execute(const size_t iterations) override
+    {
+        mOp.setIterations(iterations);
+
+        if (mLeafOrder == CompilerOptions::LeafOrder::MORTON) {
+            if (mSortedLeaves.empty()) this->sortLeaves();
+            mOp.setLeaves(&mSortedLeaves);
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, mSortedLeaves.size()), mOp);
+        }
+        else {
+            tbb::parallel_for(mLeafManager.leafRange(), mOp);
+        }
+    }
+
+    void rebuild() override
+    {
+        mLeafManager.rebuildLeafArray();
+        mArguments.clear();
+        mSortedLeaves.clear();
+    }
+
+private:
+    /// @brief  Orders the leaf nodes along a Morton curve of their origins, so that leaf
+    ///         nodes executed in succession, and the leaf nodes of other volumes they
+    ///         access, are close together in space
+    void sortLeaves()
+    {
+        using KeyedLeaf = std::pair<uint64_t, LeafT*>;
+
+        std::vector<KeyedLeaf> keyed(mLeafManager.leafCount());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, keyed.size()),
+            [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t n = range.begin(); n < range.end(); ++n) {
+                    LeafT& leaf = mLeafManager.leaf(n);
+                    keyed[n] = KeyedLeaf(mortonKey<LeafT>(leaf.origin()), &leaf);
+                }
+            });
+
+        tbb::parallel_sort(keyed.begin(), keyed.end(),
+            [](const KeyedLeaf& a, const KeyedLeaf& b) { return a.first < b.first; });
+
+        mSortedLeaves.resize(keyed.size());
+        for (size_t n = 0; n < keyed.size(); ++n) mSortedLeaves[n] = keyed[n].second;
+    }
+
+    tree::LeafManager<TreeT> mLeafManager;
+    ThreadArguments mArguments;
+    const CompilerOptions::LeafOrder mLeafOrder;
+    // leaf nodes of the leaf manager in Morton order, built on first execution
+    std::vector<LeafT*> mSortedLeaves;
+    VolumeExecuterOp<TreeT> mOp;
+};
+
+template <typename GridT>
+inline VolumeBlock::UniquePtr
+createVolumeBlockTyped(const openvdb::GridBase::Ptr& grid,
+                       const VolumeRegistry& volumeRegistry,
+                       const CustomData& customData,
+                       codegen::ComputeVolumeFunction::SignaturePtr compute,
+                       openvdb::GridPtrVec& usableGrids,
+                       const std::vector<size_t>& accesses,
+                       codegen::ScatterData* scatterData,
+                       const CompilerOptions::LeafOrder leafOrder,
+                       PhaseListener* listener)
+{
+    typename GridT::Ptr typed = StaticPtrCast<GridT>(grid);
+    return VolumeBlock::UniquePtr(new TypedVolumeBlock<GridT>(*typed, volumeRegistry,
+        customData, compute, usableGrids, accesses, scatterData, leafOrder, listener));
+}
+
+/// @brief  Grids of the compact storage types, which have no openvdb grid type definitions
+using HalfGrid = BoolGrid::ValueConverter<half>::Type;
+using Int8Grid = BoolGrid::ValueConverter<int8_t>::Type;
+using UInt8Grid = BoolGrid::ValueConverter<uint8_t>::Type;
+
+inline VolumeBlock::UniquePtr
+createVolumeBlock(const openvdb::GridBase::Ptr& grid,
+                  const VolumeRegistry& volumeRegistry,
+                  const CustomData& customData,
+                  codegen::ComputeVolumeFunction::SignaturePtr compute,
+                  openvdb::GridPtrVec& usableGrids,
+                  const std::vector<size_t>& accesses,
+                  codegen::ScatterData* scatterData,
+                  const CompilerOptions::LeafOrder leafOrder,
+                  PhaseListener* listener)
+{
+    // We execute over the topology of the grid currently being modified.  To do this, we need
+    // a typed tree and leaf manager
+
+    if (grid->isType<BoolGrid>())        return createVolumeBlockTyped<BoolGrid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<Int8Grid>())   return createVolumeBlockTyped<Int8Grid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<UInt8Grid>())  return createVolumeBlockTyped<UInt8Grid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<Int32Grid>())  return createVolumeBlockTyped<Int32Grid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<Int64Grid>())  return createVolumeBlockTyped<Int64Grid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<HalfGrid>())   return createVolumeBlockTyped<HalfGrid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<FloatGrid>())  return createVolumeBlockTyped<FloatGrid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<DoubleGrid>()) return createVolumeBlockTyped<DoubleGrid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<Vec3IGrid>())  return createVolumeBlockTyped<Vec3IGrid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<Vec3fGrid>())  return createVolumeBlockTyped<Vec3fGrid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<Vec3dGrid>())  return createVolumeBlockTyped<Vec3dGrid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else if (grid->isType<MaskGrid>())   return createVolumeBlockTyped<MaskGrid>(grid, volumeRegistry, customData, compute, usableGrids, accesses, scatterData, leafOrder, listener);
+    else {
+        OPENVDB_THROW(TypeError, "Could not retrieve volume '" + grid->getName()
+                                 + "' as it has an unknown value type");
+    }
+}
+
 void registerVolumes(const GridPtrVec &grids, GridPtrVec &writeableGrids, GridPtrVec &usableGrids,
                      const VolumeRegistry::VolumeDataVec& volumeData)
 {
@@ -163,13 +442,29 @@ void registerVolumes(const GridPtrVec &grids, GridPtrVec &writeableGrids, GridPt
 
 void VolumeExecutable::execute(const openvdb::GridPtrVec& grids) const
 {
+    this->execute(grids, 1);
+}
+
+void VolumeExecutable::execute(const openvdb::GridPtrVec& grids, const size_t iterations) const
+{
+    ScopedPhase phase(mPhaseListener.get(), "execute");
+
     openvdb::GridPtrVec usableGrids, writeableGrids;
 
     registerVolumes(grids, writeableGrids, usableGrids, mVolumeRegistry->volumeData());
 
+    // values may be scattered into any of the provided grids. Every block executes the
+    // statements which do not assign a volume, so only the first block scatters values,
+    // rather than scattering them once per block
+    codegen::ScatterData scatterData(grids);
+    codegen::ScatterData* const scatterDataPtr = mScatters ? &scatterData : nullptr;
+
     using FunctionType = codegen::ComputeVolumeFunction;
     const int numBlocks = mBlockFunctionAddresses.size();
 
+    std::vector<VolumeBlock::UniquePtr> blocks;
+    blocks.reserve(numBlocks);
+
     for (int i = 0; i < numBlocks; i++) {
 
         FunctionType::SignaturePtr compute = nullptr;
@@ -186,88 +481,49 @@ void VolumeExecutable::execute(const openvdb::GridPtrVec& grids) const
         }
 
         const std::string& currentVolumeAssigned = mAssignedVolumes[i];
-        math::Transform::ConstPtr writeTransform = nullptr;
 
         // pointer to the grid which is being written to in the current block
         openvdb::GridBase::Ptr gridToModify = nullptr;
 
         for (const auto& grid : writeableGrids) {
             if (grid->getName() == currentVolumeAssigned) {
-                writeTransform = grid->transformPtr();
                 gridToModify = grid;
                 break;
             }
         }
 
-        // We execute over the topology of the grid currently being modified.  To do this, we need
-        // a typed tree and leaf manager
+        blocks.emplace_back(createVolumeBlock(gridToModify, *mVolumeRegistry,
+            *mCustomData, compute, usableGrids, mBlockAccesses.at(i),
+            i == 0 ? scatterDataPtr : nullptr, mLeafOrder, mPhaseListener.get()));
+    }
 
-        if (gridToModify->isType<BoolGrid>()) {
-            BoolGrid::Ptr typed = StaticPtrCast<BoolGrid>(gridToModify);
-            tree::LeafManager<BoolTree> leafManager(typed->tree());
-            VolumeExecuterOp<BoolTree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else if (gridToModify->isType<Int32Grid>()) {
-            Int32Grid::Ptr typed = StaticPtrCast<Int32Grid>(gridToModify);
-            tree::LeafManager<Int32Tree> leafManager(typed->tree());
-            VolumeExecuterOp<Int32Tree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                 compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else if (gridToModify->isType<Int64Grid>()) {
-            Int64Grid::Ptr typed = StaticPtrCast<Int64Grid>(gridToModify);
-            tree::LeafManager<Int64Tree> leafManager(typed->tree());
-            VolumeExecuterOp<Int64Tree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else if (gridToModify->isType<FloatGrid>()) {
-            FloatGrid::Ptr typed = StaticPtrCast<FloatGrid>(gridToModify);
-            tree::LeafManager<FloatTree> leafManager(typed->tree());
-            VolumeExecuterOp<FloatTree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else if (gridToModify->isType<DoubleGrid>()) {
-            DoubleGrid::Ptr typed = StaticPtrCast<DoubleGrid>(gridToModify);
-            tree::LeafManager<DoubleTree> leafManager(typed->tree());
-            VolumeExecuterOp<DoubleTree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else if (gridToModify->isType<Vec3IGrid>()) {
-            Vec3IGrid::Ptr typed = StaticPtrCast<Vec3IGrid>(gridToModify);
-            tree::LeafManager<Vec3ITree> leafManager(typed->tree());
-            VolumeExecuterOp<Vec3ITree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else if (gridToModify->isType<Vec3fGrid>()) {
-            Vec3fGrid::Ptr typed = StaticPtrCast<Vec3fGrid>(gridToModify);
-            tree::LeafManager<Vec3fTree> leafManager(typed->tree());
-            VolumeExecuterOp<Vec3fTree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else if (gridToModify->isType<Vec3dGrid>()) {
-            Vec3dGrid::Ptr typed = StaticPtrCast<Vec3dGrid>(gridToModify);
-            tree::LeafManager<Vec3dTree> leafManager(typed->tree());
-            VolumeExecuterOp<Vec3dTree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else if (gridToModify->isType<MaskGrid>()) {
-            MaskGrid::Ptr typed = StaticPtrCast<MaskGrid>(gridToModify);
-            tree::LeafManager<MaskTree> leafManager(typed->tree());
-            VolumeExecuterOp<MaskTree> executerOp(*mVolumeRegistry, *mCustomData, *writeTransform,
-                compute, usableGrids);
-            tbb::parallel_for(leafManager.leafRange(), executerOp);
-        }
-        else {
-            OPENVDB_THROW(TypeError, "Could not retrieve volume '" + gridToModify->getName()
-                                     + "' as it has an unknown value type");
+    // Every voxel is only ever read by the block which writes it at that voxel, so a
+    // single block can run all of its iterations on a leaf range at once. A later block
+    // may read voxels of other leaf nodes written by an earlier one, so multiple blocks
+    // are executed in turn for each iteration. Scattered values must be visible to the
+    // next iteration, so code which scatters is also run one iteration at a time.
+
+    if (blocks.size() == 1 && !mScatters) {
+        ScopedPhase kernelPhase(mPhaseListener.get(), "kernel");
+        blocks.front()->execute(iterations);
+        return;
+    }
+
+    for (size_t iteration = 0; iteration < iterations; ++iteration) {
+        for (const VolumeBlock::UniquePtr& block : blocks) {
+            {
+                ScopedPhase kernelPhase(mPhaseListener.get(), "kernel");
+                block->execute(1);
+            }
+
+            // the grids are only written by scatter functions once all leaf nodes of
+            // the iterated grid have been executed, so that no thread modifies a grid
+            // which may be accessed by another. Merging may add leaf nodes to any grid,
+            // so the leaf arrays and accessors of every block are rebuilt before any
+            // of them is executed again.
+            if (block == blocks.front() && scatterData.merge()) {
+                for (const VolumeBlock::UniquePtr& rebuilt : blocks) rebuilt->rebuild();
+            }
         }
     }
 }
@@ -38,7 +38,10 @@
 #ifndef OPENVDB_AX_COMPILER_VOLUME_EXECUTABLE_HAS_BEEN_INCLUDED
 #define OPENVDB_AX_COMPILER_VOLUME_EXECUTABLE_HAS_BEEN_INCLUDED
 
+#include <openvdb_ax/compiler/CompilerOptions.h>
 #include <openvdb_ax/compiler/CustomData.h>
+#include <openvdb_ax/compiler/PhaseListener.h>
+#include <openvdb_ax/compiler/Profiler.h>
 #include <openvdb_ax/compiler/TargetRegistry.h>
 
 #include <openvdb/openvdb.h>
@@ -75,6 +78,16 @@ public:
     /// @param functionAddresses A Vector of maps of function names to physical memory addresses which were built
     ///        by llvm using exeEngine
     /// @param assignedVolumes Vector of names of volumes which are written to, in order.
+    /// @param blockAccesses Vector of the registry indices of the volumes accessed by each
+    ///        block, in ascending order. Accessors are only bound for these volumes.
+    /// @param profiler Optional profiler which the compiled code records to, if it was
+    ///        compiled with CompilerOptions::profile
+    /// @param listener Optional listener which is notified of the "execute" phase
+    /// @param leafOrder The order in which the leaf nodes of each assigned volume are
+    ///        executed
+    /// @param scatters Whether the code calls any of the scatter functions. If false,
+    ///        no values are scattered and a single written volume runs every iteration
+    ///        on a leaf range at once
     /// @note  This object is normally be constructed by the Compiler::compile method, rather
     ///        than directly
     VolumeExecutable(const std::shared_ptr<const llvm::ExecutionEngine>& exeEngine,
@@ -82,19 +95,48 @@ public:
                      const VolumeRegistry::ConstPtr& volumeRegistry,
                      const CustomData::Ptr& customData,
                      const std::vector<std::map<std::string, uint64_t> >& functionAddresses,
-                     const std::vector<std::string>& assignedVolumes)
+                     const std::vector<std::string>& assignedVolumes,
+                     const std::vector<std::vector<size_t>>& blockAccesses,
+                     const Profiler::Ptr& profiler = Profiler::Ptr(),
+                     const PhaseListener::Ptr& listener = PhaseListener::Ptr(),
+                     const CompilerOptions::LeafOrder leafOrder = CompilerOptions::LeafOrder::TREE,
+                     const bool scatters = true)
         : mExecutionEngine(exeEngine)
         , mContext(context)
         , mVolumeRegistry(volumeRegistry)
         , mCustomData(customData)
         , mBlockFunctionAddresses(functionAddresses)
-        , mAssignedVolumes(assignedVolumes) {}
+        , mAssignedVolumes(assignedVolumes)
+        , mBlockAccesses(blockAccesses)
+        , mProfiler(profiler)
+        , mPhaseListener(listener)
+        , mLeafOrder(leafOrder)
+        , mScatters(scatters) {}
 
     ~VolumeExecutable() = default;
 
     /// @brief Execute AX code on target grids
+    /// @note  Values written by the scatter functions may target any of the given grids.
+    ///        They are held per thread and merged into the grids once the code which
+    ///        scattered them has been executed over every active voxel.
     void execute(const openvdb::GridPtrVec& grids) const;
 
+    /// @brief Execute AX code on target grids a number of times in succession
+    /// @details The grids, leaf managers and compiled functions are resolved once for all
+    ///          iterations. If the code writes a single volume, the accessors are also bound
+    ///          once per leaf range and every iteration is run over a leaf range before
+    ///          moving on, so that the leaf data remains in cache between iterations.
+    ///          Code which scatters values is instead run one iteration at a time, and
+    ///          the scattered values are merged between iterations.
+    /// @param grids Grids to apply code to
+    /// @param iterations The number of times to execute the code
+    void execute(const openvdb::GridPtrVec& grids, const size_t iterations) const;
+
+    /// @brief Returns the profiler holding the per statement and per function call
+    ///        counters accumulated over all calls to execute, or a null pointer if
+    ///        the code was not compiled with CompilerOptions::profile
+    inline Profiler::Ptr profiler() const { return mProfiler; }
+
 private:
 
     // these 2 shared pointers exist _only_ for object lifetime management
@@ -107,6 +149,16 @@ private:
     const CustomData::Ptr mCustomData;
     const std::vector<std::map<std::string, uint64_t> > mBlockFunctionAddresses;
     const std::vector<std::string> mAssignedVolumes;
+    // registry indices of the volumes accessed by each block
+    const std::vector<std::vector<size_t>> mBlockAccesses;
+    // counters of instrumented code, if compiled with profiling
+    const Profiler::Ptr mProfiler;
+    // optional listener of execution phases
+    const PhaseListener::Ptr mPhaseListener;
+    // order in which leaf nodes are executed
+    const CompilerOptions::LeafOrder mLeafOrder;
+    // whether the code calls any of the scatter functions
+    const bool mScatters;
 };
 
 }
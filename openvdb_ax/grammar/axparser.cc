@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.5"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -61,8 +66,8 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 31 "grammar/axparser.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 31 "grammar/axparser.y"
 
     #include <stdio.h>
     #include <iostream>
@@ -141,191 +146,229 @@
         }
     }
 
-#line 145 "grammar/axparser.cc" /* yacc.c:339  */
+    // Compact storage types have no type tokens and are parsed from identifiers.
+    // Returns a null pointer if the identifier is not a storage type
+    Attribute* buildStorageAttribute(const std::string& type, const std::string& name)
+    {
+        if (type == "half")  return new Attribute(name, openvdb::typeNameAsString<half>());
+        if (type == "int8")  return new Attribute(name, openvdb::typeNameAsString<int8_t>());
+        if (type == "uint8") return new Attribute(name, openvdb::typeNameAsString<uint8_t>());
+        return nullptr;
+    }
+
+#line 160 "grammar/axparser.cc"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "axparser.h".  */
-#ifndef YY_YY_GRAMMAR_AXPARSER_H_INCLUDED
-# define YY_YY_GRAMMAR_AXPARSER_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    TRUE = 258,
-    FALSE = 259,
-    SEMICOLON = 260,
-    AT = 261,
-    IF = 262,
-    ELSE = 263,
-    RETURN = 264,
-    EQUALS = 265,
-    PLUSEQUALS = 266,
-    MINUSEQUALS = 267,
-    MULTIPLYEQUALS = 268,
-    DIVIDEEQUALS = 269,
-    PLUSPLUS = 270,
-    MINUSMINUS = 271,
-    LPARENS = 272,
-    RPARENS = 273,
-    LCURLY = 274,
-    RCURLY = 275,
-    PLUS = 276,
-    MINUS = 277,
-    MULTIPLY = 278,
-    DIVIDE = 279,
-    MODULO = 280,
-    BITAND = 281,
-    BITOR = 282,
-    BITXOR = 283,
-    BITNOT = 284,
-    EQUALSEQUALS = 285,
-    NOTEQUALS = 286,
-    MORETHAN = 287,
-    LESSTHAN = 288,
-    MORETHANOREQUAL = 289,
-    LESSTHANOREQUAL = 290,
-    AND = 291,
-    OR = 292,
-    NOT = 293,
-    STRING = 294,
-    DOUBLE = 295,
-    FLOAT = 296,
-    LONG = 297,
-    INT = 298,
-    SHORT = 299,
-    BOOL = 300,
-    VOID = 301,
-    F_AT = 302,
-    I_AT = 303,
-    V_AT = 304,
-    S_AT = 305,
-    COMMA = 306,
-    VEC3I = 307,
-    VEC3F = 308,
-    VEC3D = 309,
-    DOT_X = 310,
-    DOT_Y = 311,
-    DOT_Z = 312,
-    L_SHORT = 313,
-    L_INT = 314,
-    L_LONG = 315,
-    L_FLOAT = 316,
-    L_DOUBLE = 317,
-    L_STRING = 318,
-    IDENTIFIER = 319,
-    LPAREN = 320,
-    RPAREN = 321,
-    LOWER_THAN_ELSE = 322
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "axparser.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 114 "grammar/axparser.y" /* yacc.c:355  */
-
-    const char* value_string;
-    uint64_t index;
-
-    openvdb::ax::ast::Tree* tree;
-    openvdb::ax::ast::ValueBase* value;
-    openvdb::ax::ast::VectorUnpack* vector_unpack;
-    openvdb::ax::ast::Block* block;
-    openvdb::ax::ast::Statement* statement;
-    openvdb::ax::ast::Expression* expression;
-    openvdb::ax::ast::ExpressionList* expressionlist;
-    openvdb::ax::ast::Variable* variable;
-    openvdb::ax::ast::Attribute* attribute;
-    openvdb::ax::ast::AttributeValue* attributevalue;
-    openvdb::ax::ast::DeclareLocal* declare_local;
-    openvdb::ax::ast::Local* local;
-
-#line 271 "grammar/axparser.cc" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_TRUE = 3,                       /* TRUE  */
+  YYSYMBOL_FALSE = 4,                      /* FALSE  */
+  YYSYMBOL_SEMICOLON = 5,                  /* SEMICOLON  */
+  YYSYMBOL_AT = 6,                         /* AT  */
+  YYSYMBOL_IF = 7,                         /* IF  */
+  YYSYMBOL_ELSE = 8,                       /* ELSE  */
+  YYSYMBOL_RETURN = 9,                     /* RETURN  */
+  YYSYMBOL_EQUALS = 10,                    /* EQUALS  */
+  YYSYMBOL_PLUSEQUALS = 11,                /* PLUSEQUALS  */
+  YYSYMBOL_MINUSEQUALS = 12,               /* MINUSEQUALS  */
+  YYSYMBOL_MULTIPLYEQUALS = 13,            /* MULTIPLYEQUALS  */
+  YYSYMBOL_DIVIDEEQUALS = 14,              /* DIVIDEEQUALS  */
+  YYSYMBOL_PLUSPLUS = 15,                  /* PLUSPLUS  */
+  YYSYMBOL_MINUSMINUS = 16,                /* MINUSMINUS  */
+  YYSYMBOL_LPARENS = 17,                   /* LPARENS  */
+  YYSYMBOL_RPARENS = 18,                   /* RPARENS  */
+  YYSYMBOL_LCURLY = 19,                    /* LCURLY  */
+  YYSYMBOL_RCURLY = 20,                    /* RCURLY  */
+  YYSYMBOL_PLUS = 21,                      /* PLUS  */
+  YYSYMBOL_MINUS = 22,                     /* MINUS  */
+  YYSYMBOL_MULTIPLY = 23,                  /* MULTIPLY  */
+  YYSYMBOL_DIVIDE = 24,                    /* DIVIDE  */
+  YYSYMBOL_MODULO = 25,                    /* MODULO  */
+  YYSYMBOL_BITAND = 26,                    /* BITAND  */
+  YYSYMBOL_BITOR = 27,                     /* BITOR  */
+  YYSYMBOL_BITXOR = 28,                    /* BITXOR  */
+  YYSYMBOL_BITNOT = 29,                    /* BITNOT  */
+  YYSYMBOL_EQUALSEQUALS = 30,              /* EQUALSEQUALS  */
+  YYSYMBOL_NOTEQUALS = 31,                 /* NOTEQUALS  */
+  YYSYMBOL_MORETHAN = 32,                  /* MORETHAN  */
+  YYSYMBOL_LESSTHAN = 33,                  /* LESSTHAN  */
+  YYSYMBOL_MORETHANOREQUAL = 34,           /* MORETHANOREQUAL  */
+  YYSYMBOL_LESSTHANOREQUAL = 35,           /* LESSTHANOREQUAL  */
+  YYSYMBOL_AND = 36,                       /* AND  */
+  YYSYMBOL_OR = 37,                        /* OR  */
+  YYSYMBOL_NOT = 38,                       /* NOT  */
+  YYSYMBOL_STRING = 39,                    /* STRING  */
+  YYSYMBOL_DOUBLE = 40,                    /* DOUBLE  */
+  YYSYMBOL_FLOAT = 41,                     /* FLOAT  */
+  YYSYMBOL_LONG = 42,                      /* LONG  */
+  YYSYMBOL_INT = 43,                       /* INT  */
+  YYSYMBOL_SHORT = 44,                     /* SHORT  */
+  YYSYMBOL_BOOL = 45,                      /* BOOL  */
+  YYSYMBOL_VOID = 46,                      /* VOID  */
+  YYSYMBOL_F_AT = 47,                      /* F_AT  */
+  YYSYMBOL_I_AT = 48,                      /* I_AT  */
+  YYSYMBOL_V_AT = 49,                      /* V_AT  */
+  YYSYMBOL_S_AT = 50,                      /* S_AT  */
+  YYSYMBOL_COMMA = 51,                     /* COMMA  */
+  YYSYMBOL_VEC3I = 52,                     /* VEC3I  */
+  YYSYMBOL_VEC3F = 53,                     /* VEC3F  */
+  YYSYMBOL_VEC3D = 54,                     /* VEC3D  */
+  YYSYMBOL_DOT_X = 55,                     /* DOT_X  */
+  YYSYMBOL_DOT_Y = 56,                     /* DOT_Y  */
+  YYSYMBOL_DOT_Z = 57,                     /* DOT_Z  */
+  YYSYMBOL_L_SHORT = 58,                   /* L_SHORT  */
+  YYSYMBOL_L_INT = 59,                     /* L_INT  */
+  YYSYMBOL_L_LONG = 60,                    /* L_LONG  */
+  YYSYMBOL_L_FLOAT = 61,                   /* L_FLOAT  */
+  YYSYMBOL_L_DOUBLE = 62,                  /* L_DOUBLE  */
+  YYSYMBOL_L_STRING = 63,                  /* L_STRING  */
+  YYSYMBOL_IDENTIFIER = 64,                /* IDENTIFIER  */
+  YYSYMBOL_LPAREN = 65,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 66,                    /* RPAREN  */
+  YYSYMBOL_LOWER_THAN_ELSE = 67,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_YYACCEPT = 68,                  /* $accept  */
+  YYSYMBOL_statements = 69,                /* statements  */
+  YYSYMBOL_block = 70,                     /* block  */
+  YYSYMBOL_body = 71,                      /* body  */
+  YYSYMBOL_statement = 72,                 /* statement  */
+  YYSYMBOL_conditional_statement = 73,     /* conditional_statement  */
+  YYSYMBOL_expression = 74,                /* expression  */
+  YYSYMBOL_vector_element = 75,            /* vector_element  */
+  YYSYMBOL_expression_expand = 76,         /* expression_expand  */
+  YYSYMBOL_cast_expression = 77,           /* cast_expression  */
+  YYSYMBOL_function_call_expression = 78,  /* function_call_expression  */
+  YYSYMBOL_arguments = 79,                 /* arguments  */
+  YYSYMBOL_declare_assignment = 80,        /* declare_assignment  */
+  YYSYMBOL_assign_expression = 81,         /* assign_expression  */
+  YYSYMBOL_assign_component_expression = 82, /* assign_component_expression  */
+  YYSYMBOL_crement = 83,                   /* crement  */
+  YYSYMBOL_unary_expression = 84,          /* unary_expression  */
+  YYSYMBOL_binary_expression = 85,         /* binary_expression  */
+  YYSYMBOL_vector_literal = 86,            /* vector_literal  */
+  YYSYMBOL_attribute = 87,                 /* attribute  */
+  YYSYMBOL_declare_local = 88,             /* declare_local  */
+  YYSYMBOL_local = 89,                     /* local  */
+  YYSYMBOL_literal = 90,                   /* literal  */
+  YYSYMBOL_component = 91,                 /* component  */
+  YYSYMBOL_scalar_type = 92,               /* scalar_type  */
+  YYSYMBOL_vector_type = 93                /* vector_type  */
 };
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
 
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-};
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
 
 
-extern YYSTYPE yylval;
-extern YYLTYPE yylloc;
-int yyparse (openvdb::ax::ast::Tree** tree);
+#ifdef short
+# undef short
+#endif
 
-#endif /* !YY_YY_GRAMMAR_AXPARSER_H_INCLUDED  */
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-#line 302 "grammar/axparser.cc" /* yacc.c:358  */
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#else
-typedef signed char yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -333,15 +376,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -355,47 +411,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -408,8 +460,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -474,8 +540,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -485,18 +550,19 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -509,11 +575,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -525,12 +591,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -540,30 +606,33 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  83
+#define YYFINAL  84
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   726
+#define YYLAST   728
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  68
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  26
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  119
+#define YYNRULES  120
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  199
+#define YYNSTATES  201
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   322
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -601,35 +670,43 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   204,   204,   205,   209,   210,   211,   215,   216,   222,
-     223,   224,   225,   226,   234,   235,   241,   242,   243,   244,
-     245,   246,   247,   248,   249,   250,   251,   252,   253,   260,
-     261,   266,   273,   278,   279,   284,   285,   292,   293,   302,
-     303,   304,   305,   306,   307,   308,   309,   310,   311,   322,
-     323,   324,   325,   326,   327,   328,   329,   330,   331,   340,
-     341,   342,   343,   344,   345,   346,   347,   352,   353,   354,
-     355,   361,   362,   363,   364,   365,   366,   367,   368,   369,
-     370,   371,   372,   373,   374,   375,   376,   381,   386,   387,
-     388,   389,   390,   391,   392,   393,   398,   399,   400,   407,
-     414,   415,   416,   417,   418,   419,   420,   421,   426,   427,
-     428,   434,   435,   436,   437,   438,   439,   445,   446,   447
+       0,   214,   214,   215,   219,   220,   221,   225,   226,   232,
+     233,   234,   235,   236,   244,   245,   251,   252,   253,   254,
+     255,   256,   257,   258,   259,   260,   261,   262,   263,   270,
+     271,   276,   283,   288,   289,   294,   295,   302,   303,   312,
+     313,   314,   315,   316,   317,   318,   319,   320,   321,   332,
+     333,   334,   335,   336,   337,   338,   339,   340,   341,   350,
+     351,   352,   353,   354,   355,   356,   357,   362,   363,   364,
+     365,   371,   372,   373,   374,   375,   376,   377,   378,   379,
+     380,   381,   382,   383,   384,   385,   386,   391,   396,   397,
+     398,   399,   400,   401,   402,   403,   404,   410,   411,   412,
+     419,   426,   427,   428,   429,   430,   431,   432,   433,   438,
+     439,   440,   446,   447,   448,   449,   450,   451,   457,   458,
+     459
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "TRUE", "FALSE", "SEMICOLON", "AT", "IF",
-  "ELSE", "RETURN", "EQUALS", "PLUSEQUALS", "MINUSEQUALS",
-  "MULTIPLYEQUALS", "DIVIDEEQUALS", "PLUSPLUS", "MINUSMINUS", "LPARENS",
-  "RPARENS", "LCURLY", "RCURLY", "PLUS", "MINUS", "MULTIPLY", "DIVIDE",
-  "MODULO", "BITAND", "BITOR", "BITXOR", "BITNOT", "EQUALSEQUALS",
-  "NOTEQUALS", "MORETHAN", "LESSTHAN", "MORETHANOREQUAL",
+  "\"end of file\"", "error", "\"invalid token\"", "TRUE", "FALSE",
+  "SEMICOLON", "AT", "IF", "ELSE", "RETURN", "EQUALS", "PLUSEQUALS",
+  "MINUSEQUALS", "MULTIPLYEQUALS", "DIVIDEEQUALS", "PLUSPLUS",
+  "MINUSMINUS", "LPARENS", "RPARENS", "LCURLY", "RCURLY", "PLUS", "MINUS",
+  "MULTIPLY", "DIVIDE", "MODULO", "BITAND", "BITOR", "BITXOR", "BITNOT",
+  "EQUALSEQUALS", "NOTEQUALS", "MORETHAN", "LESSTHAN", "MORETHANOREQUAL",
   "LESSTHANOREQUAL", "AND", "OR", "NOT", "STRING", "DOUBLE", "FLOAT",
   "LONG", "INT", "SHORT", "BOOL", "VOID", "F_AT", "I_AT", "V_AT", "S_AT",
   "COMMA", "VEC3I", "VEC3F", "VEC3D", "DOT_X", "DOT_Y", "DOT_Z", "L_SHORT",
@@ -643,180 +720,173 @@ static const char *const yytname[] =
   "declare_local", "local", "literal", "component", "scalar_type",
   "vector_type", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -58
+#define YYPACT_NINF (-49)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-58)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-     299,   -58,   -58,   -58,   -48,    19,    14,   511,   511,   485,
-     485,   485,   485,   485,   485,    11,   -58,   -58,   -58,   -58,
-     -58,   -58,    -8,    -7,     7,    29,   -58,   -58,   -58,   -58,
-     -58,   -58,   -58,   -58,   -58,    25,    64,   299,   -58,   -58,
-     593,   -58,   -58,   -58,   -58,    61,   -58,   -58,   -58,   -58,
-     -58,   -58,   114,    58,   556,   -58,     3,    12,   -58,   361,
-     -58,    68,   -58,   -58,   -58,    98,   110,   -58,   -58,   654,
-      23,   610,    21,    21,   -58,     0,    53,   -58,   -58,   -58,
-     -58,   -58,   423,   -58,   -58,   -58,   485,   485,   485,   485,
-     485,   485,   485,   485,   485,   485,   485,   485,   485,   485,
-     485,   485,   -58,   485,   485,   485,   485,   485,   -58,   -58,
-     -58,   -58,   -58,    49,   485,   485,   485,   485,   485,   485,
-     -58,   -58,    89,    54,   -58,   -58,    56,   -58,   175,    62,
-     -58,   -58,   485,   -58,   -58,   689,   -10,    21,    21,    96,
-      96,   -58,    90,    90,    90,     0,     0,    27,    27,    27,
-      27,     0,     0,   689,   689,   689,   689,   689,   485,   485,
-     485,   485,   485,   689,   689,   689,   689,   689,   689,   485,
-     485,   485,   485,   485,   -58,   -58,   -58,   237,   557,   361,
-     632,   -58,   485,   689,   689,   689,   689,   689,   689,   689,
-     689,   689,   689,   -58,   -58,   485,   689,   672,   -58
+     301,   -49,   -49,   -49,   -48,    19,    14,   513,   513,   487,
+     487,   487,   487,   487,   487,    11,   -49,   -49,   -49,   -49,
+     -49,   -49,   -25,   -16,     9,    13,   -49,   -49,   -49,   -49,
+     -49,   -49,   -49,   -49,   -49,    23,    42,   301,   -49,   -49,
+     595,   -49,   -49,   -49,   -49,    59,   -49,   -49,   -49,   -49,
+     -49,   -49,   115,    56,   558,   -49,     3,    12,   -49,   363,
+     -49,    62,    88,   -49,   -49,    99,   111,   -49,   -49,   656,
+      32,   612,    21,    21,   -49,     0,    54,   -49,   -49,   -49,
+     -49,   -49,    55,   425,   -49,   -49,   -49,   487,   487,   487,
+     487,   487,   487,   487,   487,   487,   487,   487,   487,   487,
+     487,   487,   487,   -49,   487,   487,   487,   487,   487,   -49,
+     -49,   -49,   -49,   -49,    49,   487,   487,   487,   487,   487,
+     487,   -49,   -49,    90,    57,   -49,   -49,    58,   -49,   177,
+     124,   -49,   -49,   487,   -49,   -49,   -49,   691,   -10,    21,
+      21,    98,    98,   -49,    91,    91,    91,     0,     0,    29,
+      29,    29,    29,     0,     0,   691,   691,   691,   691,   691,
+     487,   487,   487,   487,   487,   691,   691,   691,   691,   691,
+     691,   487,   487,   487,   487,   487,   -49,   -49,   -49,   239,
+     559,   363,   634,   -49,   487,   691,   691,   691,   691,   691,
+     691,   691,   691,   691,   691,   -49,   -49,   487,   691,   674,
+     -49
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       2,   106,   107,    13,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,   116,   115,   114,   113,
-     112,   111,     0,     0,     0,     0,   117,   118,   119,   100,
-     101,   102,   103,   104,   105,    99,     0,     3,     8,    11,
+       2,   107,   108,    13,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   117,   116,   115,   114,
+     113,   112,     0,     0,     0,     0,   118,   119,   120,   101,
+     102,   103,   104,   105,   106,   100,     0,     3,     8,    11,
        0,    25,    16,    23,    17,     0,    20,    21,    22,    19,
       18,    24,    28,    38,    27,    26,     0,     0,    95,     0,
-      12,     0,    99,    59,    63,     0,     0,    60,    64,     0,
-       0,     0,    67,    68,    69,    70,     0,    98,    91,    90,
-      92,    93,     0,     1,     7,     9,     0,     0,     0,     0,
+      12,     0,   100,    59,    63,     0,     0,    60,    64,     0,
+       0,     0,    67,    68,    69,    70,     0,    99,    91,    90,
+      92,    93,     0,     0,     1,     7,     9,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    10,     0,     0,     0,     0,     0,    61,    62,
-     108,   109,   110,    29,     0,     0,     0,     0,     0,     0,
-      65,    66,    30,     0,    96,    32,     0,    97,     0,    14,
-       6,    31,     0,    94,    34,    35,     0,    71,    72,    73,
-      74,    75,    76,    77,    78,    81,    82,    83,    84,    85,
-      86,    79,    80,    39,    40,    41,    42,    43,     0,     0,
-       0,     0,     0,    37,    44,    45,    46,    47,    48,     0,
-       0,     0,     0,     0,    88,    89,     5,     0,     0,     0,
-       0,    33,     0,    49,    50,    51,    52,    53,    54,    55,
-      56,    57,    58,     4,    15,     0,    36,     0,    87
+       0,     0,     0,    10,     0,     0,     0,     0,     0,    61,
+      62,   109,   110,   111,    29,     0,     0,     0,     0,     0,
+       0,    65,    66,    30,     0,    97,    32,     0,    98,     0,
+      14,     6,    31,     0,    94,    96,    34,    35,     0,    71,
+      72,    73,    74,    75,    76,    77,    78,    81,    82,    83,
+      84,    85,    86,    79,    80,    39,    40,    41,    42,    43,
+       0,     0,     0,     0,     0,    37,    44,    45,    46,    47,
+      48,     0,     0,     0,     0,     0,    88,    89,     5,     0,
+       0,     0,     0,    33,     0,    49,    50,    51,    52,    53,
+      54,    55,    56,    57,    58,     4,    15,     0,    36,     0,
+      87
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -58,   -58,   -57,     5,   -22,   -58,    -9,   -58,     2,   -58,
-     -58,   -58,   -58,   -58,   -58,   -58,   -58,   -58,   -58,     4,
-     -58,    31,   -58,    77,     6,    10
+     -49,   -49,   -47,     7,   -22,   -49,    -9,   -49,     2,   -49,
+     -49,   -49,   -49,   -49,   -49,   -49,   -49,   -49,   -49,     4,
+     -49,    63,   -49,    79,     6,    10
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    36,   129,    37,    38,    39,    40,    41,    42,    43,
-      44,   136,    45,    46,    47,    48,    49,    50,    51,    52,
-      53,    54,    55,   113,    70,    66
+       0,    36,   130,    37,    38,    39,    40,    41,    42,    43,
+      44,   138,    45,    46,    47,    48,    49,    50,    51,    52,
+      53,    54,    55,   114,    70,    66
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
-      69,    71,    72,    73,    74,    75,    56,    59,   181,   123,
-      57,    63,    67,    65,    65,    84,    58,    76,   126,    60,
-       9,    86,    87,    88,    89,    90,    91,    92,    93,   123,
-      94,    95,    96,    97,    98,    99,     9,   130,    64,    68,
-       9,   182,    82,    56,    88,    89,    90,    57,    86,    87,
-      88,    89,    90,    91,    92,    93,    78,    79,   125,   158,
-     159,   160,   161,   162,    83,    56,   102,   124,   114,    57,
-     179,    80,   125,   135,    76,    77,   127,   137,   138,   139,
-     140,   141,   142,   143,   144,   145,   146,   147,   148,   149,
-     150,   151,   152,    81,   153,   154,   155,   156,   157,   169,
-     170,   171,   172,   173,   123,   163,   164,   165,   166,   167,
-     168,    86,    87,    88,    89,    90,   126,   133,   174,   178,
-     175,    90,   194,   180,   103,   104,   105,   106,   107,   108,
-     109,   122,     0,   177,    56,     0,     0,     0,    57,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,   183,
-     184,   185,   186,   187,     0,    84,     0,   130,     0,     0,
-     188,   189,   190,   191,   192,     0,     0,     0,     0,   110,
-     111,   112,     0,   196,     0,     0,     0,     0,     1,     2,
-       3,     4,     5,    56,     6,    56,   197,    57,     0,    57,
-       7,     8,     9,     0,    10,   176,    11,    12,     0,     0,
-       0,     0,     0,     0,    13,     0,     0,     0,     0,     0,
-       0,     0,     0,    14,    15,    16,    17,    18,    19,    20,
-      21,     0,    22,    23,    24,    25,     0,    26,    27,    28,
-       0,     0,     0,    29,    30,    31,    32,    33,    34,    35,
-       1,     2,     3,     4,     5,     0,     6,     0,     0,     0,
-       0,     0,     7,     8,     9,     0,    10,   193,    11,    12,
+      69,    71,    72,    73,    74,    75,    56,    59,   183,   124,
+      57,    63,    67,    65,    65,    85,    58,    76,   127,    60,
+       9,    87,    88,    89,    90,    91,    92,    93,    94,    82,
+      95,    96,    97,    98,    99,   100,     9,   131,   124,    78,
+      83,   184,    84,    56,    89,    90,    91,    57,    79,     9,
+      87,    88,    89,    90,    91,    92,    93,    94,   126,   160,
+     161,   162,   163,   164,   103,    56,   115,   125,    76,    57,
+      64,    68,   126,    80,   137,    77,   128,    81,   139,   140,
+     141,   142,   143,   144,   145,   146,   147,   148,   149,   150,
+     151,   152,   153,   154,    82,   155,   156,   157,   158,   159,
+     171,   172,   173,   174,   175,   124,   165,   166,   167,   168,
+     169,   170,    87,    88,    89,    90,    91,   127,   134,   135,
+     180,   176,   177,    91,   182,   104,   105,   106,   107,   108,
+     109,   110,   181,   123,   196,    56,   179,     0,     0,    57,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,   185,   186,   187,   188,   189,     0,    85,     0,   131,
+       0,     0,   190,   191,   192,   193,   194,     0,     0,     0,
+     111,   112,   113,     0,     0,   198,     0,     0,     0,     0,
+       1,     2,     3,     4,     5,    56,     6,    56,   199,    57,
+       0,    57,     7,     8,     9,     0,    10,   178,    11,    12,
        0,     0,     0,     0,     0,     0,    13,     0,     0,     0,
        0,     0,     0,     0,     0,    14,    15,    16,    17,    18,
       19,    20,    21,     0,    22,    23,    24,    25,     0,    26,
       27,    28,     0,     0,     0,    29,    30,    31,    32,    33,
       34,    35,     1,     2,     3,     4,     5,     0,     6,     0,
-       0,     0,     0,     0,     7,     8,     9,     0,    10,     0,
+       0,     0,     0,     0,     7,     8,     9,     0,    10,   195,
       11,    12,     0,     0,     0,     0,     0,     0,    13,     0,
        0,     0,     0,     0,     0,     0,     0,    14,    15,    16,
       17,    18,    19,    20,    21,     0,    22,    23,    24,    25,
        0,    26,    27,    28,     0,     0,     0,    29,    30,    31,
       32,    33,    34,    35,     1,     2,     3,     4,     5,     0,
        6,     0,     0,     0,     0,     0,     7,     8,     9,     0,
-     128,     0,    11,    12,     0,     0,     0,     0,     0,     0,
+      10,     0,    11,    12,     0,     0,     0,     0,     0,     0,
       13,     0,     0,     0,     0,     0,     0,     0,     0,    14,
       15,    16,    17,    18,    19,    20,    21,     0,    22,    23,
       24,    25,     0,    26,    27,    28,     0,     0,     0,    29,
-      30,    31,    32,    33,    34,    35,     1,     2,     0,     4,
-       0,     0,     0,     0,     0,     0,     0,     0,     7,     8,
-       9,   134,    10,     0,    11,    12,     0,     0,     0,     0,
+      30,    31,    32,    33,    34,    35,     1,     2,     3,     4,
+       5,     0,     6,     0,     0,     0,     0,     0,     7,     8,
+       9,     0,   129,     0,    11,    12,     0,     0,     0,     0,
        0,     0,    13,     0,     0,     0,     0,     0,     0,     0,
-       0,    14,    61,    16,    17,    18,    19,    20,    21,     0,
+       0,    14,    15,    16,    17,    18,    19,    20,    21,     0,
       22,    23,    24,    25,     0,    26,    27,    28,     0,     0,
        0,    29,    30,    31,    32,    33,    34,    35,     1,     2,
        0,     4,     0,     0,     0,     0,     0,     0,     0,     0,
-       7,     8,     9,     0,    10,     0,    11,    12,     0,     0,
-       0,     0,     0,     0,    13,     0,     0,     4,     0,     0,
+       7,     8,     9,   136,    10,     0,    11,    12,     0,     0,
+       0,     0,     0,     0,    13,     0,     0,     0,     0,     0,
        0,     0,     0,    14,    61,    16,    17,    18,    19,    20,
       21,     0,    22,    23,    24,    25,     0,    26,    27,    28,
        0,     0,     0,    29,    30,    31,    32,    33,    34,    35,
-      61,    16,    17,    18,    19,    20,    21,     0,    22,    23,
-      24,    25,    85,    26,    27,    28,   115,   116,   117,   118,
-     119,   120,   121,     0,     0,    62,     0,     0,    86,    87,
-      88,    89,    90,    91,    92,    93,     0,    94,    95,    96,
-      97,    98,    99,   100,   101,     0,     0,     0,    85,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,   132,     0,
-       0,   110,   111,   112,    86,    87,    88,    89,    90,    91,
-      92,    93,     0,    94,    95,    96,    97,    98,    99,   100,
-     101,    86,    87,    88,    89,    90,    91,    92,    93,     0,
-      94,    95,    96,    97,    98,    99,   100,   101,     0,     0,
-       0,     0,     0,    86,    87,    88,    89,    90,    91,    92,
-      93,   132,    94,    95,    96,    97,    98,    99,   100,   101,
-       0,     0,   131,     0,     0,    86,    87,    88,    89,    90,
-      91,    92,    93,   195,    94,    95,    96,    97,    98,    99,
-     100,   101,   198,    86,    87,    88,    89,    90,    91,    92,
-      93,     0,    94,    95,    96,    97,    98,    99,   100,   101,
-      86,    87,    88,    89,    90,    91,    92,    93,     0,    94,
-      95,    96,    97,    98,    99,   100,   101
+       1,     2,     0,     4,     0,     0,     0,     0,     0,     0,
+       0,     0,     7,     8,     9,     0,    10,     0,    11,    12,
+       0,     0,     0,     0,     0,     0,    13,     0,     0,     4,
+       0,     0,     0,     0,     0,    14,    61,    16,    17,    18,
+      19,    20,    21,     0,    22,    23,    24,    25,     0,    26,
+      27,    28,     0,     0,     0,    29,    30,    31,    32,    33,
+      34,    35,    61,    16,    17,    18,    19,    20,    21,     0,
+      22,    23,    24,    25,    86,    26,    27,    28,   116,   117,
+     118,   119,   120,   121,   122,     0,     0,    62,     0,     0,
+      87,    88,    89,    90,    91,    92,    93,    94,     0,    95,
+      96,    97,    98,    99,   100,   101,   102,     0,     0,     0,
+      86,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+     133,     0,     0,   111,   112,   113,    87,    88,    89,    90,
+      91,    92,    93,    94,     0,    95,    96,    97,    98,    99,
+     100,   101,   102,    87,    88,    89,    90,    91,    92,    93,
+      94,     0,    95,    96,    97,    98,    99,   100,   101,   102,
+       0,     0,     0,     0,     0,    87,    88,    89,    90,    91,
+      92,    93,    94,   133,    95,    96,    97,    98,    99,   100,
+     101,   102,     0,     0,   132,     0,     0,    87,    88,    89,
+      90,    91,    92,    93,    94,   197,    95,    96,    97,    98,
+      99,   100,   101,   102,   200,    87,    88,    89,    90,    91,
+      92,    93,    94,     0,    95,    96,    97,    98,    99,   100,
+     101,   102,    87,    88,    89,    90,    91,    92,    93,    94,
+       0,    95,    96,    97,    98,    99,   100,   101,   102
 };
 
 static const yytype_int16 yycheck[] =
@@ -824,35 +894,29 @@ static const yytype_int16 yycheck[] =
        9,    10,    11,    12,    13,    14,     0,     5,    18,     6,
        0,     7,     8,     7,     8,    37,    64,     6,     6,     5,
       17,    21,    22,    23,    24,    25,    26,    27,    28,     6,
-      30,    31,    32,    33,    34,    35,    17,    59,     7,     8,
-      17,    51,    17,    37,    23,    24,    25,    37,    21,    22,
-      23,    24,    25,    26,    27,    28,    64,    64,    56,    10,
-      11,    12,    13,    14,     0,    59,     5,    64,    10,    59,
-       8,    64,    70,    82,     6,    64,    64,    86,    87,    88,
+      30,    31,    32,    33,    34,    35,    17,    59,     6,    64,
+      17,    51,     0,    37,    23,    24,    25,    37,    64,    17,
+      21,    22,    23,    24,    25,    26,    27,    28,    56,    10,
+      11,    12,    13,    14,     5,    59,    10,    64,     6,    59,
+       7,     8,    70,    64,    83,    64,    64,    64,    87,    88,
       89,    90,    91,    92,    93,    94,    95,    96,    97,    98,
-      99,   100,   101,    64,   103,   104,   105,   106,   107,    10,
-      11,    12,    13,    14,     6,   114,   115,   116,   117,   118,
-     119,    21,    22,    23,    24,    25,     6,    64,    64,   128,
-      64,    25,   179,   132,    10,    11,    12,    13,    14,    15,
-      16,    54,    -1,   128,   128,    -1,    -1,    -1,   128,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   158,
-     159,   160,   161,   162,    -1,   177,    -1,   179,    -1,    -1,
-     169,   170,   171,   172,   173,    -1,    -1,    -1,    -1,    55,
-      56,    57,    -1,   182,    -1,    -1,    -1,    -1,     3,     4,
-       5,     6,     7,   177,     9,   179,   195,   177,    -1,   179,
-      15,    16,    17,    -1,    19,    20,    21,    22,    -1,    -1,
-      -1,    -1,    -1,    -1,    29,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    38,    39,    40,    41,    42,    43,    44,
-      45,    -1,    47,    48,    49,    50,    -1,    52,    53,    54,
-      -1,    -1,    -1,    58,    59,    60,    61,    62,    63,    64,
-       3,     4,     5,     6,     7,    -1,     9,    -1,    -1,    -1,
-      -1,    -1,    15,    16,    17,    -1,    19,    20,    21,    22,
+      99,   100,   101,   102,     6,   104,   105,   106,   107,   108,
+      10,    11,    12,    13,    14,     6,   115,   116,   117,   118,
+     119,   120,    21,    22,    23,    24,    25,     6,    64,    64,
+     129,    64,    64,    25,   133,    10,    11,    12,    13,    14,
+      15,    16,     8,    54,   181,   129,   129,    -1,    -1,   129,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,   160,   161,   162,   163,   164,    -1,   179,    -1,   181,
+      -1,    -1,   171,   172,   173,   174,   175,    -1,    -1,    -1,
+      55,    56,    57,    -1,    -1,   184,    -1,    -1,    -1,    -1,
+       3,     4,     5,     6,     7,   179,     9,   181,   197,   179,
+      -1,   181,    15,    16,    17,    -1,    19,    20,    21,    22,
       -1,    -1,    -1,    -1,    -1,    -1,    29,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    38,    39,    40,    41,    42,
       43,    44,    45,    -1,    47,    48,    49,    50,    -1,    52,
       53,    54,    -1,    -1,    -1,    58,    59,    60,    61,    62,
       63,    64,     3,     4,     5,     6,     7,    -1,     9,    -1,
-      -1,    -1,    -1,    -1,    15,    16,    17,    -1,    19,    -1,
+      -1,    -1,    -1,    -1,    15,    16,    17,    -1,    19,    20,
       21,    22,    -1,    -1,    -1,    -1,    -1,    -1,    29,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    38,    39,    40,
       41,    42,    43,    44,    45,    -1,    47,    48,    49,    50,
@@ -863,42 +927,48 @@ static const yytype_int16 yycheck[] =
       29,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    38,
       39,    40,    41,    42,    43,    44,    45,    -1,    47,    48,
       49,    50,    -1,    52,    53,    54,    -1,    -1,    -1,    58,
-      59,    60,    61,    62,    63,    64,     3,     4,    -1,     6,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    15,    16,
-      17,    18,    19,    -1,    21,    22,    -1,    -1,    -1,    -1,
+      59,    60,    61,    62,    63,    64,     3,     4,     5,     6,
+       7,    -1,     9,    -1,    -1,    -1,    -1,    -1,    15,    16,
+      17,    -1,    19,    -1,    21,    22,    -1,    -1,    -1,    -1,
       -1,    -1,    29,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    38,    39,    40,    41,    42,    43,    44,    45,    -1,
       47,    48,    49,    50,    -1,    52,    53,    54,    -1,    -1,
       -1,    58,    59,    60,    61,    62,    63,    64,     3,     4,
       -1,     6,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      15,    16,    17,    -1,    19,    -1,    21,    22,    -1,    -1,
-      -1,    -1,    -1,    -1,    29,    -1,    -1,     6,    -1,    -1,
+      15,    16,    17,    18,    19,    -1,    21,    22,    -1,    -1,
+      -1,    -1,    -1,    -1,    29,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    -1,    38,    39,    40,    41,    42,    43,    44,
       45,    -1,    47,    48,    49,    50,    -1,    52,    53,    54,
       -1,    -1,    -1,    58,    59,    60,    61,    62,    63,    64,
-      39,    40,    41,    42,    43,    44,    45,    -1,    47,    48,
-      49,    50,     5,    52,    53,    54,    10,    11,    12,    13,
-      14,    15,    16,    -1,    -1,    64,    -1,    -1,    21,    22,
-      23,    24,    25,    26,    27,    28,    -1,    30,    31,    32,
-      33,    34,    35,    36,    37,    -1,    -1,    -1,     5,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    51,    -1,
-      -1,    55,    56,    57,    21,    22,    23,    24,    25,    26,
-      27,    28,    -1,    30,    31,    32,    33,    34,    35,    36,
-      37,    21,    22,    23,    24,    25,    26,    27,    28,    -1,
-      30,    31,    32,    33,    34,    35,    36,    37,    -1,    -1,
-      -1,    -1,    -1,    21,    22,    23,    24,    25,    26,    27,
-      28,    51,    30,    31,    32,    33,    34,    35,    36,    37,
-      -1,    -1,    18,    -1,    -1,    21,    22,    23,    24,    25,
-      26,    27,    28,    51,    30,    31,    32,    33,    34,    35,
-      36,    37,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    -1,    30,    31,    32,    33,    34,    35,    36,    37,
+       3,     4,    -1,     6,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    15,    16,    17,    -1,    19,    -1,    21,    22,
+      -1,    -1,    -1,    -1,    -1,    -1,    29,    -1,    -1,     6,
+      -1,    -1,    -1,    -1,    -1,    38,    39,    40,    41,    42,
+      43,    44,    45,    -1,    47,    48,    49,    50,    -1,    52,
+      53,    54,    -1,    -1,    -1,    58,    59,    60,    61,    62,
+      63,    64,    39,    40,    41,    42,    43,    44,    45,    -1,
+      47,    48,    49,    50,     5,    52,    53,    54,    10,    11,
+      12,    13,    14,    15,    16,    -1,    -1,    64,    -1,    -1,
       21,    22,    23,    24,    25,    26,    27,    28,    -1,    30,
-      31,    32,    33,    34,    35,    36,    37
+      31,    32,    33,    34,    35,    36,    37,    -1,    -1,    -1,
+       5,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      51,    -1,    -1,    55,    56,    57,    21,    22,    23,    24,
+      25,    26,    27,    28,    -1,    30,    31,    32,    33,    34,
+      35,    36,    37,    21,    22,    23,    24,    25,    26,    27,
+      28,    -1,    30,    31,    32,    33,    34,    35,    36,    37,
+      -1,    -1,    -1,    -1,    -1,    21,    22,    23,    24,    25,
+      26,    27,    28,    51,    30,    31,    32,    33,    34,    35,
+      36,    37,    -1,    -1,    18,    -1,    -1,    21,    22,    23,
+      24,    25,    26,    27,    28,    51,    30,    31,    32,    33,
+      34,    35,    36,    37,    20,    21,    22,    23,    24,    25,
+      26,    27,    28,    -1,    30,    31,    32,    33,    34,    35,
+      36,    37,    21,    22,    23,    24,    25,    26,    27,    28,
+      -1,    30,    31,    32,    33,    34,    35,    36,    37
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     3,     4,     5,     6,     7,     9,    15,    16,    17,
       19,    21,    22,    29,    38,    39,    40,    41,    42,    43,
@@ -908,22 +978,23 @@ static const yytype_uint8 yystos[] =
       85,    86,    87,    88,    89,    90,    92,    93,    64,    76,
        5,    39,    64,    87,    89,    92,    93,    87,    89,    74,
       92,    74,    74,    74,    74,    74,     6,    64,    64,    64,
-      64,    64,    17,     0,    72,     5,    21,    22,    23,    24,
-      25,    26,    27,    28,    30,    31,    32,    33,    34,    35,
-      36,    37,     5,    10,    11,    12,    13,    14,    15,    16,
-      55,    56,    57,    91,    10,    10,    11,    12,    13,    14,
-      15,    16,    91,     6,    64,    76,     6,    64,    19,    70,
-      72,    18,    51,    64,    18,    74,    79,    74,    74,    74,
+      64,    64,     6,    17,     0,    72,     5,    21,    22,    23,
+      24,    25,    26,    27,    28,    30,    31,    32,    33,    34,
+      35,    36,    37,     5,    10,    11,    12,    13,    14,    15,
+      16,    55,    56,    57,    91,    10,    10,    11,    12,    13,
+      14,    15,    16,    91,     6,    64,    76,     6,    64,    19,
+      70,    72,    18,    51,    64,    64,    18,    74,    79,    74,
       74,    74,    74,    74,    74,    74,    74,    74,    74,    74,
-      74,    74,    74,    74,    74,    74,    74,    74,    10,    11,
-      12,    13,    14,    74,    74,    74,    74,    74,    74,    10,
-      11,    12,    13,    14,    64,    64,    20,    71,    74,     8,
-      74,    18,    51,    74,    74,    74,    74,    74,    74,    74,
-      74,    74,    74,    20,    70,    51,    74,    74,    20
+      74,    74,    74,    74,    74,    74,    74,    74,    74,    74,
+      10,    11,    12,    13,    14,    74,    74,    74,    74,    74,
+      74,    10,    11,    12,    13,    14,    64,    64,    20,    71,
+      74,     8,    74,    18,    51,    74,    74,    74,    74,    74,
+      74,    74,    74,    74,    74,    20,    70,    51,    74,    74,
+      20
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    68,    69,    69,    70,    70,    70,    71,    71,    72,
       72,    72,    72,    72,    73,    73,    74,    74,    74,    74,
@@ -934,13 +1005,14 @@ static const yytype_uint8 yyr1[] =
       83,    83,    83,    83,    83,    83,    83,    84,    84,    84,
       84,    85,    85,    85,    85,    85,    85,    85,    85,    85,
       85,    85,    85,    85,    85,    85,    85,    86,    87,    87,
-      87,    87,    87,    87,    87,    87,    88,    88,    88,    89,
-      90,    90,    90,    90,    90,    90,    90,    90,    91,    91,
-      91,    92,    92,    92,    92,    92,    92,    93,    93,    93
+      87,    87,    87,    87,    87,    87,    87,    88,    88,    88,
+      89,    90,    90,    90,    90,    90,    90,    90,    90,    91,
+      91,    91,    92,    92,    92,    92,    92,    92,    93,    93,
+      93
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     0,     1,     3,     2,     1,     2,     1,     2,
        2,     1,     2,     1,     3,     5,     1,     1,     1,     1,
@@ -951,45 +1023,46 @@ static const yytype_uint8 yyr2[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     3,     3,     3,     3,     3,     3,     3,     3,     3,
        3,     3,     3,     3,     3,     3,     3,     7,     3,     3,
-       2,     2,     2,     2,     3,     2,     2,     2,     2,     1,
+       2,     2,     2,     2,     3,     2,     3,     2,     2,     2,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1
+       1
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (tree, YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (tree, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -1033,20 +1106,27 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
 YY_ATTRIBUTE_UNUSED
-static unsigned
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
@@ -1066,64 +1146,72 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
 
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location, tree); \
+                  Kind, Value, Location, tree); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, openvdb::ax::ast::Tree** tree)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, openvdb::ax::ast::Tree** tree)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (yylocationp);
-  YYUSE (tree);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (tree);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, openvdb::ax::ast::Tree** tree)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, openvdb::ax::ast::Tree** tree)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp, tree);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, tree);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1132,7 +1220,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYL
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1155,21 +1243,22 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule, openvdb::ax::ast::Tree** tree)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, openvdb::ax::ast::Tree** tree)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       , tree);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), tree);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1184,8 +1273,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1208,28 +1297,77 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1243,10 +1381,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1254,14 +1392,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1272,7 +1409,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -1287,36 +1427,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1340,49 +1464,54 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1390,14 +1519,23 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1406,7 +1544,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1418,42 +1556,41 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, openvdb::ax::ast::Tree** tree)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, openvdb::ax::ast::Tree** tree)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-  YYUSE (tree);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (tree);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
@@ -1468,6 +1605,8 @@ YYLTYPE yylloc
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1475,53 +1614,48 @@ int yynerrs;
 int
 yyparse (openvdb::ax::ast::Tree** tree)
 {
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1529,43 +1663,49 @@ yyparse (openvdb::ax::ast::Tree** tree)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
         YYLTYPE *yyls1 = yyls;
 
         /* Each stack pointer address is followed by the size of the
@@ -1573,32 +1713,29 @@ yyparse (openvdb::ax::ast::Tree** tree)
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yyls1, yysize * sizeof (*yylsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
                     &yystacksize);
-
-        yyls = yyls1;
         yyss = yyss1;
         yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1607,31 +1744,32 @@ yyparse (openvdb::ax::ast::Tree** tree)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1642,18 +1780,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1681,15 +1831,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1704,7 +1853,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1726,716 +1875,724 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 204 "grammar/axparser.y" /* yacc.c:1648  */
-    { *tree = new Tree(); (yyval.tree) = *tree; }
-#line 1733 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 2: /* statements: %empty  */
+#line 214 "grammar/axparser.y"
+      { *tree = new Tree(); (yyval.tree) = *tree; }
+#line 1882 "grammar/axparser.cc"
     break;
 
-  case 3:
-#line 205 "grammar/axparser.y" /* yacc.c:1648  */
-    { *tree = new Tree((yyvsp[0].block)); (yyval.tree) = *tree; }
-#line 1739 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 3: /* statements: body  */
+#line 215 "grammar/axparser.y"
+           { *tree = new Tree((yyvsp[0].block)); (yyval.tree) = *tree; }
+#line 1888 "grammar/axparser.cc"
     break;
 
-  case 4:
-#line 209 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.block) = (yyvsp[-1].block); }
-#line 1745 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 4: /* block: LCURLY body RCURLY  */
+#line 219 "grammar/axparser.y"
+                          { (yyval.block) = (yyvsp[-1].block); }
+#line 1894 "grammar/axparser.cc"
     break;
 
-  case 5:
-#line 210 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.block) = new Block(); }
-#line 1751 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 5: /* block: LCURLY RCURLY  */
+#line 220 "grammar/axparser.y"
+                          { (yyval.block) = new Block(); }
+#line 1900 "grammar/axparser.cc"
     break;
 
-  case 6:
-#line 211 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.block) = new Block(); if((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
-#line 1757 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 6: /* block: statement  */
+#line 221 "grammar/axparser.y"
+                          { (yyval.block) = new Block(); if((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
+#line 1906 "grammar/axparser.cc"
     break;
 
-  case 7:
-#line 215 "grammar/axparser.y" /* yacc.c:1648  */
-    { if ((yyvsp[0].statement)) (yyvsp[-1].block)->mList.emplace_back((yyvsp[0].statement)); (yyval.block) = (yyvsp[-1].block); }
-#line 1763 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 7: /* body: body statement  */
+#line 225 "grammar/axparser.y"
+                      { if ((yyvsp[0].statement)) (yyvsp[-1].block)->mList.emplace_back((yyvsp[0].statement)); (yyval.block) = (yyvsp[-1].block); }
+#line 1912 "grammar/axparser.cc"
     break;
 
-  case 8:
-#line 216 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.block) = new Block(); if ((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
-#line 1769 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 8: /* body: statement  */
+#line 226 "grammar/axparser.y"
+                      { (yyval.block) = new Block(); if ((yyvsp[0].statement)) (yyval.block)->mList.emplace_back((yyvsp[0].statement)); }
+#line 1918 "grammar/axparser.cc"
     break;
 
-  case 9:
-#line 222 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = (yyvsp[-1].expression); }
-#line 1775 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 9: /* statement: expression SEMICOLON  */
+#line 232 "grammar/axparser.y"
+                                    { (yyval.statement) = (yyvsp[-1].expression); }
+#line 1924 "grammar/axparser.cc"
     break;
 
-  case 10:
-#line 223 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = (yyvsp[-1].statement); }
-#line 1781 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 10: /* statement: declare_assignment SEMICOLON  */
+#line 233 "grammar/axparser.y"
+                                    { (yyval.statement) = (yyvsp[-1].statement); }
+#line 1930 "grammar/axparser.cc"
     break;
 
-  case 11:
-#line 224 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = (yyvsp[0].statement); }
-#line 1787 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 11: /* statement: conditional_statement  */
+#line 234 "grammar/axparser.y"
+                                    { (yyval.statement) = (yyvsp[0].statement); }
+#line 1936 "grammar/axparser.cc"
     break;
 
-  case 12:
-#line 225 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = new Return; }
-#line 1793 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 12: /* statement: RETURN SEMICOLON  */
+#line 235 "grammar/axparser.y"
+                                    { (yyval.statement) = new Return; }
+#line 1942 "grammar/axparser.cc"
     break;
 
-  case 13:
-#line 226 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = nullptr; }
-#line 1799 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 13: /* statement: SEMICOLON  */
+#line 236 "grammar/axparser.y"
+                                    { (yyval.statement) = nullptr; }
+#line 1948 "grammar/axparser.cc"
     break;
 
-  case 14:
-#line 234 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = new ConditionalStatement((yyvsp[-1].expression), (yyvsp[0].block), new Block()); }
-#line 1805 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 14: /* conditional_statement: IF expression_expand block  */
+#line 244 "grammar/axparser.y"
+                                                        { (yyval.statement) = new ConditionalStatement((yyvsp[-1].expression), (yyvsp[0].block), new Block()); }
+#line 1954 "grammar/axparser.cc"
     break;
 
-  case 15:
-#line 235 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = new ConditionalStatement((yyvsp[-3].expression), (yyvsp[-2].block), (yyvsp[0].block)); }
-#line 1811 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 15: /* conditional_statement: IF expression_expand block ELSE block  */
+#line 245 "grammar/axparser.y"
+                                                        { (yyval.statement) = new ConditionalStatement((yyvsp[-3].expression), (yyvsp[-2].block), (yyvsp[0].block)); }
+#line 1960 "grammar/axparser.cc"
     break;
 
-  case 16:
-#line 241 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1817 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 16: /* expression: expression_expand  */
+#line 251 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 1966 "grammar/axparser.cc"
     break;
 
-  case 17:
-#line 242 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1823 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 17: /* expression: function_call_expression  */
+#line 252 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 1972 "grammar/axparser.cc"
     break;
 
-  case 18:
-#line 243 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1829 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 18: /* expression: binary_expression  */
+#line 253 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 1978 "grammar/axparser.cc"
     break;
 
-  case 19:
-#line 244 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1835 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 19: /* expression: unary_expression  */
+#line 254 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 1984 "grammar/axparser.cc"
     break;
 
-  case 20:
-#line 245 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1841 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 20: /* expression: assign_expression  */
+#line 255 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 1990 "grammar/axparser.cc"
     break;
 
-  case 21:
-#line 246 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1847 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 21: /* expression: assign_component_expression  */
+#line 256 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 1996 "grammar/axparser.cc"
     break;
 
-  case 22:
-#line 247 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1853 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 22: /* expression: crement  */
+#line 257 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2002 "grammar/axparser.cc"
     break;
 
-  case 23:
-#line 248 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].expression); }
-#line 1859 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 23: /* expression: cast_expression  */
+#line 258 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].expression); }
+#line 2008 "grammar/axparser.cc"
     break;
 
-  case 24:
-#line 249 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].value); }
-#line 1865 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 24: /* expression: vector_literal  */
+#line 259 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].value); }
+#line 2014 "grammar/axparser.cc"
     break;
 
-  case 25:
-#line 250 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].vector_unpack); }
-#line 1871 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 25: /* expression: vector_element  */
+#line 260 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].vector_unpack); }
+#line 2020 "grammar/axparser.cc"
     break;
 
-  case 26:
-#line 251 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[0].value); }
-#line 1877 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 26: /* expression: literal  */
+#line 261 "grammar/axparser.y"
+                                   { (yyval.expression) = (yyvsp[0].value); }
+#line 2026 "grammar/axparser.cc"
     break;
 
-  case 27:
-#line 252 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new LocalValue((yyvsp[0].local)); }
-#line 1883 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 27: /* expression: local  */
+#line 262 "grammar/axparser.y"
+                                   { (yyval.expression) = new LocalValue((yyvsp[0].local)); }
+#line 2032 "grammar/axparser.cc"
     break;
 
-  case 28:
-#line 253 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AttributeValue((yyvsp[0].attribute)); }
-#line 1889 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 28: /* expression: attribute  */
+#line 263 "grammar/axparser.y"
+                                   { (yyval.expression) = new AttributeValue((yyvsp[0].attribute)); }
+#line 2038 "grammar/axparser.cc"
     break;
 
-  case 29:
-#line 260 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.vector_unpack) = new VectorUnpack(new AttributeValue((yyvsp[-1].attribute)), (yyvsp[0].index)); }
-#line 1895 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 29: /* vector_element: attribute component  */
+#line 270 "grammar/axparser.y"
+                         { (yyval.vector_unpack) = new VectorUnpack(new AttributeValue((yyvsp[-1].attribute)), (yyvsp[0].index)); }
+#line 2044 "grammar/axparser.cc"
     break;
 
-  case 30:
-#line 261 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.vector_unpack) = new VectorUnpack(new LocalValue((yyvsp[-1].local)), (yyvsp[0].index)); }
-#line 1901 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 30: /* vector_element: local component  */
+#line 271 "grammar/axparser.y"
+                         { (yyval.vector_unpack) = new VectorUnpack(new LocalValue((yyvsp[-1].local)), (yyvsp[0].index)); }
+#line 2050 "grammar/axparser.cc"
     break;
 
-  case 31:
-#line 266 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = (yyvsp[-1].expression); }
-#line 1907 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 31: /* expression_expand: LPARENS expression RPARENS  */
+#line 276 "grammar/axparser.y"
+                                { (yyval.expression) = (yyvsp[-1].expression); }
+#line 2056 "grammar/axparser.cc"
     break;
 
-  case 32:
-#line 273 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Cast((yyvsp[0].expression), (yyvsp[-1].value_string)); }
-#line 1913 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 32: /* cast_expression: scalar_type expression_expand  */
+#line 283 "grammar/axparser.y"
+                                   { (yyval.expression) = new Cast((yyvsp[0].expression), (yyvsp[-1].value_string)); }
+#line 2062 "grammar/axparser.cc"
     break;
 
-  case 33:
-#line 278 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new FunctionCall((yyvsp[-3].value_string), (yyvsp[-1].expressionlist)); free((char*)(yyvsp[-3].value_string)); }
-#line 1919 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 33: /* function_call_expression: IDENTIFIER LPARENS arguments RPARENS  */
+#line 288 "grammar/axparser.y"
+                                            { (yyval.expression) = new FunctionCall((yyvsp[-3].value_string), (yyvsp[-1].expressionlist)); free((char*)(yyvsp[-3].value_string)); }
+#line 2068 "grammar/axparser.cc"
     break;
 
-  case 34:
-#line 279 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new FunctionCall((yyvsp[-2].value_string)); free((char*)(yyvsp[-2].value_string)); }
-#line 1925 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 34: /* function_call_expression: IDENTIFIER LPARENS RPARENS  */
+#line 289 "grammar/axparser.y"
+                                            { (yyval.expression) = new FunctionCall((yyvsp[-2].value_string)); free((char*)(yyvsp[-2].value_string)); }
+#line 2074 "grammar/axparser.cc"
     break;
 
-  case 35:
-#line 284 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expressionlist) = new ExpressionList(); (yyval.expressionlist)->mList.emplace_back((yyvsp[0].expression)); }
-#line 1931 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 35: /* arguments: expression  */
+#line 294 "grammar/axparser.y"
+                                  { (yyval.expressionlist) = new ExpressionList(); (yyval.expressionlist)->mList.emplace_back((yyvsp[0].expression)); }
+#line 2080 "grammar/axparser.cc"
     break;
 
-  case 36:
-#line 285 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyvsp[-2].expressionlist)->mList.emplace_back((yyvsp[0].expression)); (yyval.expressionlist) = (yyvsp[-2].expressionlist); }
-#line 1937 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 36: /* arguments: arguments COMMA expression  */
+#line 295 "grammar/axparser.y"
+                                  { (yyvsp[-2].expressionlist)->mList.emplace_back((yyvsp[0].expression)); (yyval.expressionlist) = (yyvsp[-2].expressionlist); }
+#line 2086 "grammar/axparser.cc"
     break;
 
-  case 37:
-#line 292 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = new AssignExpression((yyvsp[-2].declare_local), (yyvsp[0].expression)); }
-#line 1943 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 37: /* declare_assignment: declare_local EQUALS expression  */
+#line 302 "grammar/axparser.y"
+                                       { (yyval.statement) = new AssignExpression((yyvsp[-2].declare_local), (yyvsp[0].expression)); }
+#line 2092 "grammar/axparser.cc"
     break;
 
-  case 38:
-#line 293 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.statement) = (yyvsp[0].declare_local); }
-#line 1949 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 38: /* declare_assignment: declare_local  */
+#line 303 "grammar/axparser.y"
+                                       { (yyval.statement) = (yyvsp[0].declare_local); }
+#line 2098 "grammar/axparser.cc"
     break;
 
-  case 39:
-#line 302 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), (yyvsp[0].expression)); }
-#line 1955 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 39: /* assign_expression: attribute EQUALS expression  */
+#line 312 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), (yyvsp[0].expression)); }
+#line 2104 "grammar/axparser.cc"
     break;
 
-  case 40:
-#line 303 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::PLUS, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
-#line 1961 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 40: /* assign_expression: attribute PLUSEQUALS expression  */
+#line 313 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::PLUS, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
+#line 2110 "grammar/axparser.cc"
     break;
 
-  case 41:
-#line 304 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::MINUS, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
-#line 1967 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 41: /* assign_expression: attribute MINUSEQUALS expression  */
+#line 314 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::MINUS, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
+#line 2116 "grammar/axparser.cc"
     break;
 
-  case 42:
-#line 305 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::MULTIPLY, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
-#line 1973 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 42: /* assign_expression: attribute MULTIPLYEQUALS expression  */
+#line 315 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::MULTIPLY, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
+#line 2122 "grammar/axparser.cc"
     break;
 
-  case 43:
-#line 306 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::DIVIDE, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
-#line 1979 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 43: /* assign_expression: attribute DIVIDEEQUALS expression  */
+#line 316 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].attribute), new BinaryOperator(tokens::DIVIDE, new AttributeValue((yyvsp[-2].attribute)->copy()), (yyvsp[0].expression))); }
+#line 2128 "grammar/axparser.cc"
     break;
 
-  case 44:
-#line 307 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), (yyvsp[0].expression)); }
-#line 1985 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 44: /* assign_expression: local EQUALS expression  */
+#line 317 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), (yyvsp[0].expression)); }
+#line 2134 "grammar/axparser.cc"
     break;
 
-  case 45:
-#line 308 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::PLUS, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
-#line 1991 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 45: /* assign_expression: local PLUSEQUALS expression  */
+#line 318 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::PLUS, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
+#line 2140 "grammar/axparser.cc"
     break;
 
-  case 46:
-#line 309 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::MINUS, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
-#line 1997 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 46: /* assign_expression: local MINUSEQUALS expression  */
+#line 319 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::MINUS, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
+#line 2146 "grammar/axparser.cc"
     break;
 
-  case 47:
-#line 310 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::MULTIPLY, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
-#line 2003 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 47: /* assign_expression: local MULTIPLYEQUALS expression  */
+#line 320 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::MULTIPLY, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
+#line 2152 "grammar/axparser.cc"
     break;
 
-  case 48:
-#line 311 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::DIVIDE, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
-#line 2009 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 48: /* assign_expression: local DIVIDEEQUALS expression  */
+#line 321 "grammar/axparser.y"
+                                           { (yyval.expression) = new AssignExpression((yyvsp[-2].local), new BinaryOperator(tokens::DIVIDE, new LocalValue((yyvsp[-2].local)->copy()), (yyvsp[0].expression))); }
+#line 2158 "grammar/axparser.cc"
     break;
 
-  case 49:
-#line 322 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(nullptr, (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2015 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 49: /* assign_component_expression: attribute component EQUALS expression  */
+#line 332 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(nullptr, (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2164 "grammar/axparser.cc"
     break;
 
-  case 50:
-#line 323 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::PLUS), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2021 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 50: /* assign_component_expression: attribute component PLUSEQUALS expression  */
+#line 333 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::PLUS), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2170 "grammar/axparser.cc"
     break;
 
-  case 51:
-#line 324 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::MINUS), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2027 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 51: /* assign_component_expression: attribute component MINUSEQUALS expression  */
+#line 334 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::MINUS), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2176 "grammar/axparser.cc"
     break;
 
-  case 52:
-#line 325 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::MULTIPLY), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2033 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 52: /* assign_component_expression: attribute component MULTIPLYEQUALS expression  */
+#line 335 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::MULTIPLY), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2182 "grammar/axparser.cc"
     break;
 
-  case 53:
-#line 326 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::DIVIDE), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2039 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 53: /* assign_component_expression: attribute component DIVIDEEQUALS expression  */
+#line 336 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildAttributeComponentExpression(new tokens::OperatorToken(tokens::DIVIDE), (yyvsp[-3].attribute), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2188 "grammar/axparser.cc"
     break;
 
-  case 54:
-#line 327 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(nullptr, (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2045 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 54: /* assign_component_expression: local component EQUALS expression  */
+#line 337 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(nullptr, (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2194 "grammar/axparser.cc"
     break;
 
-  case 55:
-#line 328 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::PLUS), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2051 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 55: /* assign_component_expression: local component PLUSEQUALS expression  */
+#line 338 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::PLUS), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2200 "grammar/axparser.cc"
     break;
 
-  case 56:
-#line 329 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::MINUS), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2057 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 56: /* assign_component_expression: local component MINUSEQUALS expression  */
+#line 339 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::MINUS), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2206 "grammar/axparser.cc"
     break;
 
-  case 57:
-#line 330 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::MULTIPLY), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2063 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 57: /* assign_component_expression: local component MULTIPLYEQUALS expression  */
+#line 340 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::MULTIPLY), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2212 "grammar/axparser.cc"
     break;
 
-  case 58:
-#line 331 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::DIVIDE), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
-#line 2069 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 58: /* assign_component_expression: local component DIVIDEEQUALS expression  */
+#line 341 "grammar/axparser.y"
+                                                     { (yyval.expression) = buildLocalComponentExpression(new tokens::OperatorToken(tokens::DIVIDE), (yyvsp[-3].local), (yyvsp[-2].index), (yyvsp[0].expression)); }
+#line 2218 "grammar/axparser.cc"
     break;
 
-  case 59:
-#line 340 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[0].attribute), new AttributeValue((yyvsp[0].attribute)->copy()), Crement::Increment, /*post*/false); }
-#line 2075 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 59: /* crement: PLUSPLUS attribute  */
+#line 350 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[0].attribute), new AttributeValue((yyvsp[0].attribute)->copy()), Crement::Increment, /*post*/false); }
+#line 2224 "grammar/axparser.cc"
     break;
 
-  case 60:
-#line 341 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[0].attribute), new AttributeValue((yyvsp[0].attribute)->copy()), Crement::Decrement, /*post*/false); }
-#line 2081 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 60: /* crement: MINUSMINUS attribute  */
+#line 351 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[0].attribute), new AttributeValue((yyvsp[0].attribute)->copy()), Crement::Decrement, /*post*/false); }
+#line 2230 "grammar/axparser.cc"
     break;
 
-  case 61:
-#line 342 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[-1].attribute), new AttributeValue((yyvsp[-1].attribute)->copy()), Crement::Increment, /*post*/true); }
-#line 2087 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 61: /* crement: attribute PLUSPLUS  */
+#line 352 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[-1].attribute), new AttributeValue((yyvsp[-1].attribute)->copy()), Crement::Increment, /*post*/true); }
+#line 2236 "grammar/axparser.cc"
     break;
 
-  case 62:
-#line 343 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[-1].attribute), new AttributeValue((yyvsp[-1].attribute)->copy()), Crement::Decrement, /*post*/true); }
-#line 2093 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 62: /* crement: attribute MINUSMINUS  */
+#line 353 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[-1].attribute), new AttributeValue((yyvsp[-1].attribute)->copy()), Crement::Decrement, /*post*/true); }
+#line 2242 "grammar/axparser.cc"
     break;
 
-  case 63:
-#line 344 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[0].local), new LocalValue((yyvsp[0].local)->copy()), Crement::Increment, /*post*/false); }
-#line 2099 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 63: /* crement: PLUSPLUS local  */
+#line 354 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[0].local), new LocalValue((yyvsp[0].local)->copy()), Crement::Increment, /*post*/false); }
+#line 2248 "grammar/axparser.cc"
     break;
 
-  case 64:
-#line 345 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[0].local), new LocalValue((yyvsp[0].local)->copy()), Crement::Decrement, /*post*/false); }
-#line 2105 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 64: /* crement: MINUSMINUS local  */
+#line 355 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[0].local), new LocalValue((yyvsp[0].local)->copy()), Crement::Decrement, /*post*/false); }
+#line 2254 "grammar/axparser.cc"
     break;
 
-  case 65:
-#line 346 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[-1].local), new LocalValue((yyvsp[-1].local)->copy()), Crement::Increment, /*post*/true); }
-#line 2111 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 65: /* crement: local PLUSPLUS  */
+#line 356 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[-1].local), new LocalValue((yyvsp[-1].local)->copy()), Crement::Increment, /*post*/true); }
+#line 2260 "grammar/axparser.cc"
     break;
 
-  case 66:
-#line 347 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new Crement((yyvsp[-1].local), new LocalValue((yyvsp[-1].local)->copy()), Crement::Decrement, /*post*/true); }
-#line 2117 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 66: /* crement: local MINUSMINUS  */
+#line 357 "grammar/axparser.y"
+                            { (yyval.expression) = new Crement((yyvsp[-1].local), new LocalValue((yyvsp[-1].local)->copy()), Crement::Decrement, /*post*/true); }
+#line 2266 "grammar/axparser.cc"
     break;
 
-  case 67:
-#line 352 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new UnaryOperator(tokens::PLUS, (yyvsp[0].expression)); }
-#line 2123 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 67: /* unary_expression: PLUS expression  */
+#line 362 "grammar/axparser.y"
+                         { (yyval.expression) = new UnaryOperator(tokens::PLUS, (yyvsp[0].expression)); }
+#line 2272 "grammar/axparser.cc"
     break;
 
-  case 68:
-#line 353 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new UnaryOperator(tokens::MINUS, (yyvsp[0].expression)); }
-#line 2129 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 68: /* unary_expression: MINUS expression  */
+#line 363 "grammar/axparser.y"
+                         { (yyval.expression) = new UnaryOperator(tokens::MINUS, (yyvsp[0].expression)); }
+#line 2278 "grammar/axparser.cc"
     break;
 
-  case 69:
-#line 354 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new UnaryOperator(tokens::BITNOT, (yyvsp[0].expression)); }
-#line 2135 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 69: /* unary_expression: BITNOT expression  */
+#line 364 "grammar/axparser.y"
+                         { (yyval.expression) = new UnaryOperator(tokens::BITNOT, (yyvsp[0].expression)); }
+#line 2284 "grammar/axparser.cc"
     break;
 
-  case 70:
-#line 355 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new UnaryOperator(tokens::NOT, (yyvsp[0].expression)); }
-#line 2141 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 70: /* unary_expression: NOT expression  */
+#line 365 "grammar/axparser.y"
+                         { (yyval.expression) = new UnaryOperator(tokens::NOT, (yyvsp[0].expression)); }
+#line 2290 "grammar/axparser.cc"
     break;
 
-  case 71:
-#line 361 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::PLUS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2147 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 71: /* binary_expression: expression PLUS expression  */
+#line 371 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::PLUS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2296 "grammar/axparser.cc"
     break;
 
-  case 72:
-#line 362 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MINUS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2153 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 72: /* binary_expression: expression MINUS expression  */
+#line 372 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MINUS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2302 "grammar/axparser.cc"
     break;
 
-  case 73:
-#line 363 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MULTIPLY, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2159 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 73: /* binary_expression: expression MULTIPLY expression  */
+#line 373 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MULTIPLY, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2308 "grammar/axparser.cc"
     break;
 
-  case 74:
-#line 364 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::DIVIDE, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2165 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 74: /* binary_expression: expression DIVIDE expression  */
+#line 374 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::DIVIDE, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2314 "grammar/axparser.cc"
     break;
 
-  case 75:
-#line 365 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MODULO, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2171 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 75: /* binary_expression: expression MODULO expression  */
+#line 375 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MODULO, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2320 "grammar/axparser.cc"
     break;
 
-  case 76:
-#line 366 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::BITAND, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2177 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 76: /* binary_expression: expression BITAND expression  */
+#line 376 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::BITAND, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2326 "grammar/axparser.cc"
     break;
 
-  case 77:
-#line 367 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::BITOR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2183 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 77: /* binary_expression: expression BITOR expression  */
+#line 377 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::BITOR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2332 "grammar/axparser.cc"
     break;
 
-  case 78:
-#line 368 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::BITXOR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2189 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 78: /* binary_expression: expression BITXOR expression  */
+#line 378 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::BITXOR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2338 "grammar/axparser.cc"
     break;
 
-  case 79:
-#line 369 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::AND, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2195 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 79: /* binary_expression: expression AND expression  */
+#line 379 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::AND, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2344 "grammar/axparser.cc"
     break;
 
-  case 80:
-#line 370 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::OR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2201 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 80: /* binary_expression: expression OR expression  */
+#line 380 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::OR, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2350 "grammar/axparser.cc"
     break;
 
-  case 81:
-#line 371 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::EQUALSEQUALS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2207 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 81: /* binary_expression: expression EQUALSEQUALS expression  */
+#line 381 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::EQUALSEQUALS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2356 "grammar/axparser.cc"
     break;
 
-  case 82:
-#line 372 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::NOTEQUALS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2213 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 82: /* binary_expression: expression NOTEQUALS expression  */
+#line 382 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::NOTEQUALS, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2362 "grammar/axparser.cc"
     break;
 
-  case 83:
-#line 373 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MORETHAN, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2219 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 83: /* binary_expression: expression MORETHAN expression  */
+#line 383 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MORETHAN, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2368 "grammar/axparser.cc"
     break;
 
-  case 84:
-#line 374 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::LESSTHAN, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2225 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 84: /* binary_expression: expression LESSTHAN expression  */
+#line 384 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::LESSTHAN, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2374 "grammar/axparser.cc"
     break;
 
-  case 85:
-#line 375 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::MORETHANOREQUAL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2231 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 85: /* binary_expression: expression MORETHANOREQUAL expression  */
+#line 385 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::MORETHANOREQUAL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2380 "grammar/axparser.cc"
     break;
 
-  case 86:
-#line 376 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.expression) = new BinaryOperator(tokens::LESSTHANOREQUAL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
-#line 2237 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 86: /* binary_expression: expression LESSTHANOREQUAL expression  */
+#line 386 "grammar/axparser.y"
+                                             { (yyval.expression) = new BinaryOperator(tokens::LESSTHANOREQUAL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 2386 "grammar/axparser.cc"
     break;
 
-  case 87:
-#line 381 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new VectorPack((yyvsp[-5].expression), (yyvsp[-3].expression), (yyvsp[-1].expression)); }
-#line 2243 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 87: /* vector_literal: LCURLY expression COMMA expression COMMA expression RCURLY  */
+#line 391 "grammar/axparser.y"
+                                                               { (yyval.value) = new VectorPack((yyvsp[-5].expression), (yyvsp[-3].expression), (yyvsp[-1].expression)); }
+#line 2392 "grammar/axparser.cc"
     break;
 
-  case 88:
-#line 386 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2249 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 88: /* attribute: scalar_type AT IDENTIFIER  */
+#line 396 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2398 "grammar/axparser.cc"
     break;
 
-  case 89:
-#line 387 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2255 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 89: /* attribute: vector_type AT IDENTIFIER  */
+#line 397 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), (yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2404 "grammar/axparser.cc"
     break;
 
-  case 90:
-#line 388 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<int32_t>()); free((char*)(yyvsp[0].value_string)); }
-#line 2261 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 90: /* attribute: I_AT IDENTIFIER  */
+#line 398 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<int32_t>()); free((char*)(yyvsp[0].value_string)); }
+#line 2410 "grammar/axparser.cc"
     break;
 
-  case 91:
-#line 389 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<float>()); free((char*)(yyvsp[0].value_string)); }
-#line 2267 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 91: /* attribute: F_AT IDENTIFIER  */
+#line 399 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<float>()); free((char*)(yyvsp[0].value_string)); }
+#line 2416 "grammar/axparser.cc"
     break;
 
-  case 92:
-#line 390 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<openvdb::Vec3s>()); free((char*)(yyvsp[0].value_string)); }
-#line 2273 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 92: /* attribute: V_AT IDENTIFIER  */
+#line 400 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<openvdb::Vec3s>()); free((char*)(yyvsp[0].value_string)); }
+#line 2422 "grammar/axparser.cc"
     break;
 
-  case 93:
-#line 391 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
-#line 2279 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 93: /* attribute: S_AT IDENTIFIER  */
+#line 401 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
+#line 2428 "grammar/axparser.cc"
     break;
 
-  case 94:
-#line 392 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
-#line 2285 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 94: /* attribute: STRING AT IDENTIFIER  */
+#line 402 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
+#line 2434 "grammar/axparser.cc"
     break;
 
-  case 95:
-#line 393 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<float>(), true); free((char*)(yyvsp[0].value_string)); }
-#line 2291 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 95: /* attribute: AT IDENTIFIER  */
+#line 403 "grammar/axparser.y"
+                                 { (yyval.attribute) = new Attribute((yyvsp[0].value_string), openvdb::typeNameAsString<float>(), true); free((char*)(yyvsp[0].value_string)); }
+#line 2440 "grammar/axparser.cc"
     break;
 
-  case 96:
-#line 398 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2297 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 96: /* attribute: IDENTIFIER AT IDENTIFIER  */
+#line 404 "grammar/axparser.y"
+                                 { (yyval.attribute) = buildStorageAttribute((yyvsp[-2].value_string), (yyvsp[0].value_string)); free((char*)(yyvsp[-2].value_string)); free((char*)(yyvsp[0].value_string));
+                                   if (!(yyval.attribute)) { yyerror(tree, "unsupported attribute type"); YYABORT; } }
+#line 2447 "grammar/axparser.cc"
     break;
 
-  case 97:
-#line 399 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2303 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 97: /* declare_local: scalar_type IDENTIFIER  */
+#line 410 "grammar/axparser.y"
+                              { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2453 "grammar/axparser.cc"
     break;
 
-  case 98:
-#line 400 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
-#line 2309 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 98: /* declare_local: vector_type IDENTIFIER  */
+#line 411 "grammar/axparser.y"
+                              { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), (yyvsp[-1].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2459 "grammar/axparser.cc"
     break;
 
-  case 99:
-#line 407 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.local) = new Local((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2315 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 99: /* declare_local: STRING IDENTIFIER  */
+#line 412 "grammar/axparser.y"
+                              { (yyval.declare_local) = new DeclareLocal((yyvsp[0].value_string), openvdb::typeNameAsString<std::string>()); free((char*)(yyvsp[0].value_string)); }
+#line 2465 "grammar/axparser.cc"
     break;
 
-  case 100:
-#line 414 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<int16_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2321 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 100: /* local: IDENTIFIER  */
+#line 419 "grammar/axparser.y"
+                { (yyval.local) = new Local((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2471 "grammar/axparser.cc"
     break;
 
-  case 101:
-#line 415 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<int32_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2327 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 101: /* literal: L_SHORT  */
+#line 426 "grammar/axparser.y"
+                { (yyval.value) = new Value<int16_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2477 "grammar/axparser.cc"
     break;
 
-  case 102:
-#line 416 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<int64_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2333 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 102: /* literal: L_INT  */
+#line 427 "grammar/axparser.y"
+                { (yyval.value) = new Value<int32_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2483 "grammar/axparser.cc"
     break;
 
-  case 103:
-#line 417 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<float>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2339 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 103: /* literal: L_LONG  */
+#line 428 "grammar/axparser.y"
+                { (yyval.value) = new Value<int64_t>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2489 "grammar/axparser.cc"
     break;
 
-  case 104:
-#line 418 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<double>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2345 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 104: /* literal: L_FLOAT  */
+#line 429 "grammar/axparser.y"
+                { (yyval.value) = new Value<float>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2495 "grammar/axparser.cc"
     break;
 
-  case 105:
-#line 419 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<std::string>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
-#line 2351 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 105: /* literal: L_DOUBLE  */
+#line 430 "grammar/axparser.y"
+                { (yyval.value) = new Value<double>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2501 "grammar/axparser.cc"
     break;
 
-  case 106:
-#line 420 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<bool>(true); }
-#line 2357 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 106: /* literal: L_STRING  */
+#line 431 "grammar/axparser.y"
+                { (yyval.value) = new Value<std::string>((yyvsp[0].value_string)); free((char*)(yyvsp[0].value_string)); }
+#line 2507 "grammar/axparser.cc"
     break;
 
-  case 107:
-#line 421 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value) = new Value<bool>(false); }
-#line 2363 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 107: /* literal: TRUE  */
+#line 432 "grammar/axparser.y"
+                { (yyval.value) = new Value<bool>(true); }
+#line 2513 "grammar/axparser.cc"
     break;
 
-  case 108:
-#line 426 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.index) = 0; }
-#line 2369 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 108: /* literal: FALSE  */
+#line 433 "grammar/axparser.y"
+                { (yyval.value) = new Value<bool>(false); }
+#line 2519 "grammar/axparser.cc"
     break;
 
-  case 109:
-#line 427 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.index) = 1; }
-#line 2375 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 109: /* component: DOT_X  */
+#line 438 "grammar/axparser.y"
+             { (yyval.index) = 0; }
+#line 2525 "grammar/axparser.cc"
     break;
 
-  case 110:
-#line 428 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.index) = 2; }
-#line 2381 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 110: /* component: DOT_Y  */
+#line 439 "grammar/axparser.y"
+             { (yyval.index) = 1; }
+#line 2531 "grammar/axparser.cc"
     break;
 
-  case 111:
-#line 434 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<bool>(); }
-#line 2387 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 111: /* component: DOT_Z  */
+#line 440 "grammar/axparser.y"
+             { (yyval.index) = 2; }
+#line 2537 "grammar/axparser.cc"
     break;
 
-  case 112:
-#line 435 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<int16_t>(); }
-#line 2393 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 112: /* scalar_type: BOOL  */
+#line 446 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<bool>(); }
+#line 2543 "grammar/axparser.cc"
     break;
 
-  case 113:
-#line 436 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<int32_t>(); }
-#line 2399 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 113: /* scalar_type: SHORT  */
+#line 447 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<int16_t>(); }
+#line 2549 "grammar/axparser.cc"
     break;
 
-  case 114:
-#line 437 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<int64_t>(); }
-#line 2405 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 114: /* scalar_type: INT  */
+#line 448 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<int32_t>(); }
+#line 2555 "grammar/axparser.cc"
     break;
 
-  case 115:
-#line 438 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<float>(); }
-#line 2411 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 115: /* scalar_type: LONG  */
+#line 449 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<int64_t>(); }
+#line 2561 "grammar/axparser.cc"
     break;
 
-  case 116:
-#line 439 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<double>(); }
-#line 2417 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 116: /* scalar_type: FLOAT  */
+#line 450 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<float>(); }
+#line 2567 "grammar/axparser.cc"
     break;
 
-  case 117:
-#line 445 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3i>(); }
-#line 2423 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 117: /* scalar_type: DOUBLE  */
+#line 451 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<double>(); }
+#line 2573 "grammar/axparser.cc"
     break;
 
-  case 118:
-#line 446 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3s>(); }
-#line 2429 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 118: /* vector_type: VEC3I  */
+#line 457 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3i>(); }
+#line 2579 "grammar/axparser.cc"
     break;
 
-  case 119:
-#line 447 "grammar/axparser.y" /* yacc.c:1648  */
-    { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3d>(); }
-#line 2435 "grammar/axparser.cc" /* yacc.c:1648  */
+  case 119: /* vector_type: VEC3F  */
+#line 458 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3s>(); }
+#line 2585 "grammar/axparser.cc"
+    break;
+
+  case 120: /* vector_type: VEC3D  */
+#line 459 "grammar/axparser.y"
+              { (yyval.value_string) = openvdb::typeNameAsString<openvdb::Vec3d>(); }
+#line 2591 "grammar/axparser.cc"
     break;
 
 
-#line 2439 "grammar/axparser.cc" /* yacc.c:1648  */
+#line 2595 "grammar/axparser.cc"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2449,11 +2606,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2461,14 +2617,13 @@ yyreduce:
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2479,50 +2634,45 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (tree, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (tree, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2551,12 +2701,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2573,13 +2722,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2593,7 +2743,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp, tree);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, tree);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2604,13 +2754,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2621,26 +2769,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (tree, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2656,20 +2808,19 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, yylsp, tree);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, tree);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 449 "grammar/axparser.y" /* yacc.c:1907  */
+
+#line 461 "grammar/axparser.y"
 
 
 // Copyright (c) 2015-2018 DNEG Visual Effects
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_GRAMMAR_AXPARSER_H_INCLUDED
 # define YY_YY_GRAMMAR_AXPARSER_H_INCLUDED
 /* Debug traces.  */
@@ -40,85 +45,89 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    TRUE = 258,
-    FALSE = 259,
-    SEMICOLON = 260,
-    AT = 261,
-    IF = 262,
-    ELSE = 263,
-    RETURN = 264,
-    EQUALS = 265,
-    PLUSEQUALS = 266,
-    MINUSEQUALS = 267,
-    MULTIPLYEQUALS = 268,
-    DIVIDEEQUALS = 269,
-    PLUSPLUS = 270,
-    MINUSMINUS = 271,
-    LPARENS = 272,
-    RPARENS = 273,
-    LCURLY = 274,
-    RCURLY = 275,
-    PLUS = 276,
-    MINUS = 277,
-    MULTIPLY = 278,
-    DIVIDE = 279,
-    MODULO = 280,
-    BITAND = 281,
-    BITOR = 282,
-    BITXOR = 283,
-    BITNOT = 284,
-    EQUALSEQUALS = 285,
-    NOTEQUALS = 286,
-    MORETHAN = 287,
-    LESSTHAN = 288,
-    MORETHANOREQUAL = 289,
-    LESSTHANOREQUAL = 290,
-    AND = 291,
-    OR = 292,
-    NOT = 293,
-    STRING = 294,
-    DOUBLE = 295,
-    FLOAT = 296,
-    LONG = 297,
-    INT = 298,
-    SHORT = 299,
-    BOOL = 300,
-    VOID = 301,
-    F_AT = 302,
-    I_AT = 303,
-    V_AT = 304,
-    S_AT = 305,
-    COMMA = 306,
-    VEC3I = 307,
-    VEC3F = 308,
-    VEC3D = 309,
-    DOT_X = 310,
-    DOT_Y = 311,
-    DOT_Z = 312,
-    L_SHORT = 313,
-    L_INT = 314,
-    L_LONG = 315,
-    L_FLOAT = 316,
-    L_DOUBLE = 317,
-    L_STRING = 318,
-    IDENTIFIER = 319,
-    LPAREN = 320,
-    RPAREN = 321,
-    LOWER_THAN_ELSE = 322
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    TRUE = 258,                    /* TRUE  */
+    FALSE = 259,                   /* FALSE  */
+    SEMICOLON = 260,               /* SEMICOLON  */
+    AT = 261,                      /* AT  */
+    IF = 262,                      /* IF  */
+    ELSE = 263,                    /* ELSE  */
+    RETURN = 264,                  /* RETURN  */
+    EQUALS = 265,                  /* EQUALS  */
+    PLUSEQUALS = 266,              /* PLUSEQUALS  */
+    MINUSEQUALS = 267,             /* MINUSEQUALS  */
+    MULTIPLYEQUALS = 268,          /* MULTIPLYEQUALS  */
+    DIVIDEEQUALS = 269,            /* DIVIDEEQUALS  */
+    PLUSPLUS = 270,                /* PLUSPLUS  */
+    MINUSMINUS = 271,              /* MINUSMINUS  */
+    LPARENS = 272,                 /* LPARENS  */
+    RPARENS = 273,                 /* RPARENS  */
+    LCURLY = 274,                  /* LCURLY  */
+    RCURLY = 275,                  /* RCURLY  */
+    PLUS = 276,                    /* PLUS  */
+    MINUS = 277,                   /* MINUS  */
+    MULTIPLY = 278,                /* MULTIPLY  */
+    DIVIDE = 279,                  /* DIVIDE  */
+    MODULO = 280,                  /* MODULO  */
+    BITAND = 281,                  /* BITAND  */
+    BITOR = 282,                   /* BITOR  */
+    BITXOR = 283,                  /* BITXOR  */
+    BITNOT = 284,                  /* BITNOT  */
+    EQUALSEQUALS = 285,            /* EQUALSEQUALS  */
+    NOTEQUALS = 286,               /* NOTEQUALS  */
+    MORETHAN = 287,                /* MORETHAN  */
+    LESSTHAN = 288,                /* LESSTHAN  */
+    MORETHANOREQUAL = 289,         /* MORETHANOREQUAL  */
+    LESSTHANOREQUAL = 290,         /* LESSTHANOREQUAL  */
+    AND = 291,                     /* AND  */
+    OR = 292,                      /* OR  */
+    NOT = 293,                     /* NOT  */
+    STRING = 294,                  /* STRING  */
+    DOUBLE = 295,                  /* DOUBLE  */
+    FLOAT = 296,                   /* FLOAT  */
+    LONG = 297,                    /* LONG  */
+    INT = 298,                     /* INT  */
+    SHORT = 299,                   /* SHORT  */
+    BOOL = 300,                    /* BOOL  */
+    VOID = 301,                    /* VOID  */
+    F_AT = 302,                    /* F_AT  */
+    I_AT = 303,                    /* I_AT  */
+    V_AT = 304,                    /* V_AT  */
+    S_AT = 305,                    /* S_AT  */
+    COMMA = 306,                   /* COMMA  */
+    VEC3I = 307,                   /* VEC3I  */
+    VEC3F = 308,                   /* VEC3F  */
+    VEC3D = 309,                   /* VEC3D  */
+    DOT_X = 310,                   /* DOT_X  */
+    DOT_Y = 311,                   /* DOT_Y  */
+    DOT_Z = 312,                   /* DOT_Z  */
+    L_SHORT = 313,                 /* L_SHORT  */
+    L_INT = 314,                   /* L_INT  */
+    L_LONG = 315,                  /* L_LONG  */
+    L_FLOAT = 316,                 /* L_FLOAT  */
+    L_DOUBLE = 317,                /* L_DOUBLE  */
+    L_STRING = 318,                /* L_STRING  */
+    IDENTIFIER = 319,              /* IDENTIFIER  */
+    LPAREN = 320,                  /* LPAREN  */
+    RPAREN = 321,                  /* RPAREN  */
+    LOWER_THAN_ELSE = 322          /* LOWER_THAN_ELSE  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
 union YYSTYPE
 {
-#line 114 "grammar/axparser.y" /* yacc.c:1910  */
+#line 124 "grammar/axparser.y"
 
     const char* value_string;
     uint64_t index;
@@ -136,9 +145,9 @@ union YYSTYPE
     openvdb::ax::ast::DeclareLocal* declare_local;
     openvdb::ax::ast::Local* local;
 
-#line 140 "grammar/axparser.h" /* yacc.c:1910  */
-};
+#line 149 "grammar/axparser.h"
 
+};
 typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
@@ -161,6 +170,8 @@ struct YYLTYPE
 
 extern YYSTYPE yylval;
 extern YYLTYPE yylloc;
+
 int yyparse (openvdb::ax::ast::Tree** tree);
 
+
 #endif /* !YY_YY_GRAMMAR_AXPARSER_H_INCLUDED  */
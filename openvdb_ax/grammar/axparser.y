@@ -105,6 +105,16 @@
             return new Attribute(name, openvdb::typeNameAsString<float>());
         }
     }
+
+    // Compact storage types have no type tokens and are parsed from identifiers.
+    // Returns a null pointer if the identifier is not a storage type
+    Attribute* buildStorageAttribute(const std::string& type, const std::string& name)
+    {
+        if (type == "half")  return new Attribute(name, openvdb::typeNameAsString<half>());
+        if (type == "int8")  return new Attribute(name, openvdb::typeNameAsString<int8_t>());
+        if (type == "uint8") return new Attribute(name, openvdb::typeNameAsString<uint8_t>());
+        return nullptr;
+    }
 %}
 
 %error-verbose
@@ -391,6 +401,8 @@ attribute:
     | S_AT IDENTIFIER            { $$ = new Attribute($2, openvdb::typeNameAsString<std::string>()); free((char*)$2); }
     | STRING AT IDENTIFIER       { $$ = new Attribute($3, openvdb::typeNameAsString<std::string>()); free((char*)$3); }
     | AT IDENTIFIER              { $$ = new Attribute($2, openvdb::typeNameAsString<float>(), true); free((char*)$2); }
+    | IDENTIFIER AT IDENTIFIER   { $$ = buildStorageAttribute($1, $3); free((char*)$1); free((char*)$3);
+                                   if (!$$) { yyerror(tree, "unsupported attribute type"); YYABORT; } }
 ;
 
 /// @brief  Syntax for the declaration of supported local variable types
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "util.h"
+
+#include <openvdb_ax/ast/AST.h>
+#include <openvdb_ax/codegen/ComputeGenerator.h>
+#include <openvdb_ax/codegen/FunctionRegistry.h>
+#include <openvdb_ax/compiler/CompilerOptions.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <sstream>
+#include <string>
+
+class TestComputeGenerator : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestComputeGenerator);
+    CPPUNIT_TEST(testGeneratedSnippet);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testGeneratedSnippet();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestComputeGenerator);
+
+void
+TestComputeGenerator::testGeneratedSnippet()
+{
+    // a long snippet where every statement declares a new local from the previous
+    // one, and every tenth statement opens a scope which shadows and reads the locals
+    // declared before it. The compile time scaling of such snippets is measured by
+    // vdb_ax_bench --codegen-sizes
+
+    std::ostringstream os;
+    os << "float a0 = 1.0f;\n";
+    for (size_t i = 1; i < 1000; ++i) {
+        if (i % 10 == 0) {
+            os << "if (a" << i-1 << " > 0.0f) { float a" << i-2 << " = a" << i-1
+               << " * 2.0f; float t = a" << i-2 << "; }\n";
+        }
+        os << "float a" << i << " = a" << i-1 << " + 1.0f;\n";
+    }
+
+    openvdb::ax::ast::Tree::Ptr tree = openvdb::ax::ast::parse(os.str().c_str());
+    CPPUNIT_ASSERT(tree);
+
+    unittest_util::LLVMState state;
+    const openvdb::ax::FunctionOptions options;
+    openvdb::ax::codegen::FunctionRegistry::UniquePtr registry =
+        openvdb::ax::codegen::createStandardRegistry(options);
+
+    openvdb::ax::codegen::ComputeGenerator
+        generator(state.module(), nullptr, options, *registry);
+    tree->accept(generator);
+
+    CPPUNIT_ASSERT(!llvm::verifyModule(state.module(), &llvm::errs()));
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -44,10 +44,12 @@ public:
     CPPUNIT_TEST_SUITE(TestSymbolTable);
     CPPUNIT_TEST(testSingleTable);
     CPPUNIT_TEST(testTableBlocks);
+    CPPUNIT_TEST(testNestedTableBlocks);
     CPPUNIT_TEST_SUITE_END();
 
     void testSingleTable();
     void testTableBlocks();
+    void testNestedTableBlocks();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestSymbolTable);
@@ -193,6 +195,60 @@ TestSymbolTable::testTableBlocks()
     CPPUNIT_ASSERT(!tables.replace("empty", nullptr));
 }
 
+void
+TestSymbolTable::testNestedTableBlocks()
+{
+    unittest_util::LLVMState state;
+    llvm::IRBuilder<> builder(state.scratchBlock());
+
+    llvm::Type* type = LLVMType<float>::get(state.context());
+
+    llvm::Value* value1 = builder.CreateAlloca(type);
+    llvm::Value* value2 = builder.CreateAlloca(type);
+    CPPUNIT_ASSERT(value1);
+    CPPUNIT_ASSERT(value2);
+
+    openvdb::ax::codegen::SymbolTableBlocks tables;
+    tables.globals().insert("global", value1);
+
+    // test that tables remain valid as deeper scopes are pushed
+
+    const size_t depth = 1000;
+    openvdb::ax::codegen::SymbolTable* first = tables.getOrInsert(1);
+    first->insert("shadowed", value1);
+
+    for (size_t i = 2; i <= depth; ++i) {
+        tables.getOrInsert(i)->insert("level" + std::to_string(i), value2);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(first, &(tables.get(1)));
+    CPPUNIT_ASSERT_EQUAL(value1, tables.find("global"));
+    CPPUNIT_ASSERT_EQUAL(value1, tables.find("shadowed"));
+    CPPUNIT_ASSERT_EQUAL(value2, tables.find("level2"));
+    CPPUNIT_ASSERT(!tables.find("level" + std::to_string(depth), depth - 1));
+
+    tables.get(depth).insert("shadowed", value2);
+    CPPUNIT_ASSERT_EQUAL(value2, tables.find("shadowed"));
+    CPPUNIT_ASSERT_EQUAL(value1, tables.find("shadowed", depth - 1));
+
+    // test popping scopes in reverse order
+
+    for (size_t i = depth; i > 1; --i) {
+        CPPUNIT_ASSERT(tables.erase(i));
+        CPPUNIT_ASSERT(!tables.erase(i));
+        CPPUNIT_ASSERT(!tables.find("level" + std::to_string(i)));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(value1, tables.find("shadowed"));
+    CPPUNIT_ASSERT_THROW(tables.get(2), std::runtime_error);
+
+    // test re-pushing a previously erased scope starts empty
+
+    CPPUNIT_ASSERT(tables.getOrInsert(2)->map().empty());
+    CPPUNIT_ASSERT(tables.erase(1));
+    CPPUNIT_ASSERT(!tables.find("shadowed"));
+}
+
 // Copyright (c) 2015-2018 DNEG Visual Effects
 // All rights reserved. This software is distributed under the
 // Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
@@ -52,10 +52,13 @@ static const unittest_util::CodeTests tests =
 {
     { "@a;",       EXPECTED_PASS(float, BehaviourFlags::Inferred, 2)},
     { "bool@a;",   EXPECTED_PASS(bool, BehaviourFlags::Specified, 2)},
+    { "int8@a;",   EXPECTED_PASS(int8_t, BehaviourFlags::Specified, 2)},
+    { "uint8@a;",  EXPECTED_PASS(uint8_t, BehaviourFlags::Specified, 2)},
     { "short@a;",  EXPECTED_PASS(short, BehaviourFlags::Specified, 2)},
     { "i@a;",      EXPECTED_PASS(int, BehaviourFlags::Specified, 2)},
     { "int@a;",    EXPECTED_PASS(int, BehaviourFlags::Specified, 2)},
     { "long@a;",   EXPECTED_PASS(long, BehaviourFlags::Specified, 2)},
+    { "half@a;",   EXPECTED_PASS(half, BehaviourFlags::Specified, 2)},
     { "f@a;",      EXPECTED_PASS(float, BehaviourFlags::Specified, 2)},
     { "float@a;",  EXPECTED_PASS(float, BehaviourFlags::Specified, 2)},
     { "double@a;", EXPECTED_PASS(double, BehaviourFlags::Specified, 2)},
@@ -151,6 +151,8 @@ static const unittest_util::CodeTests tests =
     { "l@a;",                          EXPECTED_FAILURE() },
     { "flt@a;",                        EXPECTED_FAILURE() },
     { "dbl@a;",                        EXPECTED_FAILURE() },
+    { "hlf@a;",                        EXPECTED_FAILURE() },
+    { "uint16@a;",                     EXPECTED_FAILURE() },
     { "vecint@a;",                     EXPECTED_FAILURE() },
     { "vint@a;",                       EXPECTED_FAILURE() },
     { "vfloat@a;",                     EXPECTED_FAILURE() },
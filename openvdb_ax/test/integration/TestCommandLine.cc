@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb/openvdb.h>
+#include <openvdb/io/File.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdio> // std::remove
+#include <cstdlib> // std::system
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h> // getpid
+#endif
+
+class TestCommandLine : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestCommandLine);
+    CPPUNIT_TEST(testFileList);
+    CPPUNIT_TEST(testMissingGrid);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testFileList();
+    void testMissingGrid();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCommandLine);
+
+namespace {
+
+/// @brief  Removes the files on destruction, so that they are also removed when an
+///         assertion fails
+struct ScopedRemove
+{
+    ScopedRemove(const std::vector<std::string>& files) : mFiles(files) {}
+    ~ScopedRemove() { for (const std::string& file : mFiles) std::remove(file.c_str()); }
+    const std::vector<std::string> mFiles;
+};
+
+}
+
+void
+TestCommandLine::testFileList()
+{
+#if defined(OPENVDB_AX_TEST_VDB_AX) && defined(__linux__)
+    const std::string prefix = "/tmp/vdb_ax_test_file_list_" + std::to_string(::getpid());
+    const std::string list = prefix + ".txt";
+    const std::vector<std::string> inputs { prefix + "_in_0.vdb", prefix + "_in_1.vdb" };
+    const std::vector<std::string> outputs { prefix + "_out_0.vdb", prefix + "_out_1.vdb" };
+
+    std::vector<std::string> files { list };
+    files.insert(files.end(), inputs.begin(), inputs.end());
+    files.insert(files.end(), outputs.begin(), outputs.end());
+    const ScopedRemove removeFiles(files);
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        openvdb::FloatGrid::Ptr grid = openvdb::FloatGrid::create();
+        grid->setName("density");
+        grid->tree().setValueOn(openvdb::Coord(0), float(i));
+        openvdb::io::File file(inputs[i]);
+        file.write(openvdb::GridCPtrVec{grid});
+        file.close();
+    }
+
+    // list the inputs in reverse, the # in the output is replaced by the line index
+
+    {
+        std::ofstream out(list.c_str());
+        out << inputs[1] << "\n" << inputs[0] << "\n";
+    }
+
+    // only the output is given as a positional argument
+
+    const std::string command = std::string(OPENVDB_AX_TEST_VDB_AX) +
+        " --file-list " + list + " " + prefix + "_out_#.vdb -s \"@density += 10.0f;\"";
+    CPPUNIT_ASSERT_EQUAL(0, std::system(command.c_str()));
+
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        openvdb::io::File file(outputs[i]);
+        CPPUNIT_ASSERT_NO_THROW(file.open());
+        openvdb::FloatGrid::Ptr grid =
+            openvdb::gridPtrCast<openvdb::FloatGrid>(file.readGrid("density"));
+        file.close();
+        CPPUNIT_ASSERT(grid);
+        CPPUNIT_ASSERT_EQUAL(float(1 - i) + 10.0f, grid->tree().getValue(openvdb::Coord(0)));
+    }
+#endif
+}
+
+void
+TestCommandLine::testMissingGrid()
+{
+#if defined(OPENVDB_AX_TEST_VDB_AX) && defined(__linux__)
+    const std::string prefix = "/tmp/vdb_ax_test_missing_grid_" + std::to_string(::getpid());
+    const std::string input = prefix + "_in.vdb", output = prefix + "_out.vdb";
+    const ScopedRemove removeFiles({ input, output });
+
+    openvdb::FloatGrid::Ptr grid = openvdb::FloatGrid::create();
+    grid->setName("density");
+    grid->tree().setValueOn(openvdb::Coord(0), 1.0f);
+    openvdb::io::File file(input);
+    file.write(openvdb::GridCPtrVec{grid});
+    file.close();
+
+    // without point grids, an attribute which is not a volume in the file fails
+
+    for (const std::string mode : { "", " --stream" }) {
+        const std::string command = std::string(OPENVDB_AX_TEST_VDB_AX) + mode +
+            " " + input + " " + output + " -s \"@densty = 1.0f;\"";
+        CPPUNIT_ASSERT(std::system(command.c_str()) != 0);
+    }
+#endif
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
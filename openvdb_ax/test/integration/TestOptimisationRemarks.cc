@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/codegen/FunctionRegistry.h>
+#include <openvdb_ax/codegen/FunctionTypes.h>
+#include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/VolumeExecutable.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+class TestOptimisationRemarks : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestOptimisationRemarks);
+    CPPUNIT_TEST(testLoopVectorizeRemarks);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testLoopVectorizeRemarks();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestOptimisationRemarks);
+
+namespace {
+
+/// @brief  AX has no loop syntax, so this function generates a loop at its call site
+///         which sums the first 1024 integers as floats
+struct SumLoop : public openvdb::ax::codegen::FunctionBase
+{
+    inline FunctionBase::Context context() const override final { return FunctionBase::All; }
+    inline const std::string identifier() const override final { return "sumloop"; }
+
+    inline static Ptr create(const openvdb::ax::FunctionOptions&) { return Ptr(new SumLoop()); }
+
+    SumLoop() : FunctionBase({
+        openvdb::ax::codegen::FunctionSignature<float()>::create(nullptr, std::string("sumloop"), 0)
+    }) {}
+
+    llvm::Value*
+    generate(const std::vector<llvm::Value*>&,
+         const std::unordered_map<std::string, llvm::Value*>&,
+         llvm::IRBuilder<>& builder,
+         llvm::Module&) const override final
+    {
+        llvm::LLVMContext& C = builder.getContext();
+        llvm::BasicBlock* entry = builder.GetInsertBlock();
+        llvm::Function* function = entry->getParent();
+        llvm::BasicBlock* loop = llvm::BasicBlock::Create(C, "loop", function);
+        llvm::BasicBlock* exit = llvm::BasicBlock::Create(C, "exit", function);
+
+        builder.CreateBr(loop);
+        builder.SetInsertPoint(loop);
+
+        llvm::PHINode* index = builder.CreatePHI(builder.getInt32Ty(), 2);
+        llvm::PHINode* sum = builder.CreatePHI(builder.getFloatTy(), 2);
+        llvm::Value* next = builder.CreateAdd(index, builder.getInt32(1));
+        llvm::Value* result =
+            builder.CreateFAdd(sum, builder.CreateSIToFP(index, builder.getFloatTy()));
+
+        index->addIncoming(builder.getInt32(0), entry);
+        index->addIncoming(next, loop);
+        sum->addIncoming(llvm::ConstantFP::get(builder.getFloatTy(), 0.0), entry);
+        sum->addIncoming(result, loop);
+
+        builder.CreateCondBr(builder.CreateICmpSLT(next, builder.getInt32(1024)), loop, exit);
+        builder.SetInsertPoint(exit);
+        return result;
+    }
+};
+
+inline bool
+hasRemark(const std::vector<std::string>& warnings, const std::string& pass)
+{
+    return std::any_of(warnings.begin(), warnings.end(), [&pass](const std::string& warning) {
+        return warning.find("remark [") == 0 && warning.find("] " + pass + " ") != std::string::npos;
+    });
+}
+
+}
+
+void
+TestOptimisationRemarks::testLoopVectorizeRemarks()
+{
+    openvdb::ax::CompilerOptions options;
+    options.optimisationRemarks = true;
+
+    openvdb::ax::codegen::FunctionRegistry::UniquePtr registry =
+        openvdb::ax::codegen::createStandardRegistry(options.functionOptions);
+    registry->insert("sumloop", SumLoop::create);
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create(options);
+    compiler->setFunctionRegistry(std::move(registry));
+
+    // whether or not the loop is vectorized, the loop vectorizer reports it
+
+    std::vector<std::string> warnings;
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::VolumeExecutable>("@a = sumloop();",
+            openvdb::ax::CustomData::create(), &warnings);
+    CPPUNIT_ASSERT(executable);
+    CPPUNIT_ASSERT(hasRemark(warnings, "loop-vectorize"));
+
+    // remarks are not collected when disabled
+
+    options.optimisationRemarks = false;
+    registry = openvdb::ax::codegen::createStandardRegistry(options.functionOptions);
+    registry->insert("sumloop", SumLoop::create);
+    compiler = openvdb::ax::Compiler::create(options);
+    compiler->setFunctionRegistry(std::move(registry));
+
+    warnings.clear();
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>("@a = sumloop();",
+        openvdb::ax::CustomData::create(), &warnings);
+    CPPUNIT_ASSERT(executable);
+    CPPUNIT_ASSERT(!hasRemark(warnings, "loop-vectorize"));
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
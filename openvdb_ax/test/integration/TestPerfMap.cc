@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/PointExecutable.h>
+#include <openvdb_ax/compiler/VolumeExecutable.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdio> // std::remove
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h> // getpid
+#endif
+
+class TestPerfMap : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestPerfMap);
+    CPPUNIT_TEST(testPerfMapEntries);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testPerfMapEntries();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPerfMap);
+
+namespace {
+
+/// @brief  Returns true if the perf map contains a function entry with a valid
+///         address and size for the given symbol name
+inline bool
+hasPerfMapEntry(const std::string& file, const std::string& symbol)
+{
+    std::ifstream in(file);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream entry(line);
+        uint64_t address = 0, size = 0;
+        std::string name;
+        entry >> std::hex >> address >> size >> name;
+        if (name == symbol && address != 0 && size != 0) return true;
+    }
+    return false;
+}
+
+/// @brief  Removes the file on destruction, so that it is also removed when an
+///         assertion fails
+struct ScopedRemove
+{
+    ScopedRemove(const std::string& file) : mFile(file) {}
+    ~ScopedRemove() { std::remove(mFile.c_str()); }
+    const std::string mFile;
+};
+
+}
+
+void
+TestPerfMap::testPerfMapEntries()
+{
+#if defined(__linux__)
+    const std::string file = "/tmp/perf-" + std::to_string(::getpid()) + ".map";
+    const ScopedRemove removeFile(file);
+
+    openvdb::ax::CompilerOptions options;
+    options.perfMap = true;
+    options.identifier = "test_perf_map";
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create(options);
+
+    openvdb::ax::PointExecutable::Ptr pointExecutable =
+        compiler->compile<openvdb::ax::PointExecutable>("@a = 1.0f;",
+            openvdb::ax::CustomData::create());
+    CPPUNIT_ASSERT(pointExecutable);
+
+    CPPUNIT_ASSERT(hasPerfMapEntry(file, "test_perf_map::compute_point"));
+    CPPUNIT_ASSERT(hasPerfMapEntry(file, "test_perf_map::compute_point_range"));
+
+    openvdb::ax::VolumeExecutable::Ptr volumeExecutable =
+        compiler->compile<openvdb::ax::VolumeExecutable>("@a = 1.0f;",
+            openvdb::ax::CustomData::create());
+    CPPUNIT_ASSERT(volumeExecutable);
+
+    CPPUNIT_ASSERT(hasPerfMapEntry(file, "test_perf_map::compute_volume_0"));
+
+    // test entries are not written when disabled
+
+    options.identifier = "test_perf_map_disabled";
+    options.perfMap = false;
+    compiler = openvdb::ax::Compiler::create(options);
+    pointExecutable = compiler->compile<openvdb::ax::PointExecutable>("@a = 1.0f;",
+            openvdb::ax::CustomData::create());
+    CPPUNIT_ASSERT(pointExecutable);
+
+    CPPUNIT_ASSERT(!hasPerfMapEntry(file, "test_perf_map_disabled::compute_point"));
+#endif
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
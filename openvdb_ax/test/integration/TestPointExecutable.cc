@@ -0,0 +1,293 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/PointExecutable.h>
+
+#include <openvdb/openvdb.h>
+#include <openvdb/points/PointConversion.h>
+#include <openvdb/points/PointCount.h>
+#include <openvdb/points/PointGroup.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+class TestPointExecutable : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestPointExecutable);
+    CPPUNIT_TEST(testExecuteMultipleGrids);
+    CPPUNIT_TEST(testRelocatePoints);
+    CPPUNIT_TEST(testSubsteps);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testExecuteMultipleGrids();
+    void testRelocatePoints();
+    void testSubsteps();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPointExecutable);
+
+void
+TestPointExecutable::testExecuteMultipleGrids()
+{
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(0.1);
+
+    std::vector<openvdb::points::PointDataGrid::Ptr> grids;
+
+    // grids of differing sizes, including an empty grid and a null pointer
+
+    for (const int count : { 1, 100, 0 }) {
+        std::vector<openvdb::Vec3s> positions;
+        for (int i = 0; i < count; ++i) positions.emplace_back(float(i), 0.0f, 0.0f);
+        grids.push_back(openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(positions, *transform));
+    }
+    grids.push_back(openvdb::points::PointDataGrid::Ptr());
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    openvdb::ax::PointExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::PointExecutable>(
+            "float@a = v@P.x * 2.0f; if (v@P.x > 50.0f) addtogroup(\"far\");",
+            openvdb::ax::CustomData::create());
+    CPPUNIT_ASSERT(executable);
+
+    executable->execute(grids);
+
+    // attributes and groups are appended to every non-empty grid
+
+    for (size_t i = 0; i < 2; ++i) {
+        const openvdb::points::PointDataTree& tree = grids[i]->tree();
+        const auto leaf = tree.cbeginLeaf();
+        CPPUNIT_ASSERT(leaf);
+        CPPUNIT_ASSERT(leaf->hasAttribute("a"));
+        CPPUNIT_ASSERT(leaf->attributeSet().descriptor().hasGroup("far"));
+
+        for (auto iter = tree.cbeginLeaf(); iter; ++iter) {
+            openvdb::points::AttributeHandle<float> a(iter->constAttributeArray("a"));
+            openvdb::points::AttributeHandle<openvdb::Vec3f> p(iter->constAttributeArray("P"));
+            for (auto index = iter->beginIndexOn(); index; ++index) {
+                const openvdb::Vec3d world = transform->indexToWorld(
+                    p.get(*index) + index.getCoord().asVec3d());
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(world.x() * 2.0, a.get(*index), 1e-3);
+            }
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(0),
+        openvdb::points::groupPointCount(grids[0]->tree(), "far"));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(49),
+        openvdb::points::groupPointCount(grids[1]->tree(), "far"));
+    CPPUNIT_ASSERT(!grids[2]->tree().cbeginLeaf());
+
+    // the result matches executing on each grid individually
+
+    std::vector<openvdb::Vec3s> positions;
+    for (int i = 0; i < 100; ++i) positions.emplace_back(float(i), 0.0f, 0.0f);
+    openvdb::points::PointDataGrid::Ptr single =
+        openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(positions, *transform);
+    executable->execute(*single);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::points::groupPointCount(single->tree(), "far"),
+        openvdb::points::groupPointCount(grids[1]->tree(), "far"));
+}
+
+void
+TestPointExecutable::testRelocatePoints()
+{
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(0.1);
+
+    // points two to a voxel along x, spanning five leaf nodes
+
+    std::vector<openvdb::Vec3s> positions;
+    for (int i = 0; i < 64; ++i) positions.emplace_back(float(i) * 0.05f, 0.02f, 0.0f);
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+
+    // points which remain in their voxel, change voxel, change leaf node and move
+    // to leaf nodes which do not yet exist carry their attributes with them
+
+    for (const float offset : { 0.01f, 0.23f, -0.77f, 10.0f }) {
+
+        openvdb::points::PointDataGrid::Ptr grid =
+            openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+                openvdb::points::PointDataGrid>(positions, *transform);
+
+        openvdb::ax::CustomData::Ptr data = openvdb::ax::CustomData::create();
+        data->insertData("offset", openvdb::TypedMetadata<float>(offset).copy());
+
+        compiler->compile<openvdb::ax::PointExecutable>(
+            "float@x = v@P.x; v@P.x += lookupf(\"offset\");", data)->execute(*grid);
+
+        CPPUNIT_ASSERT_EQUAL(openvdb::Index64(64),
+            openvdb::points::pointCount(grid->tree()));
+
+        for (auto leaf = grid->tree().cbeginLeaf(); leaf; ++leaf) {
+            CPPUNIT_ASSERT(leaf->pointCount() > 0);
+            openvdb::points::AttributeHandle<float> x(leaf->constAttributeArray("x"));
+            openvdb::points::AttributeHandle<openvdb::Vec3f> p(leaf->constAttributeArray("P"));
+            for (auto index = leaf->beginIndexOn(); index; ++index) {
+                const openvdb::Vec3f voxel = p.get(*index);
+                CPPUNIT_ASSERT(std::abs(voxel.x()) <= 0.5f);
+                const openvdb::Vec3d world = transform->indexToWorld(
+                    voxel + index.getCoord().asVec3d());
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(x.get(*index) + offset, world.x(), 1e-4);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(0.02, world.y(), 1e-5);
+            }
+        }
+
+        // leaf nodes emptied by the move are removed
+
+        if (offset == 10.0f) {
+            for (auto leaf = grid->tree().cbeginLeaf(); leaf; ++leaf) {
+                CPPUNIT_ASSERT(leaf->origin().x() >= 96);
+            }
+        }
+    }
+
+    // only the points of a group are moved
+
+    openvdb::points::PointDataGrid::Ptr grid =
+        openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(positions, *transform);
+
+    compiler->compile<openvdb::ax::PointExecutable>(
+        "float@x = v@P.x; if (v@P.x > 1.0f) addtogroup(\"far\");",
+        openvdb::ax::CustomData::create())->execute(*grid);
+
+    const std::string group = "far";
+    compiler->compile<openvdb::ax::PointExecutable>("v@P.x -= 1.0f;",
+        openvdb::ax::CustomData::create())->execute(*grid, &group);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(64), openvdb::points::pointCount(grid->tree()));
+
+    for (auto leaf = grid->tree().cbeginLeaf(); leaf; ++leaf) {
+        openvdb::points::AttributeHandle<float> x(leaf->constAttributeArray("x"));
+        openvdb::points::AttributeHandle<openvdb::Vec3f> p(leaf->constAttributeArray("P"));
+        openvdb::points::GroupHandle far = leaf->groupHandle("far");
+        for (auto index = leaf->beginIndexOn(); index; ++index) {
+            const openvdb::Vec3d world = transform->indexToWorld(
+                p.get(*index) + index.getCoord().asVec3d());
+            const double expected = far.get(*index) ? x.get(*index) - 1.0 : x.get(*index);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, world.x(), 1e-4);
+        }
+    }
+
+    // leaf nodes whose points all lie in inactive voxels are kept when other leaf
+    // nodes are emptied
+
+    positions.clear();
+    for (int i = 0; i < 8; ++i) positions.emplace_back(float(i) * 0.1f, 0.0f, 0.0f);
+    for (int i = 0; i < 8; ++i) positions.emplace_back(2.0f + float(i) * 0.1f, 0.0f, 0.0f);
+
+    grid = openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+        openvdb::points::PointDataGrid>(positions, *transform);
+    grid->tree().probeLeaf(openvdb::Coord(0))->setValuesOff();
+
+    compiler->compile<openvdb::ax::PointExecutable>("if (v@P.x > 1.0f) v@P.x += 10.0f;",
+        openvdb::ax::CustomData::create())->execute(*grid);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(16), openvdb::points::pointCount(grid->tree()));
+    CPPUNIT_ASSERT(grid->tree().probeConstLeaf(openvdb::Coord(0)));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(8),
+        grid->tree().probeConstLeaf(openvdb::Coord(0))->pointCount());
+    CPPUNIT_ASSERT(!grid->tree().probeConstLeaf(openvdb::Coord(16, 0, 0)));
+}
+
+void
+TestPointExecutable::testSubsteps()
+{
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(0.1);
+
+    std::vector<openvdb::Vec3s> positions;
+    for (int i = 0; i < 32; ++i) positions.emplace_back(float(i) * 0.1f, 0.0f, 0.0f);
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    openvdb::ax::PointExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::PointExecutable>(
+            "if (substep() == 0) float@x = v@P.x;"
+            "v@P.x += dt(); i@substeps = substep() + 1; float@dt = dt();",
+            openvdb::ax::CustomData::create());
+
+    // a single execution is a single substep of one unit of time
+
+    openvdb::points::PointDataGrid::Ptr grid =
+        openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(positions, *transform);
+    executable->execute(*grid);
+
+    for (auto leaf = grid->tree().cbeginLeaf(); leaf; ++leaf) {
+        openvdb::points::AttributeHandle<int32_t> substeps(leaf->constAttributeArray("substeps"));
+        openvdb::points::AttributeHandle<float> dt(leaf->constAttributeArray("dt"));
+        for (auto index = leaf->beginIndexOn(); index; ++index) {
+            CPPUNIT_ASSERT_EQUAL(1, substeps.get(*index));
+            CPPUNIT_ASSERT_EQUAL(1.0f, dt.get(*index));
+        }
+    }
+
+    // every substep reads the positions written by the previous substep
+
+    grid = openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+        openvdb::points::PointDataGrid>(positions, *transform);
+    executable->execute(*grid, /*substeps*/4, /*dt*/0.25f);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(32), openvdb::points::pointCount(grid->tree()));
+
+    for (auto leaf = grid->tree().cbeginLeaf(); leaf; ++leaf) {
+        openvdb::points::AttributeHandle<float> x(leaf->constAttributeArray("x"));
+        openvdb::points::AttributeHandle<int32_t> substeps(leaf->constAttributeArray("substeps"));
+        openvdb::points::AttributeHandle<float> dt(leaf->constAttributeArray("dt"));
+        openvdb::points::AttributeHandle<openvdb::Vec3f> p(leaf->constAttributeArray("P"));
+        for (auto index = leaf->beginIndexOn(); index; ++index) {
+            const openvdb::Vec3d world = transform->indexToWorld(
+                p.get(*index) + index.getCoord().asVec3d());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(x.get(*index) + 1.0, world.x(), 1e-4);
+            CPPUNIT_ASSERT_EQUAL(4, substeps.get(*index));
+            CPPUNIT_ASSERT_EQUAL(0.25f, dt.get(*index));
+        }
+    }
+
+    // no substeps leave the grid unchanged
+
+    executable->execute(*grid, /*substeps*/0, /*dt*/0.25f);
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(32), openvdb::points::pointCount(grid->tree()));
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
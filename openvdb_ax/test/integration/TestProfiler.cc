@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/Profiler.h>
+#include <openvdb_ax/compiler/VolumeExecutable.h>
+
+#include <openvdb/openvdb.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+class TestProfiler : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestProfiler);
+    CPPUNIT_TEST(testProfilerEntries);
+    CPPUNIT_TEST(testVolumeProfile);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testProfilerEntries();
+    void testVolumeProfile();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestProfiler);
+
+void
+TestProfiler::testProfilerEntries()
+{
+    openvdb::ax::Profiler profiler;
+    CPPUNIT_ASSERT_EQUAL(size_t(0), profiler.size());
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), profiler.addEntry("statement 0"));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), profiler.addEntry("statement 1"));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), profiler.addEntry("statement 0"));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), profiler.size());
+
+    openvdb::ax::Profiler::record(&profiler, 0, 10);
+    openvdb::ax::Profiler::record(&profiler, 0, 10);
+    openvdb::ax::Profiler::record(&profiler, 1, 30);
+
+    // test the report is sorted by descending cycle count
+
+    std::vector<openvdb::ax::Profiler::Entry> report = profiler.report();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), report.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("statement 1"), report[0].mLabel);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1), report[0].mCount);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(30), report[0].mCycles);
+    CPPUNIT_ASSERT_EQUAL(std::string("statement 0"), report[1].mLabel);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), report[1].mCount);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(20), report[1].mCycles);
+
+    std::ostringstream os;
+    profiler.print(os);
+    CPPUNIT_ASSERT(!os.str().empty());
+
+    profiler.clear();
+    report = profiler.report();
+    CPPUNIT_ASSERT_EQUAL(size_t(2), report.size());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), report[0].mCount);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), report[1].mCount);
+}
+
+void
+TestProfiler::testVolumeProfile()
+{
+    openvdb::FloatGrid::Ptr grid = openvdb::FloatGrid::create();
+    grid->setName("a");
+    grid->tree().setValueOn(openvdb::Coord(0, 0, 0), 1.0f);
+    grid->tree().setValueOn(openvdb::Coord(100, 0, 0), 1.0f);
+    grid->tree().setValueOn(openvdb::Coord(0, 100, 0), 1.0f);
+
+    openvdb::GridPtrVec grids;
+    grids.push_back(grid);
+
+    openvdb::ax::CompilerOptions options;
+    options.profile = true;
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create(options);
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::VolumeExecutable>("float b = 2.0f; @a = sin(b);",
+            openvdb::ax::CustomData::create());
+
+    CPPUNIT_ASSERT(executable);
+    CPPUNIT_ASSERT(executable->profiler());
+
+    executable->execute(grids);
+
+    const std::vector<openvdb::ax::Profiler::Entry> report =
+        executable->profiler()->report();
+
+    bool statement0 = false, statement1 = false, function = false;
+    for (const openvdb::ax::Profiler::Entry& entry : report) {
+        if (entry.mLabel == "statement 0") {
+            statement0 = true;
+            CPPUNIT_ASSERT_EQUAL(uint64_t(3), entry.mCount);
+        }
+        else if (entry.mLabel == "statement 1") {
+            statement1 = true;
+            CPPUNIT_ASSERT_EQUAL(uint64_t(3), entry.mCount);
+        }
+        else if (entry.mLabel == "statement 1: sin()") {
+            function = true;
+            CPPUNIT_ASSERT_EQUAL(uint64_t(3), entry.mCount);
+        }
+    }
+
+    CPPUNIT_ASSERT(statement0);
+    CPPUNIT_ASSERT(statement1);
+    CPPUNIT_ASSERT(function);
+
+    // test profiling is disabled by default
+
+    compiler = openvdb::ax::Compiler::create();
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>("@a = 1.0f;",
+        openvdb::ax::CustomData::create());
+    CPPUNIT_ASSERT(executable);
+    CPPUNIT_ASSERT(!executable->profiler());
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
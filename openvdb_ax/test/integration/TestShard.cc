@@ -0,0 +1,365 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/compiler/Shard.h>
+
+#include <openvdb/openvdb.h>
+#include <openvdb/points/AttributeArrayString.h>
+#include <openvdb/points/PointAttribute.h>
+#include <openvdb/points/PointConversion.h>
+#include <openvdb/points/PointCount.h>
+#include <openvdb/points/PointGroup.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TestShard : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestShard);
+    CPPUNIT_TEST(testComputeShard);
+    CPPUNIT_TEST(testExtractAndMerge);
+    CPPUNIT_TEST(testMergeMovedPoints);
+    CPPUNIT_TEST(testMergeStringsAndGroups);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testComputeShard();
+    void testExtractAndMerge();
+    void testMergeMovedPoints();
+    void testMergeStringsAndGroups();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestShard);
+
+namespace {
+
+/// @brief  A line of points along x, two in each voxel, and a float volume over the
+///         same region. Both have 32 leaf nodes, centred at x = 3.5, 11.5, ...
+openvdb::GridPtrVec createGrids()
+{
+    std::vector<openvdb::Vec3s> positions;
+    for (int i = 0; i < 256; ++i) {
+        positions.emplace_back(float(i) - 0.25f, -0.25f, -0.25f);
+        positions.emplace_back(float(i) + 0.25f, 0.25f, 0.25f);
+    }
+
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(1.0);
+
+    openvdb::points::PointDataGrid::Ptr points =
+        openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(positions, *transform);
+    points->setName("points");
+
+    openvdb::FloatGrid::Ptr density = openvdb::FloatGrid::create();
+    density->setName("density");
+    density->fill(openvdb::CoordBBox(openvdb::Coord(0), openvdb::Coord(255, 7, 7)), 1.0f);
+    density->tree().voxelizeActiveTiles();
+
+    openvdb::GridPtrVec grids;
+    grids.push_back(points);
+    grids.push_back(density);
+    return grids;
+}
+
+openvdb::GridPtrVec copyGrids(const openvdb::GridPtrVec& grids)
+{
+    openvdb::GridPtrVec copy;
+    for (const openvdb::GridBase::Ptr& grid : grids) copy.push_back(grid->deepCopyGrid());
+    return copy;
+}
+
+using NamedPoint = std::pair<openvdb::Vec3s, std::string>;
+
+/// @brief  Shard index of count of a point grid holding the given points, with a string
+///         attribute "name" set to the name of each point and a group of the points
+///         below x = 1. Only the given names are added to the string table of the shard.
+openvdb::GridPtrVec createNamedShard(const std::vector<NamedPoint>& points,
+                                     const size_t index,
+                                     const size_t count,
+                                     const std::string& group = "low")
+{
+    std::vector<openvdb::Vec3s> positions;
+    for (const NamedPoint& point : points) positions.push_back(point.first);
+
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(1.0);
+
+    openvdb::points::PointDataGrid::Ptr grid =
+        openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(positions, *transform);
+    grid->setName("points");
+
+    openvdb::points::PointDataTree& tree = grid->tree();
+    openvdb::points::appendAttribute(tree, "name",
+        openvdb::points::StringAttributeArray::attributeType());
+    openvdb::points::appendGroup(tree, group);
+
+    if (tree.cbeginLeaf()) {
+        openvdb::MetaMap& metadata =
+            tree.beginLeaf()->attributeSet().descriptorPtr()->getMetadata();
+        openvdb::points::StringMetaInserter inserter(metadata);
+        for (const NamedPoint& point : points) inserter.insert(point.second);
+
+        for (auto leaf = tree.beginLeaf(); leaf; ++leaf) {
+            const openvdb::points::AttributeHandle<openvdb::Vec3f>
+                position(leaf->constAttributeArray("P"));
+            openvdb::points::StringAttributeWriteHandle
+                name(leaf->attributeArray("name"), metadata);
+            openvdb::points::GroupWriteHandle inGroup = leaf->groupWriteHandle(group);
+
+            for (auto iter = leaf->beginIndexOn(); iter; ++iter) {
+                const double x = transform->indexToWorld(
+                    position.get(*iter) + iter.getCoord().asVec3d()).x();
+                for (const NamedPoint& point : points) {
+                    if (std::abs(x - point.first.x()) < 1e-3) name.set(*iter, point.second);
+                }
+                inGroup.set(*iter, x < 1.0);
+            }
+        }
+    }
+
+    openvdb::ax::Shard shard;
+    shard.mIndex = index;
+    shard.mCount = count;
+
+    openvdb::GridPtrVec grids;
+    grids.push_back(grid);
+    openvdb::ax::extractShard(grids, shard);
+    return grids;
+}
+
+}
+
+void
+TestShard::testComputeShard()
+{
+    const openvdb::GridPtrVec grids = createGrids();
+    const openvdb::GridCPtrVec constGrids(grids.begin(), grids.end());
+
+    // a single shard is unbounded
+
+    openvdb::ax::Shard shard = openvdb::ax::computeShard(constGrids, 0, 1);
+    CPPUNIT_ASSERT(shard.owns(openvdb::Vec3d(-1e6)));
+    CPPUNIT_ASSERT(shard.owns(openvdb::Vec3d(1e6)));
+
+    // shards are cut along x, the axis of greatest extent, with equal numbers of leaf
+    // nodes as the points are evenly distributed
+
+    std::vector<openvdb::ax::Shard> shards;
+    for (size_t i = 0; i < 4; ++i) {
+        shards.push_back(openvdb::ax::computeShard(constGrids, i, 4));
+        CPPUNIT_ASSERT_EQUAL(0, shards.back().mAxis);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(63.5, shards[0].mMax);
+    CPPUNIT_ASSERT_EQUAL(63.5, shards[1].mMin);
+    CPPUNIT_ASSERT_EQUAL(127.5, shards[1].mMax);
+    CPPUNIT_ASSERT_EQUAL(191.5, shards[3].mMin);
+
+    // every leaf node is owned by exactly one shard
+
+    for (double x = 3.5; x < 256.0; x += 8.0) {
+        size_t owners = 0;
+        for (const openvdb::ax::Shard& s : shards) {
+            if (s.owns(openvdb::Vec3d(x, 4.0, 4.0))) ++owners;
+        }
+        CPPUNIT_ASSERT_EQUAL(size_t(1), owners);
+    }
+
+    CPPUNIT_ASSERT_THROW(openvdb::ax::computeShard(constGrids, 4, 4), openvdb::ValueError);
+}
+
+void
+TestShard::testExtractAndMerge()
+{
+    const openvdb::GridPtrVec grids = createGrids();
+    const openvdb::GridCPtrVec constGrids(grids.begin(), grids.end());
+
+    // shards are cut at x = 87.5 and x = 175.5, between leaf nodes 10 and 11 and
+    // leaf nodes 21 and 22
+
+    const std::vector<openvdb::Index64> pointCounts{176, 176, 160};
+    const std::vector<openvdb::Index64> leafCounts{12, 13, 11};
+
+    std::vector<openvdb::GridPtrVec> shards;
+
+    for (size_t i = 0; i < 3; ++i) {
+        const openvdb::ax::Shard shard = openvdb::ax::computeShard(constGrids, i, 3);
+        shards.push_back(copyGrids(grids));
+        openvdb::ax::extractShard(shards.back(), shard, 2);
+
+        openvdb::ax::Shard recorded;
+        CPPUNIT_ASSERT(openvdb::ax::readShard(*shards.back()[0], recorded));
+        CPPUNIT_ASSERT_EQUAL(i, recorded.mIndex);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), recorded.mCount);
+
+        CPPUNIT_ASSERT_EQUAL(pointCounts[i], openvdb::points::pointCount(
+            openvdb::GridBase::grid<openvdb::points::PointDataGrid>(shards.back()[0])->tree()));
+
+        // volumes keep the neighbouring leaf node across each interior boundary as
+        // it lies within the halo
+
+        CPPUNIT_ASSERT_EQUAL(leafCounts[i], openvdb::Index64(
+            openvdb::GridBase::grid<openvdb::FloatGrid>(shards.back()[1])->tree().leafCount()));
+    }
+
+    // merge in reverse order, shards are sorted by index
+
+    std::reverse(shards.begin(), shards.end());
+    const openvdb::GridPtrVec merged = openvdb::ax::mergeShards(shards);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(2), merged.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("points"), merged[0]->getName());
+    CPPUNIT_ASSERT_EQUAL(std::string("density"), merged[1]->getName());
+
+    openvdb::ax::Shard recorded;
+    CPPUNIT_ASSERT(!openvdb::ax::readShard(*merged[0], recorded));
+
+    const openvdb::points::PointDataGrid::ConstPtr mergedPoints =
+        openvdb::GridBase::constGrid<openvdb::points::PointDataGrid>(merged[0]);
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(512), openvdb::points::pointCount(mergedPoints->tree()));
+
+    const openvdb::FloatGrid::ConstPtr mergedDensity =
+        openvdb::GridBase::constGrid<openvdb::FloatGrid>(merged[1]);
+    const openvdb::FloatGrid::ConstPtr density =
+        openvdb::GridBase::constGrid<openvdb::FloatGrid>(grids[1]);
+    CPPUNIT_ASSERT_EQUAL(density->tree().leafCount(), mergedDensity->tree().leafCount());
+    CPPUNIT_ASSERT_EQUAL(density->activeVoxelCount(), mergedDensity->activeVoxelCount());
+}
+
+void
+TestShard::testMergeMovedPoints()
+{
+    const openvdb::GridPtrVec grids = createGrids();
+    const openvdb::GridCPtrVec constGrids(grids.begin(), grids.end());
+
+    std::vector<openvdb::GridPtrVec> shards;
+    for (size_t i = 0; i < 2; ++i) {
+        shards.push_back(copyGrids(grids));
+        openvdb::ax::extractShard(shards.back(),
+            openvdb::ax::computeShard(constGrids, i, 2), 0);
+    }
+
+    // simulate execution moving a point of the second shard into the first leaf node,
+    // owned by the first shard, by replacing the points of the second shard
+
+    openvdb::points::PointDataGrid::Ptr moved =
+        openvdb::points::createPointDataGrid<openvdb::points::NullCodec,
+            openvdb::points::PointDataGrid>(std::vector<openvdb::Vec3s>{
+                openvdb::Vec3s(0.25f, 0.25f, 0.25f), openvdb::Vec3s(200.25f, 0.25f, 0.25f)},
+                shards[1][0]->transform());
+
+    openvdb::GridBase::grid<openvdb::points::PointDataGrid>(shards[1][0])->setTree(moved->treePtr());
+
+    const openvdb::GridPtrVec merged = openvdb::ax::mergeShards(shards);
+    const openvdb::points::PointDataGrid::ConstPtr points =
+        openvdb::GridBase::constGrid<openvdb::points::PointDataGrid>(merged[0]);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(256 + 2), openvdb::points::pointCount(points->tree()));
+
+    // the first voxel holds both of its own points and the moved point
+
+    const openvdb::points::PointDataTree::LeafNodeType* leaf =
+        points->tree().probeConstLeaf(openvdb::Coord(0));
+    CPPUNIT_ASSERT(leaf);
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index32(3), openvdb::Index32(leaf->getValue(0)));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(17), leaf->pointCount());
+}
+
+void
+TestShard::testMergeStringsAndGroups()
+{
+    // the first shard has no leaf nodes, the others have different string tables and
+    // the last holds a point in the leaf node of the second shard at the origin
+
+    const std::vector<NamedPoint> first {}, second {
+        NamedPoint(openvdb::Vec3s(0.25f, 0.0f, 0.0f), "a"),
+        NamedPoint(openvdb::Vec3s(1.25f, 0.0f, 0.0f), "a") }, third {
+        NamedPoint(openvdb::Vec3s(0.75f, 0.0f, 0.0f), "b"),
+        NamedPoint(openvdb::Vec3s(200.25f, 0.0f, 0.0f), "c") };
+
+    std::vector<openvdb::GridPtrVec> shards;
+    shards.push_back(createNamedShard(first, 0, 3));
+    shards.push_back(createNamedShard(second, 1, 3));
+    shards.push_back(createNamedShard(third, 2, 3));
+
+    const openvdb::GridPtrVec merged = openvdb::ax::mergeShards(shards);
+    const openvdb::points::PointDataGrid::ConstPtr points =
+        openvdb::GridBase::constGrid<openvdb::points::PointDataGrid>(merged[0]);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(4), openvdb::points::pointCount(points->tree()));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(2), openvdb::Index64(points->tree().leafCount()));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(2),
+        openvdb::points::groupPointCount(points->tree(), "low"));
+
+    // every point keeps its string, remapped to the merged string table, and its group
+
+    std::vector<NamedPoint> expected(second);
+    expected.insert(expected.end(), third.begin(), third.end());
+
+    for (auto leaf = points->tree().cbeginLeaf(); leaf; ++leaf) {
+        const openvdb::points::AttributeHandle<openvdb::Vec3f>
+            position(leaf->constAttributeArray("P"));
+        const openvdb::points::StringAttributeHandle name(leaf->constAttributeArray("name"),
+            leaf->attributeSet().descriptor().getMetadata());
+        const openvdb::points::GroupHandle low = leaf->groupHandle("low");
+
+        for (auto iter = leaf->beginIndexOn(); iter; ++iter) {
+            const double x = points->transform().indexToWorld(
+                position.get(*iter) + iter.getCoord().asVec3d()).x();
+            size_t matches = 0;
+            for (const NamedPoint& point : expected) {
+                if (std::abs(x - point.first.x()) > 1e-3) continue;
+                CPPUNIT_ASSERT_EQUAL(point.second, name.get(*iter));
+                ++matches;
+            }
+            CPPUNIT_ASSERT_EQUAL(size_t(1), matches);
+            CPPUNIT_ASSERT_EQUAL(x < 1.0, low.get(*iter));
+        }
+    }
+
+    // shards with different groups can not be merged
+
+    shards.clear();
+    shards.push_back(createNamedShard(second, 0, 2));
+    shards.push_back(createNamedShard(third, 1, 2, "high"));
+    CPPUNIT_ASSERT_THROW(openvdb::ax::mergeShards(shards), openvdb::ValueError);
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
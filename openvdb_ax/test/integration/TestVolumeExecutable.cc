@@ -0,0 +1,474 @@
+///////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2015-2018 DNEG Visual Effects
+//
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
+//
+// Redistributions of source code must retain the above copyright
+// and license notice and the following restrictions and disclaimer.
+//
+// *     Neither the name of DNEG Visual Effects nor the names
+// of its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// IN NO EVENT SHALL THE COPYRIGHT HOLDERS' AND CONTRIBUTORS' AGGREGATE
+// LIABILITY FOR ALL CLAIMS REGARDLESS OF THEIR BASIS EXCEED US$250.00.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <openvdb_ax/compiler/Compiler.h>
+#include <openvdb_ax/compiler/VolumeExecutable.h>
+
+#include <openvdb/openvdb.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+class TestVolumeExecutable : public CppUnit::TestCase
+{
+public:
+
+    CPPUNIT_TEST_SUITE(TestVolumeExecutable);
+    CPPUNIT_TEST(testIterations);
+    CPPUNIT_TEST(testBlockAccesses);
+    CPPUNIT_TEST(testScatter);
+    CPPUNIT_TEST(testBoolVolumes);
+    CPPUNIT_TEST(testSharedTopology);
+    CPPUNIT_TEST(testLeafOrder);
+    CPPUNIT_TEST(testStorageVolumes);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testIterations();
+    void testBlockAccesses();
+    void testScatter();
+    void testBoolVolumes();
+    void testSharedTopology();
+    void testLeafOrder();
+    void testStorageVolumes();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestVolumeExecutable);
+
+void
+TestVolumeExecutable::testIterations()
+{
+    const openvdb::Coord inside(0, 0, 0), outside(100, 0, 0);
+
+    openvdb::FloatGrid::Ptr a = openvdb::FloatGrid::create(0.0f);
+    a->setName("a");
+    a->tree().setValueOn(inside, 0.0f);
+    a->tree().setValueOn(outside, 4.0f);
+
+    openvdb::FloatGrid::Ptr b = openvdb::FloatGrid::create(0.0f);
+    b->setName("b");
+    b->tree().setValueOn(inside, 0.0f);
+    b->tree().setValueOn(outside, 0.0f);
+
+    openvdb::GridPtrVec grids { a, b };
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+
+    // a single written volume runs every iteration on a leaf range at once
+
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::VolumeExecutable>("@a = @a * 0.5f + 1.0f;",
+            openvdb::ax::CustomData::create());
+
+    executable->execute(grids, 10);
+
+    float inValue = 0.0f, outValue = 4.0f;
+    for (int i = 0; i < 10; ++i) {
+        inValue = inValue * 0.5f + 1.0f;
+        outValue = outValue * 0.5f + 1.0f;
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(inValue, a->tree().getValue(inside), 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(outValue, a->tree().getValue(outside), 1e-6);
+
+    // multiple written volumes run each block in turn for every iteration
+
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>("@a += 1.0f; @b += 2.0f;",
+        openvdb::ax::CustomData::create());
+
+    a->tree().setValueOn(inside, 0.0f);
+    a->tree().setValueOn(outside, 0.0f);
+
+    executable->execute(grids, 3);
+
+    CPPUNIT_ASSERT_EQUAL(3.0f, a->tree().getValue(inside));
+    CPPUNIT_ASSERT_EQUAL(6.0f, b->tree().getValue(inside));
+    CPPUNIT_ASSERT_EQUAL(3.0f, a->tree().getValue(outside));
+    CPPUNIT_ASSERT_EQUAL(6.0f, b->tree().getValue(outside));
+
+    // no iterations leave the grids unchanged
+
+    executable->execute(grids, 0);
+    CPPUNIT_ASSERT_EQUAL(3.0f, a->tree().getValue(inside));
+    CPPUNIT_ASSERT_EQUAL(6.0f, b->tree().getValue(inside));
+}
+
+void
+TestVolumeExecutable::testBlockAccesses()
+{
+    // each assignment is executed as a separate block which only binds the volumes
+    // it accesses. Volumes which are only accessed by a later block are still bound
+
+    const openvdb::Coord ijk(1, 2, 3);
+
+    openvdb::GridPtrVec grids;
+    for (const std::string name : { "a", "b", "c", "d" }) {
+        openvdb::FloatGrid::Ptr grid = openvdb::FloatGrid::create(0.0f);
+        grid->setName(name);
+        grid->tree().setValueOn(ijk, 0.0f);
+        grids.emplace_back(grid);
+    }
+
+    openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[2])->tree().setValueOn(ijk, 5.0f);
+    openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[3])->tree().setValueOn(ijk, 7.0f);
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::VolumeExecutable>("@a = 1.0f; @b = @c + @d;",
+            openvdb::ax::CustomData::create());
+
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(1.0f,
+        openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[0])->tree().getValue(ijk));
+    CPPUNIT_ASSERT_EQUAL(12.0f,
+        openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[1])->tree().getValue(ijk));
+    CPPUNIT_ASSERT_EQUAL(5.0f,
+        openvdb::StaticPtrCast<openvdb::FloatGrid>(grids[2])->tree().getValue(ijk));
+}
+
+void
+TestVolumeExecutable::testScatter()
+{
+    // every voxel of a scatters into the grids, which are written once all voxels
+    // have been executed regardless of the number of threads
+
+    openvdb::FloatGrid::Ptr a = openvdb::FloatGrid::create(0.0f);
+    a->setName("a");
+    a->tree().fill(openvdb::CoordBBox(openvdb::Coord(0), openvdb::Coord(31)), 1.0f, true);
+
+    openvdb::FloatGrid::Ptr sum = openvdb::FloatGrid::create(0.0f);
+    sum->setName("sum");
+    sum->tree().setValueOn(openvdb::Coord(0), 10.0f);
+
+    openvdb::Int32Grid::Ptr peak = openvdb::Int32Grid::create(0);
+    peak->setName("peak");
+    peak->tree().setValueOn(openvdb::Coord(0), -1);
+
+    openvdb::Int32Grid::Ptr low = openvdb::Int32Grid::create(0);
+    low->setName("low");
+
+    openvdb::Vec3fGrid::Ptr last = openvdb::Vec3fGrid::create();
+    last->setName("last");
+
+    openvdb::GridPtrVec grids { a, sum, peak, low, last };
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::VolumeExecutable>(
+            "vec3f origin = 0.0f;"
+            "scatteradd(\"sum\", origin, @a);"
+            "scattermax(\"peak\", origin, getcoordx());"
+            "scattermin(\"low\", origin, getcoordy() + 5);"
+            "scatter(\"last\", getvoxelpws(), 2.0f);"
+            "@a = 0.0f;",
+            openvdb::ax::CustomData::create());
+
+    executable->execute(grids);
+
+    const openvdb::Coord origin(0);
+
+    CPPUNIT_ASSERT_EQUAL(0.0f, a->tree().getValue(origin));
+    CPPUNIT_ASSERT_EQUAL(10.0f + 32.0f * 32.0f * 32.0f, sum->tree().getValue(origin));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(1), sum->tree().activeVoxelCount());
+    CPPUNIT_ASSERT_EQUAL(31, peak->tree().getValue(origin));
+    CPPUNIT_ASSERT(low->tree().isValueOn(origin));
+    CPPUNIT_ASSERT_EQUAL(5, low->tree().getValue(origin));
+    CPPUNIT_ASSERT_EQUAL(a->tree().activeVoxelCount(), last->tree().activeVoxelCount());
+    CPPUNIT_ASSERT_EQUAL(openvdb::Vec3f(2.0f), last->tree().getValue(openvdb::Coord(31)));
+
+    // scattering into a grid which does not exist or has an unsupported type throws
+
+    openvdb::MaskGrid::Ptr mask = openvdb::MaskGrid::create();
+    mask->setName("mask");
+    grids.emplace_back(mask);
+
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>(
+        "vec3f origin = 0.0f; scatteradd(\"missing\", origin, 1.0f); @a = 0.0f;",
+        openvdb::ax::CustomData::create());
+    CPPUNIT_ASSERT_THROW(executable->execute(grids), openvdb::LookupError);
+
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>(
+        "vec3f origin = 0.0f; scatter(\"mask\", origin, 1.0f); @a = 0.0f;",
+        openvdb::ax::CustomData::create());
+    CPPUNIT_ASSERT_THROW(executable->execute(grids), openvdb::TypeError);
+    CPPUNIT_ASSERT(mask->tree().empty());
+
+    grids.pop_back();
+
+    // values are only scattered once when multiple volumes are assigned
+
+    sum->tree().setValueOn(origin, 0.0f);
+
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>(
+        "vec3f origin = 0.0f; scatteradd(\"sum\", origin, 1.0f); @a = 1.0f; @peak = 1;",
+        openvdb::ax::CustomData::create());
+
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(32.0f * 32.0f * 32.0f, sum->tree().getValue(origin));
+
+    // leaf nodes added by the scatters of the first block are executed by later blocks
+
+    const openvdb::Coord far(100);
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>(
+        "vec3f far = 100.0f; scatter(\"sum\", far, 5.0f); @a = 1.0f; @sum += 1.0f;",
+        openvdb::ax::CustomData::create());
+
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT(sum->tree().isValueOn(far));
+    CPPUNIT_ASSERT_EQUAL(6.0f, sum->tree().getValue(far));
+
+    // values scattered by a single assigned volume are merged between iterations
+
+    openvdb::FloatGrid::Ptr count = openvdb::FloatGrid::create(0.0f);
+    count->setName("count");
+    count->tree().setValueOn(origin, 0.0f);
+
+    openvdb::FloatGrid::Ptr seen = openvdb::FloatGrid::create(0.0f);
+    seen->setName("seen");
+    seen->tree().setValueOn(origin, 0.0f);
+
+    openvdb::GridPtrVec iterated { count, seen };
+
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>(
+        "@seen = @count; vec3f origin = 0.0f; scatteradd(\"count\", origin, 1.0f);",
+        openvdb::ax::CustomData::create());
+
+    executable->execute(iterated, 3);
+
+    CPPUNIT_ASSERT_EQUAL(3.0f, count->tree().getValue(origin));
+    CPPUNIT_ASSERT_EQUAL(2.0f, seen->tree().getValue(origin));
+}
+
+void
+TestVolumeExecutable::testBoolVolumes()
+{
+    // bool volumes are written as whole words of the leaf buffer, which must preserve
+    // the values of inactive voxels and of voxels which are not written
+
+    openvdb::BoolGrid::Ptr mask = openvdb::BoolGrid::create(false);
+    mask->setName("mask");
+    mask->tree().fill(openvdb::CoordBBox(openvdb::Coord(0), openvdb::Coord(15)), true, true);
+
+    const openvdb::Coord inactive(1, 0, 0), active(2, 0, 0), outside(100, 0, 0);
+    mask->tree().setValueOff(inactive, true);
+    mask->tree().setValueOn(outside, false);
+
+    openvdb::BoolGrid::Ptr source = openvdb::BoolGrid::create(false);
+    source->setName("source");
+    source->tree().setValueOn(outside, true);
+
+    openvdb::GridPtrVec grids { mask, source };
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::VolumeExecutable>(
+            "bool@mask = (getcoordy() % 2 == 0 && bool@mask) || bool@source;",
+            openvdb::ax::CustomData::create());
+
+    executable->execute(grids, 2);
+
+    for (auto iter = mask->tree().cbeginValueOn(); iter; ++iter) {
+        const openvdb::Coord ijk = iter.getCoord();
+        if (ijk == outside) continue;
+        CPPUNIT_ASSERT_EQUAL(ijk.y() % 2 == 0, iter.getValue());
+    }
+
+    CPPUNIT_ASSERT(mask->tree().getValue(inactive));
+    CPPUNIT_ASSERT(!mask->tree().isValueOn(inactive));
+    CPPUNIT_ASSERT(mask->tree().getValue(active));
+    CPPUNIT_ASSERT(mask->tree().getValue(outside));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(16 * 16 * 16), mask->tree().activeVoxelCount());
+}
+
+void
+TestVolumeExecutable::testSharedTopology()
+{
+    // volumes with the same transform as the iterated volume resolve their leaf nodes once
+    // per leaf and are accessed by index. Any voxel outside of their leaf nodes, and any
+    // volume with a different transform, is still accessed through the tree
+
+    const openvdb::CoordBBox bbox(openvdb::Coord(0), openvdb::Coord(15));
+
+    openvdb::FloatGrid::Ptr a = openvdb::FloatGrid::create(0.0f);
+    a->setName("a");
+    a->tree().fill(bbox, 0.0f, true);
+
+    openvdb::FloatGrid::Ptr b = openvdb::FloatGrid::create(0.0f);
+    b->setName("b");
+    for (auto iter = bbox.begin(); iter; ++iter) {
+        b->tree().setValueOn(*iter, float((*iter).x()));
+    }
+
+    // c only has leaf nodes at half of the voxels of a
+    openvdb::FloatGrid::Ptr c = openvdb::FloatGrid::create(2.0f);
+    c->setName("c");
+    c->tree().fill(openvdb::CoordBBox(openvdb::Coord(0), openvdb::Coord(7, 15, 15)), 1.0f, true);
+
+    // d has twice the voxel size of a
+    openvdb::FloatGrid::Ptr d = openvdb::FloatGrid::create(0.0f);
+    d->setName("d");
+    d->setTransform(openvdb::math::Transform::createLinearTransform(2.0));
+    for (auto iter = bbox.begin(); iter; ++iter) {
+        d->tree().setValueOn(*iter, float((*iter).y()));
+    }
+
+    openvdb::GridPtrVec grids { a, b, c, d };
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::VolumeExecutable>("@a = @b + 10.0f * @c + 100.0f * @d;",
+            openvdb::ax::CustomData::create());
+
+    executable->execute(grids);
+
+    for (auto iter = bbox.begin(); iter; ++iter) {
+        const openvdb::Coord& ijk = *iter;
+        const float cValue = ijk.x() < 8 ? 1.0f : 2.0f;
+        const openvdb::Coord dijk =
+            d->transform().worldToIndexCellCentered(a->transform().indexToWorld(ijk));
+        const float expected = float(ijk.x()) + 10.0f * cValue +
+            100.0f * d->tree().getValue(dijk);
+        CPPUNIT_ASSERT_EQUAL(expected, a->tree().getValue(ijk));
+    }
+}
+
+void
+TestVolumeExecutable::testLeafOrder()
+{
+    // executing leaf nodes in Morton order must produce the same result as tree order,
+    // including for leaf nodes at negative coordinates and volumes read by other blocks
+
+    auto createGrids = []() -> openvdb::GridPtrVec {
+        openvdb::FloatGrid::Ptr a = openvdb::FloatGrid::create(0.0f);
+        a->setName("a");
+        openvdb::FloatGrid::Ptr b = openvdb::FloatGrid::create(0.0f);
+        b->setName("b");
+        const openvdb::CoordBBox bbox(openvdb::Coord(-20), openvdb::Coord(20));
+        for (auto iter = bbox.begin(); iter; ++iter) {
+            const openvdb::Coord& ijk = *iter;
+            if ((ijk.x() + ijk.y() + ijk.z()) % 3 != 0) continue;
+            a->tree().setValueOn(ijk, float(ijk.x()));
+            b->tree().setValueOn(ijk, float(ijk.y() * ijk.z()));
+        }
+        return openvdb::GridPtrVec { a, b };
+    };
+
+    const std::string code = "@a += @b * 0.5f; @b = @a - 1.0f;";
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    openvdb::ax::VolumeExecutable::Ptr tree =
+        compiler->compile<openvdb::ax::VolumeExecutable>(code, openvdb::ax::CustomData::create());
+
+    openvdb::ax::CompilerOptions options;
+    options.leafOrder = openvdb::ax::CompilerOptions::LeafOrder::MORTON;
+    compiler = openvdb::ax::Compiler::create(options);
+    openvdb::ax::VolumeExecutable::Ptr morton =
+        compiler->compile<openvdb::ax::VolumeExecutable>(code, openvdb::ax::CustomData::create());
+
+    openvdb::GridPtrVec expected = createGrids();
+    openvdb::GridPtrVec result = createGrids();
+    tree->execute(expected, 3);
+    morton->execute(result, 3);
+
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const openvdb::FloatTree& expectedTree =
+            openvdb::StaticPtrCast<openvdb::FloatGrid>(expected[i])->tree();
+        const openvdb::FloatTree& resultTree =
+            openvdb::StaticPtrCast<openvdb::FloatGrid>(result[i])->tree();
+        CPPUNIT_ASSERT_EQUAL(expectedTree.activeVoxelCount(), resultTree.activeVoxelCount());
+        for (auto iter = expectedTree.cbeginValueOn(); iter; ++iter) {
+            CPPUNIT_ASSERT_EQUAL(*iter, resultTree.getValue(iter.getCoord()));
+        }
+    }
+}
+
+void
+TestVolumeExecutable::testStorageVolumes()
+{
+    // half, int8 and uint8 volumes are computed as float and int values and narrowed
+    // back to their storage type on assignment
+
+    using HalfGrid = openvdb::BoolGrid::ValueConverter<half>::Type;
+    using Int8Grid = openvdb::BoolGrid::ValueConverter<int8_t>::Type;
+    using UInt8Grid = openvdb::BoolGrid::ValueConverter<uint8_t>::Type;
+
+    const openvdb::CoordBBox bbox(openvdb::Coord(0), openvdb::Coord(7));
+
+    HalfGrid::Ptr density = HalfGrid::create(half(0.0f));
+    density->setName("density");
+    density->tree().fill(bbox, half(0.5f), true);
+
+    Int8Grid::Ptr offset = Int8Grid::create(0);
+    offset->setName("offset");
+    offset->tree().fill(bbox, int8_t(-100), true);
+
+    UInt8Grid::Ptr colour = UInt8Grid::create(0);
+    colour->setName("colour");
+    colour->tree().fill(bbox, uint8_t(200), true);
+
+    openvdb::GridPtrVec grids { density, offset, colour };
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    openvdb::ax::VolumeExecutable::Ptr executable =
+        compiler->compile<openvdb::ax::VolumeExecutable>(
+            "half@density = half@density * 3.0f + 0.25f; int8@offset -= 10; "
+            "uint8@colour = uint8@colour + 50;",
+            openvdb::ax::CustomData::create());
+
+    executable->execute(grids);
+
+    for (auto iter = bbox.begin(); iter; ++iter) {
+        CPPUNIT_ASSERT_EQUAL(1.75f, float(density->tree().getValue(*iter)));
+        CPPUNIT_ASSERT_EQUAL(int8_t(-110), offset->tree().getValue(*iter));
+        CPPUNIT_ASSERT_EQUAL(uint8_t(250), colour->tree().getValue(*iter));
+    }
+
+    // values may also be scattered into storage volumes
+
+    const openvdb::Coord far(100);
+    executable = compiler->compile<openvdb::ax::VolumeExecutable>(
+        "vec3f far = 100.0f; scatteradd(\"density\", far, 0.5f); "
+        "scattermin(\"offset\", far, -5); scattermax(\"colour\", far, 255); "
+        "half@density = half@density;",
+        openvdb::ax::CustomData::create());
+
+    executable->execute(grids);
+
+    CPPUNIT_ASSERT_EQUAL(256.0f, float(density->tree().getValue(far)));
+    CPPUNIT_ASSERT_EQUAL(int8_t(-5), offset->tree().getValue(far));
+    CPPUNIT_ASSERT_EQUAL(uint8_t(255), colour->tree().getValue(far));
+}
+
+// Copyright (c) 2015-2018 DNEG Visual Effects
+// All rights reserved. This software is distributed under the
+// Mozilla Public License 2.0 ( http://www.mozilla.org/MPL/2.0/ )
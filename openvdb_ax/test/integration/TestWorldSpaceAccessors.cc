@@ -33,6 +33,7 @@
 #include <openvdb/points/PointDataGrid.h>
 #include <openvdb/points/PointGroup.h>
 #include <openvdb/points/PointConversion.h>
+#include <openvdb/points/PointCount.h>
 #include <openvdb/points/AttributeArray.h>
 
 #include <openvdb/math/Transform.h>
@@ -50,11 +51,15 @@ public:
     CPPUNIT_TEST_SUITE(TestWorldSpaceAccessors);
     CPPUNIT_TEST(testWorldSpaceAssign);
     CPPUNIT_TEST(testWorldSpaceAssignComponent);
+    CPPUNIT_TEST(testWorldSpaceAssignGroup);
+    CPPUNIT_TEST(testWorldSpaceTransforms);
 
     CPPUNIT_TEST_SUITE_END();
 
     void testWorldSpaceAssign();
     void testWorldSpaceAssignComponent();
+    void testWorldSpaceAssignGroup();
+    void testWorldSpaceTransforms();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestWorldSpaceAccessors);
@@ -202,7 +207,106 @@ TestWorldSpaceAccessors::testWorldSpaceAssignComponent()
     }
 }
 
+void
+TestWorldSpaceAccessors::testWorldSpaceAssignGroup()
+{
+    // only the positions of the points in the group are cached and moved
+
+    const std::vector<openvdb::Vec3s> positions =
+        {openvdb::Vec3s(0.0f, 0.0f, 0.0f),
+         openvdb::Vec3s(0.0f, 0.0f, 0.05f),
+         openvdb::Vec3s(0.0f, 1.0f, 0.0f),
+         openvdb::Vec3s(1.0f, 1.0f, 0.0f)};
+
+    openvdb::math::Transform::Ptr transform =
+        openvdb::math::Transform::createLinearTransform(0.1);
+    PointDataGrid::Ptr grid =
+        createPointDataGrid<NullCodec, PointDataGrid>(positions, *transform);
+
+    openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+    compiler->compile<openvdb::ax::PointExecutable>("if (v@P.y > 0.5f) addtogroup(\"upper\");",
+        openvdb::ax::CustomData::create())->execute(*grid);
+
+    const std::string group = "upper";
+    compiler->compile<openvdb::ax::PointExecutable>("v@P += {10.0f, 0.0f, 0.0f};",
+        openvdb::ax::CustomData::create())->execute(*grid, &group);
+
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(4), pointCount(grid->tree()));
+    CPPUNIT_ASSERT_EQUAL(openvdb::Index64(2), groupPointCount(grid->tree(), "upper"));
+
+    size_t moved = 0;
+    for (auto leaf = grid->tree().cbeginLeaf(); leaf; ++leaf) {
+        AttributeHandle<openvdb::Vec3f> pHandle(leaf->constAttributeArray("P"));
+        GroupHandle upper = leaf->groupHandle("upper");
+        for (auto iter = leaf->beginIndexOn(); iter; ++iter) {
+            const openvdb::Vec3d pWS =
+                grid->transform().indexToWorld(iter.getCoord().asVec3d() + pHandle.get(*iter));
+            if (upper.get(*iter)) {
+                ++moved;
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, pWS.y(), 1e-5);
+                CPPUNIT_ASSERT(pWS.x() > 9.0);
+            }
+            else {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pWS.x(), 1e-5);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pWS.y(), 1e-5);
+            }
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(2), moved);
+}
 
+void
+TestWorldSpaceAccessors::testWorldSpaceTransforms()
+{
+    // world space positions are computed from a scale and offset for diagonal transforms,
+    // from a matrix for other linear transforms and from the map otherwise
+
+    const std::vector<openvdb::Vec3s> positions =
+        {openvdb::Vec3s(0.0f, 0.0f, 0.0f),
+         openvdb::Vec3s(0.3f, -0.2f, 0.05f),
+         openvdb::Vec3s(-1.0f, 1.0f, 2.0f),
+         openvdb::Vec3s(1.0f, 1.5f, -0.7f)};
+
+    openvdb::math::Transform::Ptr scaleTranslate =
+        openvdb::math::Transform::createLinearTransform(0.1);
+    scaleTranslate->postTranslate(openvdb::Vec3d(1.0, -2.0, 0.5));
+
+    openvdb::math::Transform::Ptr scale =
+        openvdb::math::Transform::createLinearTransform(0.1);
+    scale->postScale(openvdb::Vec3d(1.0, -2.0, 0.5));
+
+    openvdb::math::Transform::Ptr affine =
+        openvdb::math::Transform::createLinearTransform(0.1);
+    affine->postRotate(0.7, openvdb::math::Z_AXIS);
+    affine->postTranslate(openvdb::Vec3d(0.2, 0.0, -3.0));
+
+    openvdb::math::Transform::Ptr frustum =
+        openvdb::math::Transform::createFrustumTransform(
+            openvdb::BBoxd(openvdb::Vec3d(-50.0), openvdb::Vec3d(50.0)), 0.5, 10.0, 0.1);
+
+    for (const openvdb::math::Transform::Ptr& transform : {scaleTranslate, scale, affine, frustum}) {
+
+        PointDataGrid::Ptr grid =
+            createPointDataGrid<NullCodec, PointDataGrid>(positions, *transform);
+
+        openvdb::ax::Compiler::UniquePtr compiler = openvdb::ax::Compiler::create();
+        compiler->compile<openvdb::ax::PointExecutable>("v@Pw = v@P;",
+            openvdb::ax::CustomData::create())->execute(*grid);
+
+        for (auto leaf = grid->tree().cbeginLeaf(); leaf; ++leaf) {
+            AttributeHandle<openvdb::Vec3f> pHandle(leaf->constAttributeArray("P"));
+            AttributeHandle<openvdb::Vec3f> pwHandle(leaf->constAttributeArray("Pw"));
+            for (auto iter = leaf->beginIndexOn(); iter; ++iter) {
+                const openvdb::Vec3d pWS =
+                    transform->indexToWorld(iter.getCoord().asVec3d() + pHandle.get(*iter));
+                const openvdb::Vec3f pw = pwHandle.get(*iter);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(pWS.x(), pw.x(), 1e-5);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(pWS.y(), pw.y(), 1e-5);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(pWS.z(), pw.z(), 1e-5);
+            }
+        }
+    }
+}
 
 // Copyright (c) 2015-2018 DNEG Visual Effects
 // All rights reserved. This software is distributed under the